@@ -402,6 +402,22 @@ namespace craby {
       struct HttpResponse;
       struct HttpPutParams;
       struct HiddenServiceResponse;
+      struct PrewarmParams;
+      struct DirectorySnapshotParams;
+      struct DirectorySnapshotResponse;
+      struct TorListeners;
+      struct ResumeResponse;
+      struct OpenStreamParams;
+      struct StreamResponse;
+      struct StreamReadResponse;
+      struct WebSocketParams;
+      struct WebSocketResponse;
+      struct ProxyParams;
+      struct ProxyResponse;
+      struct HttpServerParams;
+      struct HttpServerResponse;
+      struct OnionPublishParams;
+      struct OnionPublishResponse;
       struct ReactNativeNitroTor;
     }
   }
@@ -416,6 +432,7 @@ struct StartTorResponse final {
   bool is_success CXX_DEFAULT_VALUE(false);
   ::rust::String onion_address;
   ::rust::String control;
+  double socks_port CXX_DEFAULT_VALUE(0);
   ::rust::String error_message;
   ::rust::String onion_addresses_json;
 
@@ -431,6 +448,8 @@ struct StartTorParams final {
   double target_port CXX_DEFAULT_VALUE(0);
   double timeout_ms CXX_DEFAULT_VALUE(0);
   ::rust::String keys_json;
+  ::rust::String profile;
+  ::rust::String torrc_overrides_json;
 
   using IsRelocatable = ::std::true_type;
 };
@@ -443,6 +462,9 @@ struct HttpPostParams final {
   ::rust::String body;
   ::rust::String headers;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String accept_encoding;
+  ::rust::String isolation;
+  bool fresh_circuit CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -454,6 +476,11 @@ struct HttpGetParams final {
   ::rust::String url;
   ::rust::String headers;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String accept_encoding;
+  bool cache CXX_DEFAULT_VALUE(false);
+  double hedge_percentile CXX_DEFAULT_VALUE(0);
+  ::rust::String isolation;
+  bool fresh_circuit CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -465,6 +492,9 @@ struct HttpDeleteParams final {
   ::rust::String url;
   ::rust::String headers;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String accept_encoding;
+  ::rust::String isolation;
+  bool fresh_circuit CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -475,6 +505,9 @@ struct HttpDeleteParams final {
 struct HiddenServiceParams final {
   double port CXX_DEFAULT_VALUE(0);
   double target_port CXX_DEFAULT_VALUE(0);
+  ::rust::String ports_json;
+  bool accept_streams CXX_DEFAULT_VALUE(false);
+  ::rust::String defenses_json;
 
   using IsRelocatable = ::std::true_type;
 };
@@ -486,6 +519,8 @@ struct TorConfig final {
   double socks_port CXX_DEFAULT_VALUE(0);
   ::rust::String data_dir;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String profile;
+  ::rust::String torrc_overrides_json;
 
   using IsRelocatable = ::std::true_type;
 };
@@ -497,6 +532,10 @@ struct HttpResponse final {
   double status_code CXX_DEFAULT_VALUE(0);
   ::rust::String body;
   ::rust::String error;
+  double wire_bytes CXX_DEFAULT_VALUE(0);
+  double decoded_bytes CXX_DEFAULT_VALUE(0);
+  ::rust::String cache_status;
+  bool conflux CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -509,6 +548,9 @@ struct HttpPutParams final {
   ::rust::String body;
   ::rust::String headers;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String accept_encoding;
+  ::rust::String isolation;
+  bool fresh_circuit CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -520,11 +562,197 @@ struct HiddenServiceResponse final {
   bool is_success CXX_DEFAULT_VALUE(false);
   ::rust::String onion_address;
   ::rust::String control;
+  ::rust::String error;
 
   using IsRelocatable = ::std::true_type;
 };
 #endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HiddenServiceResponse
 
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$PrewarmParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$PrewarmParams
+struct PrewarmParams final {
+  ::rust::String targets_json;
+  double keepalive_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String isolation;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$PrewarmParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotParams
+struct DirectorySnapshotParams final {
+  ::rust::String data_dir;
+  ::rust::String snapshot_dir;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotResponse
+struct DirectorySnapshotResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double valid_until CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$TorListeners
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$TorListeners
+struct TorListeners final {
+  double socks_port CXX_DEFAULT_VALUE(0);
+  ::rust::String socks_socket;
+  ::rust::String control;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$TorListeners
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ResumeResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ResumeResponse
+struct ResumeResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double resume_ms CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ResumeResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OpenStreamParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OpenStreamParams
+struct OpenStreamParams final {
+  ::rust::String host;
+  double port CXX_DEFAULT_VALUE(0);
+  double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String isolation;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OpenStreamParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamResponse
+struct StreamResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double stream_id CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamReadResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamReadResponse
+struct StreamReadResponse final {
+  ::rust::String data_base64;
+  bool eof CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamReadResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketParams
+struct WebSocketParams final {
+  ::rust::String url;
+  ::rust::String headers;
+  ::rust::String protocols;
+  double timeout_ms CXX_DEFAULT_VALUE(0);
+  double ping_interval_ms CXX_DEFAULT_VALUE(0);
+  bool deflate CXX_DEFAULT_VALUE(false);
+  ::rust::String isolation;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketResponse
+struct WebSocketResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double socket_id CXX_DEFAULT_VALUE(0);
+  ::rust::String protocol;
+  ::rust::String extensions;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyParams
+struct ProxyParams final {
+  ::rust::String listen;
+  ::rust::String isolation;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyResponse
+struct ProxyResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  ::rust::String address;
+  ::rust::String credentials;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerParams
+struct HttpServerParams final {
+  ::rust::String listen;
+  ::rust::String static_dir;
+  ::rust::String routes_json;
+  bool dispatch CXX_DEFAULT_VALUE(false);
+  double handler_timeout_ms CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerResponse
+struct HttpServerResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double server_id CXX_DEFAULT_VALUE(0);
+  ::rust::String address;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishParams
+struct OnionPublishParams final {
+  ::rust::String onion_address;
+  double min_hsdirs CXX_DEFAULT_VALUE(0);
+  double timeout_ms CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishResponse
+struct OnionPublishResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  double hsdirs CXX_DEFAULT_VALUE(0);
+  ::rust::String error;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishResponse
+
 #ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ReactNativeNitroTor
 #define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ReactNativeNitroTor
 struct ReactNativeNitroTor final : public ::rust::Opaque {
@@ -541,12 +769,28 @@ private:
 
 ::rust::Box<::craby::reactnativenitrotor::bridging::ReactNativeNitroTor> createReactNativeNitroTor(::std::size_t id, ::rust::Str data_path) noexcept;
 
+bool attachHttpServer(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double server_id);
+
+bool clearHttpCache(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_);
+
 ::craby::reactnativenitrotor::bridging::HiddenServiceResponse createHiddenService(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HiddenServiceParams params);
 
 bool deleteHiddenService(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str onion_address);
 
+::craby::reactnativenitrotor::bridging::DirectorySnapshotResponse exportDirectorySnapshot(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::DirectorySnapshotParams params);
+
+::rust::String getCircuitStats(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_);
+
+::craby::reactnativenitrotor::bridging::TorListeners getListeners(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_);
+
+::rust::String getOnionServiceMetrics(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str onion_address);
+
+::rust::String getPrewarmStatus(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_);
+
 double getServiceStatus(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_);
 
+::rust::String getStartupReport(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_);
+
 ::craby::reactnativenitrotor::bridging::HttpResponse httpDelete(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HttpDeleteParams params);
 
 ::craby::reactnativenitrotor::bridging::HttpResponse httpGet(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HttpGetParams params);
@@ -557,9 +801,49 @@ double getServiceStatus(::craby::reactnativenitrotor::bridging::ReactNativeNitro
 
 bool initTorService(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::TorConfig config);
 
+::craby::reactnativenitrotor::bridging::StreamResponse openStream(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::OpenStreamParams params);
+
+::rust::String pollEvents(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double wait_ms);
+
+bool prewarm(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::PrewarmParams params);
+
+bool respondHttpRequests(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str replies_json);
+
+::craby::reactnativenitrotor::bridging::ResumeResponse resume(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double timeout_ms);
+
+::craby::reactnativenitrotor::bridging::DirectorySnapshotResponse seedDirectorySnapshot(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::DirectorySnapshotParams params);
+
 bool shutdownService(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_);
 
+::craby::reactnativenitrotor::bridging::HttpServerResponse startHttpServer(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HttpServerParams params);
+
+::craby::reactnativenitrotor::bridging::ProxyResponse startProxy(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::ProxyParams params);
+
 ::craby::reactnativenitrotor::bridging::StartTorResponse startTorIfNotRunning(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::StartTorParams params);
+
+bool stopHttpServer(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double server_id);
+
+bool stopProxy(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str address);
+
+bool streamClose(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id);
+
+::craby::reactnativenitrotor::bridging::StreamReadResponse streamRead(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id, double max_bytes);
+
+::craby::reactnativenitrotor::bridging::StreamResponse streamShutdownWrite(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id);
+
+::craby::reactnativenitrotor::bridging::StreamResponse streamWrite(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id, ::rust::Str data_base64);
+
+bool suspend(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_);
+
+::craby::reactnativenitrotor::bridging::OnionPublishResponse waitOnionPublished(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::OnionPublishParams params);
+
+bool webSocketAttach(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double socket_id);
+
+bool webSocketClose(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double socket_id, double code, ::rust::Str reason);
+
+::craby::reactnativenitrotor::bridging::WebSocketResponse webSocketConnect(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::WebSocketParams params);
+
+bool webSocketSend(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double socket_id, ::rust::Str data, bool binary);
 } // namespace bridging
 } // namespace reactnativenitrotor
 } // namespace craby
@@ -473,6 +473,22 @@ namespace craby {
       struct HttpResponse;
       struct HttpPutParams;
       struct HiddenServiceResponse;
+      struct PrewarmParams;
+      struct DirectorySnapshotParams;
+      struct DirectorySnapshotResponse;
+      struct TorListeners;
+      struct ResumeResponse;
+      struct OpenStreamParams;
+      struct StreamResponse;
+      struct StreamReadResponse;
+      struct WebSocketParams;
+      struct WebSocketResponse;
+      struct ProxyParams;
+      struct ProxyResponse;
+      struct HttpServerParams;
+      struct HttpServerResponse;
+      struct OnionPublishParams;
+      struct OnionPublishResponse;
       struct ReactNativeNitroTor;
     }
   }
@@ -487,6 +503,7 @@ struct StartTorResponse final {
   bool is_success CXX_DEFAULT_VALUE(false);
   ::rust::String onion_address;
   ::rust::String control;
+  double socks_port CXX_DEFAULT_VALUE(0);
   ::rust::String error_message;
   ::rust::String onion_addresses_json;
 
@@ -502,6 +519,8 @@ struct StartTorParams final {
   double target_port CXX_DEFAULT_VALUE(0);
   double timeout_ms CXX_DEFAULT_VALUE(0);
   ::rust::String keys_json;
+  ::rust::String profile;
+  ::rust::String torrc_overrides_json;
 
   using IsRelocatable = ::std::true_type;
 };
@@ -514,6 +533,9 @@ struct HttpPostParams final {
   ::rust::String body;
   ::rust::String headers;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String accept_encoding;
+  ::rust::String isolation;
+  bool fresh_circuit CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -525,6 +547,11 @@ struct HttpGetParams final {
   ::rust::String url;
   ::rust::String headers;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String accept_encoding;
+  bool cache CXX_DEFAULT_VALUE(false);
+  double hedge_percentile CXX_DEFAULT_VALUE(0);
+  ::rust::String isolation;
+  bool fresh_circuit CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -536,6 +563,9 @@ struct HttpDeleteParams final {
   ::rust::String url;
   ::rust::String headers;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String accept_encoding;
+  ::rust::String isolation;
+  bool fresh_circuit CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -546,6 +576,9 @@ struct HttpDeleteParams final {
 struct HiddenServiceParams final {
   double port CXX_DEFAULT_VALUE(0);
   double target_port CXX_DEFAULT_VALUE(0);
+  ::rust::String ports_json;
+  bool accept_streams CXX_DEFAULT_VALUE(false);
+  ::rust::String defenses_json;
 
   using IsRelocatable = ::std::true_type;
 };
@@ -557,6 +590,8 @@ struct TorConfig final {
   double socks_port CXX_DEFAULT_VALUE(0);
   ::rust::String data_dir;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String profile;
+  ::rust::String torrc_overrides_json;
 
   using IsRelocatable = ::std::true_type;
 };
@@ -568,6 +603,10 @@ struct HttpResponse final {
   double status_code CXX_DEFAULT_VALUE(0);
   ::rust::String body;
   ::rust::String error;
+  double wire_bytes CXX_DEFAULT_VALUE(0);
+  double decoded_bytes CXX_DEFAULT_VALUE(0);
+  ::rust::String cache_status;
+  bool conflux CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -580,6 +619,9 @@ struct HttpPutParams final {
   ::rust::String body;
   ::rust::String headers;
   double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String accept_encoding;
+  ::rust::String isolation;
+  bool fresh_circuit CXX_DEFAULT_VALUE(false);
 
   using IsRelocatable = ::std::true_type;
 };
@@ -591,11 +633,197 @@ struct HiddenServiceResponse final {
   bool is_success CXX_DEFAULT_VALUE(false);
   ::rust::String onion_address;
   ::rust::String control;
+  ::rust::String error;
 
   using IsRelocatable = ::std::true_type;
 };
 #endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HiddenServiceResponse
 
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$PrewarmParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$PrewarmParams
+struct PrewarmParams final {
+  ::rust::String targets_json;
+  double keepalive_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String isolation;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$PrewarmParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotParams
+struct DirectorySnapshotParams final {
+  ::rust::String data_dir;
+  ::rust::String snapshot_dir;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotResponse
+struct DirectorySnapshotResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double valid_until CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$DirectorySnapshotResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$TorListeners
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$TorListeners
+struct TorListeners final {
+  double socks_port CXX_DEFAULT_VALUE(0);
+  ::rust::String socks_socket;
+  ::rust::String control;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$TorListeners
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ResumeResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ResumeResponse
+struct ResumeResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double resume_ms CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ResumeResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OpenStreamParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OpenStreamParams
+struct OpenStreamParams final {
+  ::rust::String host;
+  double port CXX_DEFAULT_VALUE(0);
+  double timeout_ms CXX_DEFAULT_VALUE(0);
+  ::rust::String isolation;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OpenStreamParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamResponse
+struct StreamResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double stream_id CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamReadResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamReadResponse
+struct StreamReadResponse final {
+  ::rust::String data_base64;
+  bool eof CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$StreamReadResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketParams
+struct WebSocketParams final {
+  ::rust::String url;
+  ::rust::String headers;
+  ::rust::String protocols;
+  double timeout_ms CXX_DEFAULT_VALUE(0);
+  double ping_interval_ms CXX_DEFAULT_VALUE(0);
+  bool deflate CXX_DEFAULT_VALUE(false);
+  ::rust::String isolation;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketResponse
+struct WebSocketResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double socket_id CXX_DEFAULT_VALUE(0);
+  ::rust::String protocol;
+  ::rust::String extensions;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$WebSocketResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyParams
+struct ProxyParams final {
+  ::rust::String listen;
+  ::rust::String isolation;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyResponse
+struct ProxyResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  ::rust::String address;
+  ::rust::String credentials;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ProxyResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerParams
+struct HttpServerParams final {
+  ::rust::String listen;
+  ::rust::String static_dir;
+  ::rust::String routes_json;
+  bool dispatch CXX_DEFAULT_VALUE(false);
+  double handler_timeout_ms CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerResponse
+struct HttpServerResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  ::rust::String error;
+  double server_id CXX_DEFAULT_VALUE(0);
+  ::rust::String address;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$HttpServerResponse
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishParams
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishParams
+struct OnionPublishParams final {
+  ::rust::String onion_address;
+  double min_hsdirs CXX_DEFAULT_VALUE(0);
+  double timeout_ms CXX_DEFAULT_VALUE(0);
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishParams
+
+#ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishResponse
+#define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishResponse
+struct OnionPublishResponse final {
+  bool is_success CXX_DEFAULT_VALUE(false);
+  double hsdirs CXX_DEFAULT_VALUE(0);
+  ::rust::String error;
+
+  using IsRelocatable = ::std::true_type;
+};
+#endif // CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$OnionPublishResponse
+
 #ifndef CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ReactNativeNitroTor
 #define CXXBRIDGE1_STRUCT_craby$reactnativenitrotor$bridging$ReactNativeNitroTor
 struct ReactNativeNitroTor final : public ::rust::Opaque {
@@ -616,12 +844,28 @@ extern "C" {
 
 ::craby::reactnativenitrotor::bridging::ReactNativeNitroTor *craby$reactnativenitrotor$bridging$cxxbridge1$190$create_react_native_nitro_tor(::std::size_t id, ::rust::Str data_path) noexcept;
 
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_attach_http_server(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double server_id, bool *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_clear_http_cache(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, bool *return$) noexcept;
+
 ::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_create_hidden_service(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HiddenServiceParams *params, ::craby::reactnativenitrotor::bridging::HiddenServiceResponse *return$) noexcept;
 
 ::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_delete_hidden_service(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str onion_address, bool *return$) noexcept;
 
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_export_directory_snapshot(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::DirectorySnapshotParams *params, ::craby::reactnativenitrotor::bridging::DirectorySnapshotResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_circuit_stats(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::String *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_listeners(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::TorListeners *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_onion_service_metrics(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str onion_address, ::rust::String *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_prewarm_status(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::String *return$) noexcept;
+
 ::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_service_status(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double *return$) noexcept;
 
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_startup_report(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::String *return$) noexcept;
+
 ::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_http_delete(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HttpDeleteParams *params, ::craby::reactnativenitrotor::bridging::HttpResponse *return$) noexcept;
 
 ::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_http_get(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HttpGetParams *params, ::craby::reactnativenitrotor::bridging::HttpResponse *return$) noexcept;
@@ -632,9 +876,49 @@ extern "C" {
 
 ::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_init_tor_service(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::TorConfig *config, bool *return$) noexcept;
 
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_open_stream(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::OpenStreamParams *params, ::craby::reactnativenitrotor::bridging::StreamResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_poll_events(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double wait_ms, ::rust::String *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_prewarm(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::PrewarmParams *params, bool *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_respond_http_requests(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str replies_json, bool *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_resume(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double timeout_ms, ::craby::reactnativenitrotor::bridging::ResumeResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_seed_directory_snapshot(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::DirectorySnapshotParams *params, ::craby::reactnativenitrotor::bridging::DirectorySnapshotResponse *return$) noexcept;
+
 ::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_shutdown_service(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, bool *return$) noexcept;
 
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_start_http_server(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HttpServerParams *params, ::craby::reactnativenitrotor::bridging::HttpServerResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_start_proxy(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::ProxyParams *params, ::craby::reactnativenitrotor::bridging::ProxyResponse *return$) noexcept;
+
 ::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_start_tor_if_not_running(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::StartTorParams *params, ::craby::reactnativenitrotor::bridging::StartTorResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stop_http_server(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double server_id, bool *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stop_proxy(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str address, bool *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stream_close(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id, bool *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stream_read(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id, double max_bytes, ::craby::reactnativenitrotor::bridging::StreamReadResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stream_shutdown_write(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id, ::craby::reactnativenitrotor::bridging::StreamResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stream_write(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id, ::rust::Str data_base64, ::craby::reactnativenitrotor::bridging::StreamResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_suspend(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, bool *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_wait_onion_published(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::OnionPublishParams *params, ::craby::reactnativenitrotor::bridging::OnionPublishResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_web_socket_attach(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double socket_id, bool *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_web_socket_close(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double socket_id, double code, ::rust::Str reason, bool *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_web_socket_connect(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::WebSocketParams *params, ::craby::reactnativenitrotor::bridging::WebSocketResponse *return$) noexcept;
+
+::rust::repr::PtrLen craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_web_socket_send(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double socket_id, ::rust::Str data, bool binary, bool *return$) noexcept;
 } // extern "C"
 
 ::std::size_t ReactNativeNitroTor::layout::size() noexcept {
@@ -649,6 +933,24 @@ extern "C" {
   return ::rust::Box<::craby::reactnativenitrotor::bridging::ReactNativeNitroTor>::from_raw(craby$reactnativenitrotor$bridging$cxxbridge1$190$create_react_native_nitro_tor(id, data_path));
 }
 
+bool attachHttpServer(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double server_id) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_attach_http_server(it_, server_id, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+bool clearHttpCache(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_clear_http_cache(it_, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
 ::craby::reactnativenitrotor::bridging::HiddenServiceResponse createHiddenService(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HiddenServiceParams params) {
   ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::HiddenServiceParams> params$(::std::move(params));
   ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::HiddenServiceResponse> return$;
@@ -668,6 +970,52 @@ bool deleteHiddenService(::craby::reactnativenitrotor::bridging::ReactNativeNitr
   return ::std::move(return$.value);
 }
 
+::craby::reactnativenitrotor::bridging::DirectorySnapshotResponse exportDirectorySnapshot(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::DirectorySnapshotParams params) {
+  ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::DirectorySnapshotParams> params$(::std::move(params));
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::DirectorySnapshotResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_export_directory_snapshot(it_, &params$.value, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::rust::String getCircuitStats(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_) {
+  ::rust::MaybeUninit<::rust::String> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_circuit_stats(it_, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::craby::reactnativenitrotor::bridging::TorListeners getListeners(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_) {
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::TorListeners> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_listeners(it_, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::rust::String getOnionServiceMetrics(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str onion_address) {
+  ::rust::MaybeUninit<::rust::String> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_onion_service_metrics(it_, onion_address, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::rust::String getPrewarmStatus(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_) {
+  ::rust::MaybeUninit<::rust::String> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_prewarm_status(it_, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
 double getServiceStatus(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_) {
   ::rust::MaybeUninit<double> return$;
   ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_service_status(it_, &return$.value);
@@ -677,6 +1025,15 @@ double getServiceStatus(::craby::reactnativenitrotor::bridging::ReactNativeNitro
   return ::std::move(return$.value);
 }
 
+::rust::String getStartupReport(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_) {
+  ::rust::MaybeUninit<::rust::String> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_get_startup_report(it_, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
 ::craby::reactnativenitrotor::bridging::HttpResponse httpDelete(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HttpDeleteParams params) {
   ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::HttpDeleteParams> params$(::std::move(params));
   ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::HttpResponse> return$;
@@ -727,6 +1084,63 @@ bool initTorService(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor
   return ::std::move(return$.value);
 }
 
+::craby::reactnativenitrotor::bridging::StreamResponse openStream(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::OpenStreamParams params) {
+  ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::OpenStreamParams> params$(::std::move(params));
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::StreamResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_open_stream(it_, &params$.value, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::rust::String pollEvents(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double wait_ms) {
+  ::rust::MaybeUninit<::rust::String> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_poll_events(it_, wait_ms, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+bool prewarm(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::PrewarmParams params) {
+  ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::PrewarmParams> params$(::std::move(params));
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_prewarm(it_, &params$.value, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+bool respondHttpRequests(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str replies_json) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_respond_http_requests(it_, replies_json, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::craby::reactnativenitrotor::bridging::ResumeResponse resume(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double timeout_ms) {
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::ResumeResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_resume(it_, timeout_ms, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::craby::reactnativenitrotor::bridging::DirectorySnapshotResponse seedDirectorySnapshot(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::DirectorySnapshotParams params) {
+  ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::DirectorySnapshotParams> params$(::std::move(params));
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::DirectorySnapshotResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_seed_directory_snapshot(it_, &params$.value, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
 bool shutdownService(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_) {
   ::rust::MaybeUninit<bool> return$;
   ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_shutdown_service(it_, &return$.value);
@@ -736,6 +1150,26 @@ bool shutdownService(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor
   return ::std::move(return$.value);
 }
 
+::craby::reactnativenitrotor::bridging::HttpServerResponse startHttpServer(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::HttpServerParams params) {
+  ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::HttpServerParams> params$(::std::move(params));
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::HttpServerResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_start_http_server(it_, &params$.value, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::craby::reactnativenitrotor::bridging::ProxyResponse startProxy(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::ProxyParams params) {
+  ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::ProxyParams> params$(::std::move(params));
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::ProxyResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_start_proxy(it_, &params$.value, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
 ::craby::reactnativenitrotor::bridging::StartTorResponse startTorIfNotRunning(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::StartTorParams params) {
   ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::StartTorParams> params$(::std::move(params));
   ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::StartTorResponse> return$;
@@ -745,6 +1179,116 @@ bool shutdownService(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor
   }
   return ::std::move(return$.value);
 }
+
+bool stopHttpServer(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double server_id) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stop_http_server(it_, server_id, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+bool stopProxy(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::rust::Str address) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stop_proxy(it_, address, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+bool streamClose(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stream_close(it_, stream_id, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::craby::reactnativenitrotor::bridging::StreamReadResponse streamRead(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id, double max_bytes) {
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::StreamReadResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stream_read(it_, stream_id, max_bytes, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::craby::reactnativenitrotor::bridging::StreamResponse streamShutdownWrite(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id) {
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::StreamResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stream_shutdown_write(it_, stream_id, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::craby::reactnativenitrotor::bridging::StreamResponse streamWrite(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double stream_id, ::rust::Str data_base64) {
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::StreamResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_stream_write(it_, stream_id, data_base64, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+bool suspend(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_suspend(it_, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::craby::reactnativenitrotor::bridging::OnionPublishResponse waitOnionPublished(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::OnionPublishParams params) {
+  ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::OnionPublishParams> params$(::std::move(params));
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::OnionPublishResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_wait_onion_published(it_, &params$.value, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+bool webSocketAttach(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double socket_id) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_web_socket_attach(it_, socket_id, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+bool webSocketClose(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double socket_id, double code, ::rust::Str reason) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_web_socket_close(it_, socket_id, code, reason, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+::craby::reactnativenitrotor::bridging::WebSocketResponse webSocketConnect(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, ::craby::reactnativenitrotor::bridging::WebSocketParams params) {
+  ::rust::ManuallyDrop<::craby::reactnativenitrotor::bridging::WebSocketParams> params$(::std::move(params));
+  ::rust::MaybeUninit<::craby::reactnativenitrotor::bridging::WebSocketResponse> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_web_socket_connect(it_, &params$.value, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
+
+bool webSocketSend(::craby::reactnativenitrotor::bridging::ReactNativeNitroTor &it_, double socket_id, ::rust::Str data, bool binary) {
+  ::rust::MaybeUninit<bool> return$;
+  ::rust::repr::PtrLen error$ = craby$reactnativenitrotor$bridging$cxxbridge1$190$react_native_nitro_tor_web_socket_send(it_, socket_id, data, binary, &return$.value);
+  if (error$.ptr) {
+    throw ::rust::impl<::rust::Error>::error(error$);
+  }
+  return ::std::move(return$.value);
+}
 } // namespace bridging
 } // namespace reactnativenitrotor
 } // namespace craby
@@ -24,16 +24,44 @@ CxxReactNativeNitroTorModule::CxxReactNativeNitroTorModule(
     [](craby::reactnativenitrotor::bridging::ReactNativeNitroTor *ptr) { rust::Box<craby::reactnativenitrotor::bridging::ReactNativeNitroTor>::from_raw(ptr); }
   );
   threadPool_ = std::make_shared<craby::reactnativenitrotor::utils::ThreadPool>(10);
+  methodMap_["attachHttpServer"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::attachHttpServer};
+  methodMap_["clearHttpCache"] = MethodMetadata{0, &CxxReactNativeNitroTorModule::clearHttpCache};
   methodMap_["createHiddenService"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::createHiddenService};
   methodMap_["deleteHiddenService"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::deleteHiddenService};
+  methodMap_["exportDirectorySnapshot"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::exportDirectorySnapshot};
+  methodMap_["getCircuitStats"] = MethodMetadata{0, &CxxReactNativeNitroTorModule::getCircuitStats};
+  methodMap_["getListeners"] = MethodMetadata{0, &CxxReactNativeNitroTorModule::getListeners};
+  methodMap_["getOnionServiceMetrics"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::getOnionServiceMetrics};
+  methodMap_["getPrewarmStatus"] = MethodMetadata{0, &CxxReactNativeNitroTorModule::getPrewarmStatus};
   methodMap_["getServiceStatus"] = MethodMetadata{0, &CxxReactNativeNitroTorModule::getServiceStatus};
+  methodMap_["getStartupReport"] = MethodMetadata{0, &CxxReactNativeNitroTorModule::getStartupReport};
   methodMap_["httpDelete"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::httpDelete};
   methodMap_["httpGet"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::httpGet};
   methodMap_["httpPost"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::httpPost};
   methodMap_["httpPut"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::httpPut};
   methodMap_["initTorService"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::initTorService};
+  methodMap_["openStream"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::openStream};
+  methodMap_["pollEvents"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::pollEvents};
+  methodMap_["prewarm"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::prewarm};
+  methodMap_["respondHttpRequests"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::respondHttpRequests};
+  methodMap_["resume"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::resume};
+  methodMap_["seedDirectorySnapshot"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::seedDirectorySnapshot};
   methodMap_["shutdownService"] = MethodMetadata{0, &CxxReactNativeNitroTorModule::shutdownService};
+  methodMap_["startHttpServer"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::startHttpServer};
+  methodMap_["startProxy"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::startProxy};
   methodMap_["startTorIfNotRunning"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::startTorIfNotRunning};
+  methodMap_["stopHttpServer"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::stopHttpServer};
+  methodMap_["stopProxy"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::stopProxy};
+  methodMap_["streamClose"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::streamClose};
+  methodMap_["streamRead"] = MethodMetadata{2, &CxxReactNativeNitroTorModule::streamRead};
+  methodMap_["streamShutdownWrite"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::streamShutdownWrite};
+  methodMap_["streamWrite"] = MethodMetadata{2, &CxxReactNativeNitroTorModule::streamWrite};
+  methodMap_["suspend"] = MethodMetadata{0, &CxxReactNativeNitroTorModule::suspend};
+  methodMap_["waitOnionPublished"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::waitOnionPublished};
+  methodMap_["webSocketAttach"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::webSocketAttach};
+  methodMap_["webSocketClose"] = MethodMetadata{3, &CxxReactNativeNitroTorModule::webSocketClose};
+  methodMap_["webSocketConnect"] = MethodMetadata{1, &CxxReactNativeNitroTorModule::webSocketConnect};
+  methodMap_["webSocketSend"] = MethodMetadata{3, &CxxReactNativeNitroTorModule::webSocketSend};
 }
 
 CxxReactNativeNitroTorModule::~CxxReactNativeNitroTorModule() {
@@ -54,6 +82,75 @@ void CxxReactNativeNitroTorModule::invalidate() {
   threadPool_->shutdown();
 }
 
+jsi::Value CxxReactNativeNitroTorModule::attachHttpServer(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::attachHttpServer(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::clearHttpCache(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 argument");
+    }
+
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::clearHttpCache(*it_);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
 jsi::Value CxxReactNativeNitroTorModule::createHiddenService(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
@@ -125,7 +222,42 @@ jsi::Value CxxReactNativeNitroTorModule::deleteHiddenService(jsi::Runtime &rt,
   }
 }
 
-jsi::Value CxxReactNativeNitroTorModule::getServiceStatus(jsi::Runtime &rt,
+jsi::Value CxxReactNativeNitroTorModule::exportDirectorySnapshot(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::DirectorySnapshotParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::DirectorySnapshotResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::exportDirectorySnapshot(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::getCircuitStats(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
@@ -138,11 +270,11 @@ jsi::Value CxxReactNativeNitroTorModule::getServiceStatus(jsi::Runtime &rt,
       throw jsi::JSError(rt, "Expected 0 argument");
     }
 
-    react::AsyncPromise<double> promise(rt, callInvoker);
+    react::AsyncPromise<rust::String> promise(rt, callInvoker);
 
     thisModule.threadPool_->enqueue([it_, promise]() mutable {
       try {
-        auto ret = craby::reactnativenitrotor::bridging::getServiceStatus(*it_);
+        auto ret = craby::reactnativenitrotor::bridging::getCircuitStats(*it_);
         promise.resolve(ret);
       } catch (const jsi::JSError &err) {
         promise.reject(err.getMessage());
@@ -159,7 +291,7 @@ jsi::Value CxxReactNativeNitroTorModule::getServiceStatus(jsi::Runtime &rt,
   }
 }
 
-jsi::Value CxxReactNativeNitroTorModule::httpDelete(jsi::Runtime &rt,
+jsi::Value CxxReactNativeNitroTorModule::getListeners(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
@@ -168,16 +300,15 @@ jsi::Value CxxReactNativeNitroTorModule::httpDelete(jsi::Runtime &rt,
   auto it_ = thisModule.module_;
 
   try {
-    if (1 != count) {
-      throw jsi::JSError(rt, "Expected 1 argument");
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 argument");
     }
 
-    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::HttpDeleteParams>(rt, args[0], callInvoker);
-    react::AsyncPromise<craby::reactnativenitrotor::bridging::HttpResponse> promise(rt, callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::TorListeners> promise(rt, callInvoker);
 
-    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+    thisModule.threadPool_->enqueue([it_, promise]() mutable {
       try {
-        auto ret = craby::reactnativenitrotor::bridging::httpDelete(*it_, arg0);
+        auto ret = craby::reactnativenitrotor::bridging::getListeners(*it_);
         promise.resolve(ret);
       } catch (const jsi::JSError &err) {
         promise.reject(err.getMessage());
@@ -194,7 +325,7 @@ jsi::Value CxxReactNativeNitroTorModule::httpDelete(jsi::Runtime &rt,
   }
 }
 
-jsi::Value CxxReactNativeNitroTorModule::httpGet(jsi::Runtime &rt,
+jsi::Value CxxReactNativeNitroTorModule::getOnionServiceMetrics(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
@@ -207,12 +338,13 @@ jsi::Value CxxReactNativeNitroTorModule::httpGet(jsi::Runtime &rt,
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
-    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::HttpGetParams>(rt, args[0], callInvoker);
-    react::AsyncPromise<craby::reactnativenitrotor::bridging::HttpResponse> promise(rt, callInvoker);
+    auto arg0$raw = args[0].asString(rt).utf8(rt);
+    auto arg0 = rust::Str(arg0$raw.data(), arg0$raw.size());
+    react::AsyncPromise<rust::String> promise(rt, callInvoker);
 
     thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
       try {
-        auto ret = craby::reactnativenitrotor::bridging::httpGet(*it_, arg0);
+        auto ret = craby::reactnativenitrotor::bridging::getOnionServiceMetrics(*it_, arg0);
         promise.resolve(ret);
       } catch (const jsi::JSError &err) {
         promise.reject(err.getMessage());
@@ -229,7 +361,109 @@ jsi::Value CxxReactNativeNitroTorModule::httpGet(jsi::Runtime &rt,
   }
 }
 
-jsi::Value CxxReactNativeNitroTorModule::httpPost(jsi::Runtime &rt,
+jsi::Value CxxReactNativeNitroTorModule::getPrewarmStatus(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 argument");
+    }
+
+    react::AsyncPromise<rust::String> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::getPrewarmStatus(*it_);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::getServiceStatus(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 argument");
+    }
+
+    react::AsyncPromise<double> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::getServiceStatus(*it_);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::getStartupReport(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 argument");
+    }
+
+    react::AsyncPromise<rust::String> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::getStartupReport(*it_);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::httpDelete(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
@@ -242,12 +476,12 @@ jsi::Value CxxReactNativeNitroTorModule::httpPost(jsi::Runtime &rt,
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
-    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::HttpPostParams>(rt, args[0], callInvoker);
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::HttpDeleteParams>(rt, args[0], callInvoker);
     react::AsyncPromise<craby::reactnativenitrotor::bridging::HttpResponse> promise(rt, callInvoker);
 
     thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
       try {
-        auto ret = craby::reactnativenitrotor::bridging::httpPost(*it_, arg0);
+        auto ret = craby::reactnativenitrotor::bridging::httpDelete(*it_, arg0);
         promise.resolve(ret);
       } catch (const jsi::JSError &err) {
         promise.reject(err.getMessage());
@@ -264,7 +498,7 @@ jsi::Value CxxReactNativeNitroTorModule::httpPost(jsi::Runtime &rt,
   }
 }
 
-jsi::Value CxxReactNativeNitroTorModule::httpPut(jsi::Runtime &rt,
+jsi::Value CxxReactNativeNitroTorModule::httpGet(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
@@ -277,12 +511,12 @@ jsi::Value CxxReactNativeNitroTorModule::httpPut(jsi::Runtime &rt,
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
-    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::HttpPutParams>(rt, args[0], callInvoker);
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::HttpGetParams>(rt, args[0], callInvoker);
     react::AsyncPromise<craby::reactnativenitrotor::bridging::HttpResponse> promise(rt, callInvoker);
 
     thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
       try {
-        auto ret = craby::reactnativenitrotor::bridging::httpPut(*it_, arg0);
+        auto ret = craby::reactnativenitrotor::bridging::httpGet(*it_, arg0);
         promise.resolve(ret);
       } catch (const jsi::JSError &err) {
         promise.reject(err.getMessage());
@@ -299,7 +533,7 @@ jsi::Value CxxReactNativeNitroTorModule::httpPut(jsi::Runtime &rt,
   }
 }
 
-jsi::Value CxxReactNativeNitroTorModule::initTorService(jsi::Runtime &rt,
+jsi::Value CxxReactNativeNitroTorModule::httpPost(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
@@ -312,12 +546,12 @@ jsi::Value CxxReactNativeNitroTorModule::initTorService(jsi::Runtime &rt,
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
-    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::TorConfig>(rt, args[0], callInvoker);
-    react::AsyncPromise<bool> promise(rt, callInvoker);
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::HttpPostParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::HttpResponse> promise(rt, callInvoker);
 
     thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
       try {
-        auto ret = craby::reactnativenitrotor::bridging::initTorService(*it_, arg0);
+        auto ret = craby::reactnativenitrotor::bridging::httpPost(*it_, arg0);
         promise.resolve(ret);
       } catch (const jsi::JSError &err) {
         promise.reject(err.getMessage());
@@ -334,7 +568,7 @@ jsi::Value CxxReactNativeNitroTorModule::initTorService(jsi::Runtime &rt,
   }
 }
 
-jsi::Value CxxReactNativeNitroTorModule::shutdownService(jsi::Runtime &rt,
+jsi::Value CxxReactNativeNitroTorModule::httpPut(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
@@ -343,15 +577,16 @@ jsi::Value CxxReactNativeNitroTorModule::shutdownService(jsi::Runtime &rt,
   auto it_ = thisModule.module_;
 
   try {
-    if (0 != count) {
-      throw jsi::JSError(rt, "Expected 0 argument");
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
     }
 
-    react::AsyncPromise<bool> promise(rt, callInvoker);
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::HttpPutParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::HttpResponse> promise(rt, callInvoker);
 
-    thisModule.threadPool_->enqueue([it_, promise]() mutable {
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
       try {
-        auto ret = craby::reactnativenitrotor::bridging::shutdownService(*it_);
+        auto ret = craby::reactnativenitrotor::bridging::httpPut(*it_, arg0);
         promise.resolve(ret);
       } catch (const jsi::JSError &err) {
         promise.reject(err.getMessage());
@@ -368,7 +603,7 @@ jsi::Value CxxReactNativeNitroTorModule::shutdownService(jsi::Runtime &rt,
   }
 }
 
-jsi::Value CxxReactNativeNitroTorModule::startTorIfNotRunning(jsi::Runtime &rt,
+jsi::Value CxxReactNativeNitroTorModule::initTorService(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
@@ -381,12 +616,791 @@ jsi::Value CxxReactNativeNitroTorModule::startTorIfNotRunning(jsi::Runtime &rt,
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
-    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::StartTorParams>(rt, args[0], callInvoker);
-    react::AsyncPromise<craby::reactnativenitrotor::bridging::StartTorResponse> promise(rt, callInvoker);
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::TorConfig>(rt, args[0], callInvoker);
+    react::AsyncPromise<bool> promise(rt, callInvoker);
 
     thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
       try {
-        auto ret = craby::reactnativenitrotor::bridging::startTorIfNotRunning(*it_, arg0);
+        auto ret = craby::reactnativenitrotor::bridging::initTorService(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::openStream(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::OpenStreamParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::StreamResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::openStream(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::pollEvents(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    react::AsyncPromise<rust::String> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::pollEvents(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::prewarm(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::PrewarmParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::prewarm(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::respondHttpRequests(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0$raw = args[0].asString(rt).utf8(rt);
+    auto arg0 = rust::Str(arg0$raw.data(), arg0$raw.size());
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::respondHttpRequests(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::resume(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::ResumeResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::resume(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::seedDirectorySnapshot(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::DirectorySnapshotParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::DirectorySnapshotResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::seedDirectorySnapshot(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::shutdownService(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 argument");
+    }
+
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::shutdownService(*it_);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::startHttpServer(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::HttpServerParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::HttpServerResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::startHttpServer(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::startProxy(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::ProxyParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::ProxyResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::startProxy(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::startTorIfNotRunning(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::StartTorParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::StartTorResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::startTorIfNotRunning(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::stopHttpServer(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::stopHttpServer(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::stopProxy(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0$raw = args[0].asString(rt).utf8(rt);
+    auto arg0 = rust::Str(arg0$raw.data(), arg0$raw.size());
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::stopProxy(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::streamClose(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::streamClose(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::streamRead(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (2 != count) {
+      throw jsi::JSError(rt, "Expected 2 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    auto arg1 = react::bridging::fromJs<double>(rt, args[1], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::StreamReadResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0, arg1]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::streamRead(*it_, arg0, arg1);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::streamShutdownWrite(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::StreamResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::streamShutdownWrite(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::streamWrite(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (2 != count) {
+      throw jsi::JSError(rt, "Expected 2 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    auto arg1$raw = args[1].asString(rt).utf8(rt);
+    auto arg1 = rust::Str(arg1$raw.data(), arg1$raw.size());
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::StreamResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0, arg1]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::streamWrite(*it_, arg0, arg1);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::suspend(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 argument");
+    }
+
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::suspend(*it_);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::waitOnionPublished(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::OnionPublishParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::OnionPublishResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::waitOnionPublished(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::webSocketAttach(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::webSocketAttach(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::webSocketClose(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (3 != count) {
+      throw jsi::JSError(rt, "Expected 3 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    auto arg1 = react::bridging::fromJs<double>(rt, args[1], callInvoker);
+    auto arg2$raw = args[2].asString(rt).utf8(rt);
+    auto arg2 = rust::Str(arg2$raw.data(), arg2$raw.size());
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0, arg1, arg2]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::webSocketClose(*it_, arg0, arg1, arg2);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::webSocketConnect(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<craby::reactnativenitrotor::bridging::WebSocketParams>(rt, args[0], callInvoker);
+    react::AsyncPromise<craby::reactnativenitrotor::bridging::WebSocketResponse> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::webSocketConnect(*it_, arg0);
+        promise.resolve(ret);
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::reactnativenitrotor::utils::errorMessage(err));
+      }
+    });
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::reactnativenitrotor::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxReactNativeNitroTorModule::webSocketSend(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxReactNativeNitroTorModule &>(turboModule);
+  auto callInvoker = thisModule.callInvoker_;
+  auto it_ = thisModule.module_;
+
+  try {
+    if (3 != count) {
+      throw jsi::JSError(rt, "Expected 3 argument");
+    }
+
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    auto arg1$raw = args[1].asString(rt).utf8(rt);
+    auto arg1 = rust::Str(arg1$raw.data(), arg1$raw.size());
+    auto arg2 = react::bridging::fromJs<bool>(rt, args[2], callInvoker);
+    react::AsyncPromise<bool> promise(rt, callInvoker);
+
+    thisModule.threadPool_->enqueue([it_, promise, arg0, arg1, arg2]() mutable {
+      try {
+        auto ret = craby::reactnativenitrotor::bridging::webSocketSend(*it_, arg0, arg1, arg2);
         promise.resolve(ret);
       } catch (const jsi::JSError &err) {
         promise.reject(err.getMessage());
@@ -62,19 +62,93 @@ struct Bridging<rust::Vec<T>> {
   }
 };
 
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::DirectorySnapshotParams> {
+  static craby::reactnativenitrotor::bridging::DirectorySnapshotParams fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$dataDir = obj.getProperty(rt, "data_dir");
+    auto obj$snapshotDir = obj.getProperty(rt, "snapshot_dir");
+
+    auto _obj$dataDir = react::bridging::fromJs<rust::String>(rt, obj$dataDir, callInvoker);
+    auto _obj$snapshotDir = react::bridging::fromJs<rust::String>(rt, obj$snapshotDir, callInvoker);
+
+    craby::reactnativenitrotor::bridging::DirectorySnapshotParams ret = {
+      _obj$dataDir,
+      _obj$snapshotDir
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::DirectorySnapshotParams value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$dataDir = react::bridging::toJs(rt, value.data_dir);
+    auto _obj$snapshotDir = react::bridging::toJs(rt, value.snapshot_dir);
+
+    obj.setProperty(rt, "data_dir", _obj$dataDir);
+    obj.setProperty(rt, "snapshot_dir", _obj$snapshotDir);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::DirectorySnapshotResponse> {
+  static craby::reactnativenitrotor::bridging::DirectorySnapshotResponse fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$isSuccess = obj.getProperty(rt, "is_success");
+    auto obj$error = obj.getProperty(rt, "error");
+    auto obj$validUntil = obj.getProperty(rt, "valid_until");
+
+    auto _obj$isSuccess = react::bridging::fromJs<bool>(rt, obj$isSuccess, callInvoker);
+    auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
+    auto _obj$validUntil = react::bridging::fromJs<double>(rt, obj$validUntil, callInvoker);
+
+    craby::reactnativenitrotor::bridging::DirectorySnapshotResponse ret = {
+      _obj$isSuccess,
+      _obj$error,
+      _obj$validUntil
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::DirectorySnapshotResponse value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$isSuccess = react::bridging::toJs(rt, value.is_success);
+    auto _obj$error = react::bridging::toJs(rt, value.error);
+    auto _obj$validUntil = react::bridging::toJs(rt, value.valid_until);
+
+    obj.setProperty(rt, "is_success", _obj$isSuccess);
+    obj.setProperty(rt, "error", _obj$error);
+    obj.setProperty(rt, "valid_until", _obj$validUntil);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
 template <>
 struct Bridging<craby::reactnativenitrotor::bridging::HiddenServiceParams> {
   static craby::reactnativenitrotor::bridging::HiddenServiceParams fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
     auto obj = value.asObject(rt);
     auto obj$port = obj.getProperty(rt, "port");
     auto obj$targetPort = obj.getProperty(rt, "target_port");
+    auto obj$portsJson = obj.getProperty(rt, "ports_json");
+    auto obj$acceptStreams = obj.getProperty(rt, "accept_streams");
+    auto obj$defensesJson = obj.getProperty(rt, "defenses_json");
 
     auto _obj$port = react::bridging::fromJs<double>(rt, obj$port, callInvoker);
     auto _obj$targetPort = react::bridging::fromJs<double>(rt, obj$targetPort, callInvoker);
+    auto _obj$portsJson = react::bridging::fromJs<rust::String>(rt, obj$portsJson, callInvoker);
+    auto _obj$acceptStreams = react::bridging::fromJs<bool>(rt, obj$acceptStreams, callInvoker);
+    auto _obj$defensesJson = react::bridging::fromJs<rust::String>(rt, obj$defensesJson, callInvoker);
 
     craby::reactnativenitrotor::bridging::HiddenServiceParams ret = {
       _obj$port,
-      _obj$targetPort
+      _obj$targetPort,
+      _obj$portsJson,
+      _obj$acceptStreams,
+      _obj$defensesJson
     };
 
     return ret;
@@ -84,9 +158,15 @@ struct Bridging<craby::reactnativenitrotor::bridging::HiddenServiceParams> {
     jsi::Object obj = jsi::Object(rt);
     auto _obj$port = react::bridging::toJs(rt, value.port);
     auto _obj$targetPort = react::bridging::toJs(rt, value.target_port);
+    auto _obj$portsJson = react::bridging::toJs(rt, value.ports_json);
+    auto _obj$acceptStreams = react::bridging::toJs(rt, value.accept_streams);
+    auto _obj$defensesJson = react::bridging::toJs(rt, value.defenses_json);
 
     obj.setProperty(rt, "port", _obj$port);
     obj.setProperty(rt, "target_port", _obj$targetPort);
+    obj.setProperty(rt, "ports_json", _obj$portsJson);
+    obj.setProperty(rt, "accept_streams", _obj$acceptStreams);
+    obj.setProperty(rt, "defenses_json", _obj$defensesJson);
 
     return jsi::Value(rt, obj);
   }
@@ -99,15 +179,18 @@ struct Bridging<craby::reactnativenitrotor::bridging::HiddenServiceResponse> {
     auto obj$isSuccess = obj.getProperty(rt, "is_success");
     auto obj$onionAddress = obj.getProperty(rt, "onion_address");
     auto obj$control = obj.getProperty(rt, "control");
+    auto obj$error = obj.getProperty(rt, "error");
 
     auto _obj$isSuccess = react::bridging::fromJs<bool>(rt, obj$isSuccess, callInvoker);
     auto _obj$onionAddress = react::bridging::fromJs<rust::String>(rt, obj$onionAddress, callInvoker);
     auto _obj$control = react::bridging::fromJs<rust::String>(rt, obj$control, callInvoker);
+    auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
 
     craby::reactnativenitrotor::bridging::HiddenServiceResponse ret = {
       _obj$isSuccess,
       _obj$onionAddress,
-      _obj$control
+      _obj$control,
+      _obj$error
     };
 
     return ret;
@@ -118,10 +201,12 @@ struct Bridging<craby::reactnativenitrotor::bridging::HiddenServiceResponse> {
     auto _obj$isSuccess = react::bridging::toJs(rt, value.is_success);
     auto _obj$onionAddress = react::bridging::toJs(rt, value.onion_address);
     auto _obj$control = react::bridging::toJs(rt, value.control);
+    auto _obj$error = react::bridging::toJs(rt, value.error);
 
     obj.setProperty(rt, "is_success", _obj$isSuccess);
     obj.setProperty(rt, "onion_address", _obj$onionAddress);
     obj.setProperty(rt, "control", _obj$control);
+    obj.setProperty(rt, "error", _obj$error);
 
     return jsi::Value(rt, obj);
   }
@@ -134,15 +219,24 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpDeleteParams> {
     auto obj$url = obj.getProperty(rt, "url");
     auto obj$headers = obj.getProperty(rt, "headers");
     auto obj$timeoutMs = obj.getProperty(rt, "timeout_ms");
+    auto obj$acceptEncoding = obj.getProperty(rt, "accept_encoding");
+    auto obj$isolation = obj.getProperty(rt, "isolation");
+    auto obj$freshCircuit = obj.getProperty(rt, "fresh_circuit");
 
     auto _obj$url = react::bridging::fromJs<rust::String>(rt, obj$url, callInvoker);
     auto _obj$headers = react::bridging::fromJs<rust::String>(rt, obj$headers, callInvoker);
     auto _obj$timeoutMs = react::bridging::fromJs<double>(rt, obj$timeoutMs, callInvoker);
+    auto _obj$acceptEncoding = react::bridging::fromJs<rust::String>(rt, obj$acceptEncoding, callInvoker);
+    auto _obj$isolation = react::bridging::fromJs<rust::String>(rt, obj$isolation, callInvoker);
+    auto _obj$freshCircuit = react::bridging::fromJs<bool>(rt, obj$freshCircuit, callInvoker);
 
     craby::reactnativenitrotor::bridging::HttpDeleteParams ret = {
       _obj$url,
       _obj$headers,
-      _obj$timeoutMs
+      _obj$timeoutMs,
+      _obj$acceptEncoding,
+      _obj$isolation,
+      _obj$freshCircuit
     };
 
     return ret;
@@ -153,10 +247,16 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpDeleteParams> {
     auto _obj$url = react::bridging::toJs(rt, value.url);
     auto _obj$headers = react::bridging::toJs(rt, value.headers);
     auto _obj$timeoutMs = react::bridging::toJs(rt, value.timeout_ms);
+    auto _obj$acceptEncoding = react::bridging::toJs(rt, value.accept_encoding);
+    auto _obj$isolation = react::bridging::toJs(rt, value.isolation);
+    auto _obj$freshCircuit = react::bridging::toJs(rt, value.fresh_circuit);
 
     obj.setProperty(rt, "url", _obj$url);
     obj.setProperty(rt, "headers", _obj$headers);
     obj.setProperty(rt, "timeout_ms", _obj$timeoutMs);
+    obj.setProperty(rt, "accept_encoding", _obj$acceptEncoding);
+    obj.setProperty(rt, "isolation", _obj$isolation);
+    obj.setProperty(rt, "fresh_circuit", _obj$freshCircuit);
 
     return jsi::Value(rt, obj);
   }
@@ -169,15 +269,30 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpGetParams> {
     auto obj$url = obj.getProperty(rt, "url");
     auto obj$headers = obj.getProperty(rt, "headers");
     auto obj$timeoutMs = obj.getProperty(rt, "timeout_ms");
+    auto obj$acceptEncoding = obj.getProperty(rt, "accept_encoding");
+    auto obj$cache = obj.getProperty(rt, "cache");
+    auto obj$hedgePercentile = obj.getProperty(rt, "hedge_percentile");
+    auto obj$isolation = obj.getProperty(rt, "isolation");
+    auto obj$freshCircuit = obj.getProperty(rt, "fresh_circuit");
 
     auto _obj$url = react::bridging::fromJs<rust::String>(rt, obj$url, callInvoker);
     auto _obj$headers = react::bridging::fromJs<rust::String>(rt, obj$headers, callInvoker);
     auto _obj$timeoutMs = react::bridging::fromJs<double>(rt, obj$timeoutMs, callInvoker);
+    auto _obj$acceptEncoding = react::bridging::fromJs<rust::String>(rt, obj$acceptEncoding, callInvoker);
+    auto _obj$cache = react::bridging::fromJs<bool>(rt, obj$cache, callInvoker);
+    auto _obj$hedgePercentile = react::bridging::fromJs<double>(rt, obj$hedgePercentile, callInvoker);
+    auto _obj$isolation = react::bridging::fromJs<rust::String>(rt, obj$isolation, callInvoker);
+    auto _obj$freshCircuit = react::bridging::fromJs<bool>(rt, obj$freshCircuit, callInvoker);
 
     craby::reactnativenitrotor::bridging::HttpGetParams ret = {
       _obj$url,
       _obj$headers,
-      _obj$timeoutMs
+      _obj$timeoutMs,
+      _obj$acceptEncoding,
+      _obj$cache,
+      _obj$hedgePercentile,
+      _obj$isolation,
+      _obj$freshCircuit
     };
 
     return ret;
@@ -188,10 +303,20 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpGetParams> {
     auto _obj$url = react::bridging::toJs(rt, value.url);
     auto _obj$headers = react::bridging::toJs(rt, value.headers);
     auto _obj$timeoutMs = react::bridging::toJs(rt, value.timeout_ms);
+    auto _obj$acceptEncoding = react::bridging::toJs(rt, value.accept_encoding);
+    auto _obj$cache = react::bridging::toJs(rt, value.cache);
+    auto _obj$hedgePercentile = react::bridging::toJs(rt, value.hedge_percentile);
+    auto _obj$isolation = react::bridging::toJs(rt, value.isolation);
+    auto _obj$freshCircuit = react::bridging::toJs(rt, value.fresh_circuit);
 
     obj.setProperty(rt, "url", _obj$url);
     obj.setProperty(rt, "headers", _obj$headers);
     obj.setProperty(rt, "timeout_ms", _obj$timeoutMs);
+    obj.setProperty(rt, "accept_encoding", _obj$acceptEncoding);
+    obj.setProperty(rt, "cache", _obj$cache);
+    obj.setProperty(rt, "hedge_percentile", _obj$hedgePercentile);
+    obj.setProperty(rt, "isolation", _obj$isolation);
+    obj.setProperty(rt, "fresh_circuit", _obj$freshCircuit);
 
     return jsi::Value(rt, obj);
   }
@@ -205,17 +330,26 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpPostParams> {
     auto obj$body = obj.getProperty(rt, "body");
     auto obj$headers = obj.getProperty(rt, "headers");
     auto obj$timeoutMs = obj.getProperty(rt, "timeout_ms");
+    auto obj$acceptEncoding = obj.getProperty(rt, "accept_encoding");
+    auto obj$isolation = obj.getProperty(rt, "isolation");
+    auto obj$freshCircuit = obj.getProperty(rt, "fresh_circuit");
 
     auto _obj$url = react::bridging::fromJs<rust::String>(rt, obj$url, callInvoker);
     auto _obj$body = react::bridging::fromJs<rust::String>(rt, obj$body, callInvoker);
     auto _obj$headers = react::bridging::fromJs<rust::String>(rt, obj$headers, callInvoker);
     auto _obj$timeoutMs = react::bridging::fromJs<double>(rt, obj$timeoutMs, callInvoker);
+    auto _obj$acceptEncoding = react::bridging::fromJs<rust::String>(rt, obj$acceptEncoding, callInvoker);
+    auto _obj$isolation = react::bridging::fromJs<rust::String>(rt, obj$isolation, callInvoker);
+    auto _obj$freshCircuit = react::bridging::fromJs<bool>(rt, obj$freshCircuit, callInvoker);
 
     craby::reactnativenitrotor::bridging::HttpPostParams ret = {
       _obj$url,
       _obj$body,
       _obj$headers,
-      _obj$timeoutMs
+      _obj$timeoutMs,
+      _obj$acceptEncoding,
+      _obj$isolation,
+      _obj$freshCircuit
     };
 
     return ret;
@@ -227,11 +361,17 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpPostParams> {
     auto _obj$body = react::bridging::toJs(rt, value.body);
     auto _obj$headers = react::bridging::toJs(rt, value.headers);
     auto _obj$timeoutMs = react::bridging::toJs(rt, value.timeout_ms);
+    auto _obj$acceptEncoding = react::bridging::toJs(rt, value.accept_encoding);
+    auto _obj$isolation = react::bridging::toJs(rt, value.isolation);
+    auto _obj$freshCircuit = react::bridging::toJs(rt, value.fresh_circuit);
 
     obj.setProperty(rt, "url", _obj$url);
     obj.setProperty(rt, "body", _obj$body);
     obj.setProperty(rt, "headers", _obj$headers);
     obj.setProperty(rt, "timeout_ms", _obj$timeoutMs);
+    obj.setProperty(rt, "accept_encoding", _obj$acceptEncoding);
+    obj.setProperty(rt, "isolation", _obj$isolation);
+    obj.setProperty(rt, "fresh_circuit", _obj$freshCircuit);
 
     return jsi::Value(rt, obj);
   }
@@ -245,17 +385,26 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpPutParams> {
     auto obj$body = obj.getProperty(rt, "body");
     auto obj$headers = obj.getProperty(rt, "headers");
     auto obj$timeoutMs = obj.getProperty(rt, "timeout_ms");
+    auto obj$acceptEncoding = obj.getProperty(rt, "accept_encoding");
+    auto obj$isolation = obj.getProperty(rt, "isolation");
+    auto obj$freshCircuit = obj.getProperty(rt, "fresh_circuit");
 
     auto _obj$url = react::bridging::fromJs<rust::String>(rt, obj$url, callInvoker);
     auto _obj$body = react::bridging::fromJs<rust::String>(rt, obj$body, callInvoker);
     auto _obj$headers = react::bridging::fromJs<rust::String>(rt, obj$headers, callInvoker);
     auto _obj$timeoutMs = react::bridging::fromJs<double>(rt, obj$timeoutMs, callInvoker);
+    auto _obj$acceptEncoding = react::bridging::fromJs<rust::String>(rt, obj$acceptEncoding, callInvoker);
+    auto _obj$isolation = react::bridging::fromJs<rust::String>(rt, obj$isolation, callInvoker);
+    auto _obj$freshCircuit = react::bridging::fromJs<bool>(rt, obj$freshCircuit, callInvoker);
 
     craby::reactnativenitrotor::bridging::HttpPutParams ret = {
       _obj$url,
       _obj$body,
       _obj$headers,
-      _obj$timeoutMs
+      _obj$timeoutMs,
+      _obj$acceptEncoding,
+      _obj$isolation,
+      _obj$freshCircuit
     };
 
     return ret;
@@ -267,11 +416,17 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpPutParams> {
     auto _obj$body = react::bridging::toJs(rt, value.body);
     auto _obj$headers = react::bridging::toJs(rt, value.headers);
     auto _obj$timeoutMs = react::bridging::toJs(rt, value.timeout_ms);
+    auto _obj$acceptEncoding = react::bridging::toJs(rt, value.accept_encoding);
+    auto _obj$isolation = react::bridging::toJs(rt, value.isolation);
+    auto _obj$freshCircuit = react::bridging::toJs(rt, value.fresh_circuit);
 
     obj.setProperty(rt, "url", _obj$url);
     obj.setProperty(rt, "body", _obj$body);
     obj.setProperty(rt, "headers", _obj$headers);
     obj.setProperty(rt, "timeout_ms", _obj$timeoutMs);
+    obj.setProperty(rt, "accept_encoding", _obj$acceptEncoding);
+    obj.setProperty(rt, "isolation", _obj$isolation);
+    obj.setProperty(rt, "fresh_circuit", _obj$freshCircuit);
 
     return jsi::Value(rt, obj);
   }
@@ -284,15 +439,27 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpResponse> {
     auto obj$statusCode = obj.getProperty(rt, "status_code");
     auto obj$body = obj.getProperty(rt, "body");
     auto obj$error = obj.getProperty(rt, "error");
+    auto obj$wireBytes = obj.getProperty(rt, "wire_bytes");
+    auto obj$decodedBytes = obj.getProperty(rt, "decoded_bytes");
+    auto obj$cacheStatus = obj.getProperty(rt, "cache_status");
+    auto obj$conflux = obj.getProperty(rt, "conflux");
 
     auto _obj$statusCode = react::bridging::fromJs<double>(rt, obj$statusCode, callInvoker);
     auto _obj$body = react::bridging::fromJs<rust::String>(rt, obj$body, callInvoker);
     auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
+    auto _obj$wireBytes = react::bridging::fromJs<double>(rt, obj$wireBytes, callInvoker);
+    auto _obj$decodedBytes = react::bridging::fromJs<double>(rt, obj$decodedBytes, callInvoker);
+    auto _obj$cacheStatus = react::bridging::fromJs<rust::String>(rt, obj$cacheStatus, callInvoker);
+    auto _obj$conflux = react::bridging::fromJs<bool>(rt, obj$conflux, callInvoker);
 
     craby::reactnativenitrotor::bridging::HttpResponse ret = {
       _obj$statusCode,
       _obj$body,
-      _obj$error
+      _obj$error,
+      _obj$wireBytes,
+      _obj$decodedBytes,
+      _obj$cacheStatus,
+      _obj$conflux
     };
 
     return ret;
@@ -303,10 +470,353 @@ struct Bridging<craby::reactnativenitrotor::bridging::HttpResponse> {
     auto _obj$statusCode = react::bridging::toJs(rt, value.status_code);
     auto _obj$body = react::bridging::toJs(rt, value.body);
     auto _obj$error = react::bridging::toJs(rt, value.error);
+    auto _obj$wireBytes = react::bridging::toJs(rt, value.wire_bytes);
+    auto _obj$decodedBytes = react::bridging::toJs(rt, value.decoded_bytes);
+    auto _obj$cacheStatus = react::bridging::toJs(rt, value.cache_status);
+    auto _obj$conflux = react::bridging::toJs(rt, value.conflux);
 
     obj.setProperty(rt, "status_code", _obj$statusCode);
     obj.setProperty(rt, "body", _obj$body);
     obj.setProperty(rt, "error", _obj$error);
+    obj.setProperty(rt, "wire_bytes", _obj$wireBytes);
+    obj.setProperty(rt, "decoded_bytes", _obj$decodedBytes);
+    obj.setProperty(rt, "cache_status", _obj$cacheStatus);
+    obj.setProperty(rt, "conflux", _obj$conflux);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::HttpServerParams> {
+  static craby::reactnativenitrotor::bridging::HttpServerParams fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$listen = obj.getProperty(rt, "listen");
+    auto obj$staticDir = obj.getProperty(rt, "static_dir");
+    auto obj$routesJson = obj.getProperty(rt, "routes_json");
+    auto obj$dispatch = obj.getProperty(rt, "dispatch");
+    auto obj$handlerTimeoutMs = obj.getProperty(rt, "handler_timeout_ms");
+
+    auto _obj$listen = react::bridging::fromJs<rust::String>(rt, obj$listen, callInvoker);
+    auto _obj$staticDir = react::bridging::fromJs<rust::String>(rt, obj$staticDir, callInvoker);
+    auto _obj$routesJson = react::bridging::fromJs<rust::String>(rt, obj$routesJson, callInvoker);
+    auto _obj$dispatch = react::bridging::fromJs<bool>(rt, obj$dispatch, callInvoker);
+    auto _obj$handlerTimeoutMs = react::bridging::fromJs<double>(rt, obj$handlerTimeoutMs, callInvoker);
+
+    craby::reactnativenitrotor::bridging::HttpServerParams ret = {
+      _obj$listen,
+      _obj$staticDir,
+      _obj$routesJson,
+      _obj$dispatch,
+      _obj$handlerTimeoutMs
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::HttpServerParams value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$listen = react::bridging::toJs(rt, value.listen);
+    auto _obj$staticDir = react::bridging::toJs(rt, value.static_dir);
+    auto _obj$routesJson = react::bridging::toJs(rt, value.routes_json);
+    auto _obj$dispatch = react::bridging::toJs(rt, value.dispatch);
+    auto _obj$handlerTimeoutMs = react::bridging::toJs(rt, value.handler_timeout_ms);
+
+    obj.setProperty(rt, "listen", _obj$listen);
+    obj.setProperty(rt, "static_dir", _obj$staticDir);
+    obj.setProperty(rt, "routes_json", _obj$routesJson);
+    obj.setProperty(rt, "dispatch", _obj$dispatch);
+    obj.setProperty(rt, "handler_timeout_ms", _obj$handlerTimeoutMs);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::HttpServerResponse> {
+  static craby::reactnativenitrotor::bridging::HttpServerResponse fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$isSuccess = obj.getProperty(rt, "is_success");
+    auto obj$error = obj.getProperty(rt, "error");
+    auto obj$serverId = obj.getProperty(rt, "server_id");
+    auto obj$address = obj.getProperty(rt, "address");
+
+    auto _obj$isSuccess = react::bridging::fromJs<bool>(rt, obj$isSuccess, callInvoker);
+    auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
+    auto _obj$serverId = react::bridging::fromJs<double>(rt, obj$serverId, callInvoker);
+    auto _obj$address = react::bridging::fromJs<rust::String>(rt, obj$address, callInvoker);
+
+    craby::reactnativenitrotor::bridging::HttpServerResponse ret = {
+      _obj$isSuccess,
+      _obj$error,
+      _obj$serverId,
+      _obj$address
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::HttpServerResponse value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$isSuccess = react::bridging::toJs(rt, value.is_success);
+    auto _obj$error = react::bridging::toJs(rt, value.error);
+    auto _obj$serverId = react::bridging::toJs(rt, value.server_id);
+    auto _obj$address = react::bridging::toJs(rt, value.address);
+
+    obj.setProperty(rt, "is_success", _obj$isSuccess);
+    obj.setProperty(rt, "error", _obj$error);
+    obj.setProperty(rt, "server_id", _obj$serverId);
+    obj.setProperty(rt, "address", _obj$address);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::OnionPublishParams> {
+  static craby::reactnativenitrotor::bridging::OnionPublishParams fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$onionAddress = obj.getProperty(rt, "onion_address");
+    auto obj$minHsdirs = obj.getProperty(rt, "min_hsdirs");
+    auto obj$timeoutMs = obj.getProperty(rt, "timeout_ms");
+
+    auto _obj$onionAddress = react::bridging::fromJs<rust::String>(rt, obj$onionAddress, callInvoker);
+    auto _obj$minHsdirs = react::bridging::fromJs<double>(rt, obj$minHsdirs, callInvoker);
+    auto _obj$timeoutMs = react::bridging::fromJs<double>(rt, obj$timeoutMs, callInvoker);
+
+    craby::reactnativenitrotor::bridging::OnionPublishParams ret = {
+      _obj$onionAddress,
+      _obj$minHsdirs,
+      _obj$timeoutMs
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::OnionPublishParams value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$onionAddress = react::bridging::toJs(rt, value.onion_address);
+    auto _obj$minHsdirs = react::bridging::toJs(rt, value.min_hsdirs);
+    auto _obj$timeoutMs = react::bridging::toJs(rt, value.timeout_ms);
+
+    obj.setProperty(rt, "onion_address", _obj$onionAddress);
+    obj.setProperty(rt, "min_hsdirs", _obj$minHsdirs);
+    obj.setProperty(rt, "timeout_ms", _obj$timeoutMs);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::OnionPublishResponse> {
+  static craby::reactnativenitrotor::bridging::OnionPublishResponse fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$isSuccess = obj.getProperty(rt, "is_success");
+    auto obj$hsdirs = obj.getProperty(rt, "hsdirs");
+    auto obj$error = obj.getProperty(rt, "error");
+
+    auto _obj$isSuccess = react::bridging::fromJs<bool>(rt, obj$isSuccess, callInvoker);
+    auto _obj$hsdirs = react::bridging::fromJs<double>(rt, obj$hsdirs, callInvoker);
+    auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
+
+    craby::reactnativenitrotor::bridging::OnionPublishResponse ret = {
+      _obj$isSuccess,
+      _obj$hsdirs,
+      _obj$error
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::OnionPublishResponse value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$isSuccess = react::bridging::toJs(rt, value.is_success);
+    auto _obj$hsdirs = react::bridging::toJs(rt, value.hsdirs);
+    auto _obj$error = react::bridging::toJs(rt, value.error);
+
+    obj.setProperty(rt, "is_success", _obj$isSuccess);
+    obj.setProperty(rt, "hsdirs", _obj$hsdirs);
+    obj.setProperty(rt, "error", _obj$error);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::OpenStreamParams> {
+  static craby::reactnativenitrotor::bridging::OpenStreamParams fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$host = obj.getProperty(rt, "host");
+    auto obj$port = obj.getProperty(rt, "port");
+    auto obj$timeoutMs = obj.getProperty(rt, "timeout_ms");
+    auto obj$isolation = obj.getProperty(rt, "isolation");
+
+    auto _obj$host = react::bridging::fromJs<rust::String>(rt, obj$host, callInvoker);
+    auto _obj$port = react::bridging::fromJs<double>(rt, obj$port, callInvoker);
+    auto _obj$timeoutMs = react::bridging::fromJs<double>(rt, obj$timeoutMs, callInvoker);
+    auto _obj$isolation = react::bridging::fromJs<rust::String>(rt, obj$isolation, callInvoker);
+
+    craby::reactnativenitrotor::bridging::OpenStreamParams ret = {
+      _obj$host,
+      _obj$port,
+      _obj$timeoutMs,
+      _obj$isolation
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::OpenStreamParams value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$host = react::bridging::toJs(rt, value.host);
+    auto _obj$port = react::bridging::toJs(rt, value.port);
+    auto _obj$timeoutMs = react::bridging::toJs(rt, value.timeout_ms);
+    auto _obj$isolation = react::bridging::toJs(rt, value.isolation);
+
+    obj.setProperty(rt, "host", _obj$host);
+    obj.setProperty(rt, "port", _obj$port);
+    obj.setProperty(rt, "timeout_ms", _obj$timeoutMs);
+    obj.setProperty(rt, "isolation", _obj$isolation);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::PrewarmParams> {
+  static craby::reactnativenitrotor::bridging::PrewarmParams fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$targetsJson = obj.getProperty(rt, "targets_json");
+    auto obj$keepaliveMs = obj.getProperty(rt, "keepalive_ms");
+    auto obj$isolation = obj.getProperty(rt, "isolation");
+
+    auto _obj$targetsJson = react::bridging::fromJs<rust::String>(rt, obj$targetsJson, callInvoker);
+    auto _obj$keepaliveMs = react::bridging::fromJs<double>(rt, obj$keepaliveMs, callInvoker);
+    auto _obj$isolation = react::bridging::fromJs<rust::String>(rt, obj$isolation, callInvoker);
+
+    craby::reactnativenitrotor::bridging::PrewarmParams ret = {
+      _obj$targetsJson,
+      _obj$keepaliveMs,
+      _obj$isolation
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::PrewarmParams value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$targetsJson = react::bridging::toJs(rt, value.targets_json);
+    auto _obj$keepaliveMs = react::bridging::toJs(rt, value.keepalive_ms);
+    auto _obj$isolation = react::bridging::toJs(rt, value.isolation);
+
+    obj.setProperty(rt, "targets_json", _obj$targetsJson);
+    obj.setProperty(rt, "keepalive_ms", _obj$keepaliveMs);
+    obj.setProperty(rt, "isolation", _obj$isolation);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::ProxyParams> {
+  static craby::reactnativenitrotor::bridging::ProxyParams fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$listen = obj.getProperty(rt, "listen");
+    auto obj$isolation = obj.getProperty(rt, "isolation");
+
+    auto _obj$listen = react::bridging::fromJs<rust::String>(rt, obj$listen, callInvoker);
+    auto _obj$isolation = react::bridging::fromJs<rust::String>(rt, obj$isolation, callInvoker);
+
+    craby::reactnativenitrotor::bridging::ProxyParams ret = {
+      _obj$listen,
+      _obj$isolation
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::ProxyParams value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$listen = react::bridging::toJs(rt, value.listen);
+    auto _obj$isolation = react::bridging::toJs(rt, value.isolation);
+
+    obj.setProperty(rt, "listen", _obj$listen);
+    obj.setProperty(rt, "isolation", _obj$isolation);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::ProxyResponse> {
+  static craby::reactnativenitrotor::bridging::ProxyResponse fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$isSuccess = obj.getProperty(rt, "is_success");
+    auto obj$error = obj.getProperty(rt, "error");
+    auto obj$address = obj.getProperty(rt, "address");
+    auto obj$credentials = obj.getProperty(rt, "credentials");
+
+    auto _obj$isSuccess = react::bridging::fromJs<bool>(rt, obj$isSuccess, callInvoker);
+    auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
+    auto _obj$address = react::bridging::fromJs<rust::String>(rt, obj$address, callInvoker);
+    auto _obj$credentials = react::bridging::fromJs<rust::String>(rt, obj$credentials, callInvoker);
+
+    craby::reactnativenitrotor::bridging::ProxyResponse ret = {
+      _obj$isSuccess,
+      _obj$error,
+      _obj$address,
+      _obj$credentials
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::ProxyResponse value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$isSuccess = react::bridging::toJs(rt, value.is_success);
+    auto _obj$error = react::bridging::toJs(rt, value.error);
+    auto _obj$address = react::bridging::toJs(rt, value.address);
+    auto _obj$credentials = react::bridging::toJs(rt, value.credentials);
+
+    obj.setProperty(rt, "is_success", _obj$isSuccess);
+    obj.setProperty(rt, "error", _obj$error);
+    obj.setProperty(rt, "address", _obj$address);
+    obj.setProperty(rt, "credentials", _obj$credentials);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::ResumeResponse> {
+  static craby::reactnativenitrotor::bridging::ResumeResponse fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$isSuccess = obj.getProperty(rt, "is_success");
+    auto obj$error = obj.getProperty(rt, "error");
+    auto obj$resumeMs = obj.getProperty(rt, "resume_ms");
+
+    auto _obj$isSuccess = react::bridging::fromJs<bool>(rt, obj$isSuccess, callInvoker);
+    auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
+    auto _obj$resumeMs = react::bridging::fromJs<double>(rt, obj$resumeMs, callInvoker);
+
+    craby::reactnativenitrotor::bridging::ResumeResponse ret = {
+      _obj$isSuccess,
+      _obj$error,
+      _obj$resumeMs
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::ResumeResponse value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$isSuccess = react::bridging::toJs(rt, value.is_success);
+    auto _obj$error = react::bridging::toJs(rt, value.error);
+    auto _obj$resumeMs = react::bridging::toJs(rt, value.resume_ms);
+
+    obj.setProperty(rt, "is_success", _obj$isSuccess);
+    obj.setProperty(rt, "error", _obj$error);
+    obj.setProperty(rt, "resume_ms", _obj$resumeMs);
 
     return jsi::Value(rt, obj);
   }
@@ -321,19 +831,25 @@ struct Bridging<craby::reactnativenitrotor::bridging::StartTorParams> {
     auto obj$targetPort = obj.getProperty(rt, "target_port");
     auto obj$timeoutMs = obj.getProperty(rt, "timeout_ms");
     auto obj$keysJson = obj.getProperty(rt, "keys_json");
+    auto obj$profile = obj.getProperty(rt, "profile");
+    auto obj$torrcOverridesJson = obj.getProperty(rt, "torrc_overrides_json");
 
     auto _obj$dataDir = react::bridging::fromJs<rust::String>(rt, obj$dataDir, callInvoker);
     auto _obj$socksPort = react::bridging::fromJs<double>(rt, obj$socksPort, callInvoker);
     auto _obj$targetPort = react::bridging::fromJs<double>(rt, obj$targetPort, callInvoker);
     auto _obj$timeoutMs = react::bridging::fromJs<double>(rt, obj$timeoutMs, callInvoker);
     auto _obj$keysJson = react::bridging::fromJs<rust::String>(rt, obj$keysJson, callInvoker);
+    auto _obj$profile = react::bridging::fromJs<rust::String>(rt, obj$profile, callInvoker);
+    auto _obj$torrcOverridesJson = react::bridging::fromJs<rust::String>(rt, obj$torrcOverridesJson, callInvoker);
 
     craby::reactnativenitrotor::bridging::StartTorParams ret = {
       _obj$dataDir,
       _obj$socksPort,
       _obj$targetPort,
       _obj$timeoutMs,
-      _obj$keysJson
+      _obj$keysJson,
+      _obj$profile,
+      _obj$torrcOverridesJson
     };
 
     return ret;
@@ -346,12 +862,16 @@ struct Bridging<craby::reactnativenitrotor::bridging::StartTorParams> {
     auto _obj$targetPort = react::bridging::toJs(rt, value.target_port);
     auto _obj$timeoutMs = react::bridging::toJs(rt, value.timeout_ms);
     auto _obj$keysJson = react::bridging::toJs(rt, value.keys_json);
+    auto _obj$profile = react::bridging::toJs(rt, value.profile);
+    auto _obj$torrcOverridesJson = react::bridging::toJs(rt, value.torrc_overrides_json);
 
     obj.setProperty(rt, "data_dir", _obj$dataDir);
     obj.setProperty(rt, "socks_port", _obj$socksPort);
     obj.setProperty(rt, "target_port", _obj$targetPort);
     obj.setProperty(rt, "timeout_ms", _obj$timeoutMs);
     obj.setProperty(rt, "keys_json", _obj$keysJson);
+    obj.setProperty(rt, "profile", _obj$profile);
+    obj.setProperty(rt, "torrc_overrides_json", _obj$torrcOverridesJson);
 
     return jsi::Value(rt, obj);
   }
@@ -364,12 +884,14 @@ struct Bridging<craby::reactnativenitrotor::bridging::StartTorResponse> {
     auto obj$isSuccess = obj.getProperty(rt, "is_success");
     auto obj$onionAddress = obj.getProperty(rt, "onion_address");
     auto obj$control = obj.getProperty(rt, "control");
+    auto obj$socksPort = obj.getProperty(rt, "socks_port");
     auto obj$errorMessage = obj.getProperty(rt, "error_message");
     auto obj$onionAddressesJson = obj.getProperty(rt, "onion_addresses_json");
 
     auto _obj$isSuccess = react::bridging::fromJs<bool>(rt, obj$isSuccess, callInvoker);
     auto _obj$onionAddress = react::bridging::fromJs<rust::String>(rt, obj$onionAddress, callInvoker);
     auto _obj$control = react::bridging::fromJs<rust::String>(rt, obj$control, callInvoker);
+    auto _obj$socksPort = react::bridging::fromJs<double>(rt, obj$socksPort, callInvoker);
     auto _obj$errorMessage = react::bridging::fromJs<rust::String>(rt, obj$errorMessage, callInvoker);
     auto _obj$onionAddressesJson = react::bridging::fromJs<rust::String>(rt, obj$onionAddressesJson, callInvoker);
 
@@ -377,6 +899,7 @@ struct Bridging<craby::reactnativenitrotor::bridging::StartTorResponse> {
       _obj$isSuccess,
       _obj$onionAddress,
       _obj$control,
+      _obj$socksPort,
       _obj$errorMessage,
       _obj$onionAddressesJson
     };
@@ -389,12 +912,14 @@ struct Bridging<craby::reactnativenitrotor::bridging::StartTorResponse> {
     auto _obj$isSuccess = react::bridging::toJs(rt, value.is_success);
     auto _obj$onionAddress = react::bridging::toJs(rt, value.onion_address);
     auto _obj$control = react::bridging::toJs(rt, value.control);
+    auto _obj$socksPort = react::bridging::toJs(rt, value.socks_port);
     auto _obj$errorMessage = react::bridging::toJs(rt, value.error_message);
     auto _obj$onionAddressesJson = react::bridging::toJs(rt, value.onion_addresses_json);
 
     obj.setProperty(rt, "is_success", _obj$isSuccess);
     obj.setProperty(rt, "onion_address", _obj$onionAddress);
     obj.setProperty(rt, "control", _obj$control);
+    obj.setProperty(rt, "socks_port", _obj$socksPort);
     obj.setProperty(rt, "error_message", _obj$errorMessage);
     obj.setProperty(rt, "onion_addresses_json", _obj$onionAddressesJson);
 
@@ -402,6 +927,76 @@ struct Bridging<craby::reactnativenitrotor::bridging::StartTorResponse> {
   }
 };
 
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::StreamReadResponse> {
+  static craby::reactnativenitrotor::bridging::StreamReadResponse fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$dataBase64 = obj.getProperty(rt, "data_base64");
+    auto obj$eof = obj.getProperty(rt, "eof");
+    auto obj$error = obj.getProperty(rt, "error");
+
+    auto _obj$dataBase64 = react::bridging::fromJs<rust::String>(rt, obj$dataBase64, callInvoker);
+    auto _obj$eof = react::bridging::fromJs<bool>(rt, obj$eof, callInvoker);
+    auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
+
+    craby::reactnativenitrotor::bridging::StreamReadResponse ret = {
+      _obj$dataBase64,
+      _obj$eof,
+      _obj$error
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::StreamReadResponse value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$dataBase64 = react::bridging::toJs(rt, value.data_base64);
+    auto _obj$eof = react::bridging::toJs(rt, value.eof);
+    auto _obj$error = react::bridging::toJs(rt, value.error);
+
+    obj.setProperty(rt, "data_base64", _obj$dataBase64);
+    obj.setProperty(rt, "eof", _obj$eof);
+    obj.setProperty(rt, "error", _obj$error);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::StreamResponse> {
+  static craby::reactnativenitrotor::bridging::StreamResponse fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$isSuccess = obj.getProperty(rt, "is_success");
+    auto obj$error = obj.getProperty(rt, "error");
+    auto obj$streamId = obj.getProperty(rt, "stream_id");
+
+    auto _obj$isSuccess = react::bridging::fromJs<bool>(rt, obj$isSuccess, callInvoker);
+    auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
+    auto _obj$streamId = react::bridging::fromJs<double>(rt, obj$streamId, callInvoker);
+
+    craby::reactnativenitrotor::bridging::StreamResponse ret = {
+      _obj$isSuccess,
+      _obj$error,
+      _obj$streamId
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::StreamResponse value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$isSuccess = react::bridging::toJs(rt, value.is_success);
+    auto _obj$error = react::bridging::toJs(rt, value.error);
+    auto _obj$streamId = react::bridging::toJs(rt, value.stream_id);
+
+    obj.setProperty(rt, "is_success", _obj$isSuccess);
+    obj.setProperty(rt, "error", _obj$error);
+    obj.setProperty(rt, "stream_id", _obj$streamId);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
 template <>
 struct Bridging<craby::reactnativenitrotor::bridging::TorConfig> {
   static craby::reactnativenitrotor::bridging::TorConfig fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
@@ -409,15 +1004,21 @@ struct Bridging<craby::reactnativenitrotor::bridging::TorConfig> {
     auto obj$socksPort = obj.getProperty(rt, "socks_port");
     auto obj$dataDir = obj.getProperty(rt, "data_dir");
     auto obj$timeoutMs = obj.getProperty(rt, "timeout_ms");
+    auto obj$profile = obj.getProperty(rt, "profile");
+    auto obj$torrcOverridesJson = obj.getProperty(rt, "torrc_overrides_json");
 
     auto _obj$socksPort = react::bridging::fromJs<double>(rt, obj$socksPort, callInvoker);
     auto _obj$dataDir = react::bridging::fromJs<rust::String>(rt, obj$dataDir, callInvoker);
     auto _obj$timeoutMs = react::bridging::fromJs<double>(rt, obj$timeoutMs, callInvoker);
+    auto _obj$profile = react::bridging::fromJs<rust::String>(rt, obj$profile, callInvoker);
+    auto _obj$torrcOverridesJson = react::bridging::fromJs<rust::String>(rt, obj$torrcOverridesJson, callInvoker);
 
     craby::reactnativenitrotor::bridging::TorConfig ret = {
       _obj$socksPort,
       _obj$dataDir,
-      _obj$timeoutMs
+      _obj$timeoutMs,
+      _obj$profile,
+      _obj$torrcOverridesJson
     };
 
     return ret;
@@ -428,10 +1029,149 @@ struct Bridging<craby::reactnativenitrotor::bridging::TorConfig> {
     auto _obj$socksPort = react::bridging::toJs(rt, value.socks_port);
     auto _obj$dataDir = react::bridging::toJs(rt, value.data_dir);
     auto _obj$timeoutMs = react::bridging::toJs(rt, value.timeout_ms);
+    auto _obj$profile = react::bridging::toJs(rt, value.profile);
+    auto _obj$torrcOverridesJson = react::bridging::toJs(rt, value.torrc_overrides_json);
 
     obj.setProperty(rt, "socks_port", _obj$socksPort);
     obj.setProperty(rt, "data_dir", _obj$dataDir);
     obj.setProperty(rt, "timeout_ms", _obj$timeoutMs);
+    obj.setProperty(rt, "profile", _obj$profile);
+    obj.setProperty(rt, "torrc_overrides_json", _obj$torrcOverridesJson);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::TorListeners> {
+  static craby::reactnativenitrotor::bridging::TorListeners fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$socksPort = obj.getProperty(rt, "socks_port");
+    auto obj$socksSocket = obj.getProperty(rt, "socks_socket");
+    auto obj$control = obj.getProperty(rt, "control");
+
+    auto _obj$socksPort = react::bridging::fromJs<double>(rt, obj$socksPort, callInvoker);
+    auto _obj$socksSocket = react::bridging::fromJs<rust::String>(rt, obj$socksSocket, callInvoker);
+    auto _obj$control = react::bridging::fromJs<rust::String>(rt, obj$control, callInvoker);
+
+    craby::reactnativenitrotor::bridging::TorListeners ret = {
+      _obj$socksPort,
+      _obj$socksSocket,
+      _obj$control
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::TorListeners value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$socksPort = react::bridging::toJs(rt, value.socks_port);
+    auto _obj$socksSocket = react::bridging::toJs(rt, value.socks_socket);
+    auto _obj$control = react::bridging::toJs(rt, value.control);
+
+    obj.setProperty(rt, "socks_port", _obj$socksPort);
+    obj.setProperty(rt, "socks_socket", _obj$socksSocket);
+    obj.setProperty(rt, "control", _obj$control);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::WebSocketParams> {
+  static craby::reactnativenitrotor::bridging::WebSocketParams fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$url = obj.getProperty(rt, "url");
+    auto obj$headers = obj.getProperty(rt, "headers");
+    auto obj$protocols = obj.getProperty(rt, "protocols");
+    auto obj$timeoutMs = obj.getProperty(rt, "timeout_ms");
+    auto obj$pingIntervalMs = obj.getProperty(rt, "ping_interval_ms");
+    auto obj$deflate = obj.getProperty(rt, "deflate");
+    auto obj$isolation = obj.getProperty(rt, "isolation");
+
+    auto _obj$url = react::bridging::fromJs<rust::String>(rt, obj$url, callInvoker);
+    auto _obj$headers = react::bridging::fromJs<rust::String>(rt, obj$headers, callInvoker);
+    auto _obj$protocols = react::bridging::fromJs<rust::String>(rt, obj$protocols, callInvoker);
+    auto _obj$timeoutMs = react::bridging::fromJs<double>(rt, obj$timeoutMs, callInvoker);
+    auto _obj$pingIntervalMs = react::bridging::fromJs<double>(rt, obj$pingIntervalMs, callInvoker);
+    auto _obj$deflate = react::bridging::fromJs<bool>(rt, obj$deflate, callInvoker);
+    auto _obj$isolation = react::bridging::fromJs<rust::String>(rt, obj$isolation, callInvoker);
+
+    craby::reactnativenitrotor::bridging::WebSocketParams ret = {
+      _obj$url,
+      _obj$headers,
+      _obj$protocols,
+      _obj$timeoutMs,
+      _obj$pingIntervalMs,
+      _obj$deflate,
+      _obj$isolation
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::WebSocketParams value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$url = react::bridging::toJs(rt, value.url);
+    auto _obj$headers = react::bridging::toJs(rt, value.headers);
+    auto _obj$protocols = react::bridging::toJs(rt, value.protocols);
+    auto _obj$timeoutMs = react::bridging::toJs(rt, value.timeout_ms);
+    auto _obj$pingIntervalMs = react::bridging::toJs(rt, value.ping_interval_ms);
+    auto _obj$deflate = react::bridging::toJs(rt, value.deflate);
+    auto _obj$isolation = react::bridging::toJs(rt, value.isolation);
+
+    obj.setProperty(rt, "url", _obj$url);
+    obj.setProperty(rt, "headers", _obj$headers);
+    obj.setProperty(rt, "protocols", _obj$protocols);
+    obj.setProperty(rt, "timeout_ms", _obj$timeoutMs);
+    obj.setProperty(rt, "ping_interval_ms", _obj$pingIntervalMs);
+    obj.setProperty(rt, "deflate", _obj$deflate);
+    obj.setProperty(rt, "isolation", _obj$isolation);
+
+    return jsi::Value(rt, obj);
+  }
+};
+
+template <>
+struct Bridging<craby::reactnativenitrotor::bridging::WebSocketResponse> {
+  static craby::reactnativenitrotor::bridging::WebSocketResponse fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    auto obj = value.asObject(rt);
+    auto obj$isSuccess = obj.getProperty(rt, "is_success");
+    auto obj$error = obj.getProperty(rt, "error");
+    auto obj$socketId = obj.getProperty(rt, "socket_id");
+    auto obj$protocol = obj.getProperty(rt, "protocol");
+    auto obj$extensions = obj.getProperty(rt, "extensions");
+
+    auto _obj$isSuccess = react::bridging::fromJs<bool>(rt, obj$isSuccess, callInvoker);
+    auto _obj$error = react::bridging::fromJs<rust::String>(rt, obj$error, callInvoker);
+    auto _obj$socketId = react::bridging::fromJs<double>(rt, obj$socketId, callInvoker);
+    auto _obj$protocol = react::bridging::fromJs<rust::String>(rt, obj$protocol, callInvoker);
+    auto _obj$extensions = react::bridging::fromJs<rust::String>(rt, obj$extensions, callInvoker);
+
+    craby::reactnativenitrotor::bridging::WebSocketResponse ret = {
+      _obj$isSuccess,
+      _obj$error,
+      _obj$socketId,
+      _obj$protocol,
+      _obj$extensions
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::reactnativenitrotor::bridging::WebSocketResponse value) {
+    jsi::Object obj = jsi::Object(rt);
+    auto _obj$isSuccess = react::bridging::toJs(rt, value.is_success);
+    auto _obj$error = react::bridging::toJs(rt, value.error);
+    auto _obj$socketId = react::bridging::toJs(rt, value.socket_id);
+    auto _obj$protocol = react::bridging::toJs(rt, value.protocol);
+    auto _obj$extensions = react::bridging::toJs(rt, value.extensions);
+
+    obj.setProperty(rt, "is_success", _obj$isSuccess);
+    obj.setProperty(rt, "error", _obj$error);
+    obj.setProperty(rt, "socket_id", _obj$socketId);
+    obj.setProperty(rt, "protocol", _obj$protocol);
+    obj.setProperty(rt, "extensions", _obj$extensions);
 
     return jsi::Value(rt, obj);
   }
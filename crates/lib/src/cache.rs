@@ -0,0 +1,975 @@
+//! Private HTTP cache for GET responses (RFC 9111 subset).
+//!
+//! Each Tor identity gets its own directory so cached entries can never be
+//! used to correlate traffic between identities. A directory holds a fixed
+//! size, memory-mapped index used for lookups and LRU bookkeeping, plus one
+//! file per entry holding its metadata and body.
+
+use std::{
+    collections::HashMap,
+    fs::{self, File, OpenOptions},
+    io,
+    path::{Path, PathBuf},
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        Mutex,
+    },
+    time::{SystemTime, UNIX_EPOCH},
+};
+
+use logger::log::debug;
+use memmap2::MmapMut;
+use once_cell::sync::OnceCell;
+use serde::{Deserialize, Serialize};
+use sha2::{Digest, Sha256};
+
+use crate::datetime::{self, now_secs};
+use crate::http::{Method, Request, Response};
+
+/// Upper bound on the bytes kept per identity before LRU eviction.
+pub const DEFAULT_MAX_BYTES: u64 = 32 * 1024 * 1024;
+
+const INDEX_MAGIC: &[u8; 4] = b"RNTC";
+const INDEX_VERSION: u32 = 2;
+const INDEX_HEADER_LEN: usize = 16;
+const SLOT_LEN: usize = 32;
+const SLOT_COUNT: usize = 4096;
+const KEY_LEN: usize = 16;
+
+const EMPTY_KEY: [u8; KEY_LEN] = [0x00; KEY_LEN];
+const TOMBSTONE_KEY: [u8; KEY_LEN] = [0xFF; KEY_LEN];
+
+/// Heuristic freshness is capped like most browser caches do.
+const MAX_HEURISTIC_SECS: u64 = 24 * 60 * 60;
+
+static CACHES: OnceCell<Mutex<HashMap<PathBuf, Cache>>> = OnceCell::new();
+/// Keeps the names of files being written unique across threads.
+static NEXT_TMP: AtomicU64 = AtomicU64::new(0);
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum CacheStatus {
+    /// Served from the cache without touching the network.
+    Hit,
+    /// Stale entry confirmed by a 304 from the origin.
+    Revalidated,
+    /// Fetched from the network (and stored if cacheable).
+    Miss,
+}
+
+impl CacheStatus {
+    pub fn as_str(&self) -> &'static str {
+        match self {
+            CacheStatus::Hit => "hit",
+            CacheStatus::Revalidated => "revalidated",
+            CacheStatus::Miss => "miss",
+        }
+    }
+}
+
+/// Directory for the cache belonging to one Tor identity.
+pub fn identity_dir(root: &Path, identity: &str) -> PathBuf {
+    let digest = Sha256::digest(identity.as_bytes());
+    root.join(hex::encode(&digest[..16]))
+}
+
+/// Runs a GET through the cache in `dir`, using `fetch` for network access.
+pub fn fetch_cached<F>(
+    dir: &Path,
+    request: &Request,
+    fetch: F,
+) -> io::Result<(Response, CacheStatus)>
+where
+    F: FnOnce(&Request) -> io::Result<Response>,
+{
+    if request.method != Method::GET || has_directive(&request.headers, "no-store") {
+        return fetch(request).map(|response| (response, CacheStatus::Miss));
+    }
+
+    let key = cache_key(&request.url);
+    let cached = load(dir, &key, request)?;
+    let now = now_secs();
+
+    let mut conditional = request.clone();
+    if let Some((meta, body)) = &cached {
+        let client_no_cache = has_directive(&request.headers, "no-cache")
+            || directive_value(&request.headers, "max-age") == Some(0);
+
+        if !client_no_cache && meta.is_fresh(now) {
+            debug!("http cache hit: {}", request.url);
+            with_cache(dir, |cache| {
+                cache.touch(&key);
+                Ok(())
+            })?;
+            return Ok((meta.to_response(body.clone()), CacheStatus::Hit));
+        }
+
+        if let Some(etag) = header(&meta.headers, "etag") {
+            conditional
+                .headers
+                .push(("If-None-Match".to_string(), etag.to_string()));
+        }
+        if let Some(last_modified) = header(&meta.headers, "last-modified") {
+            conditional
+                .headers
+                .push(("If-Modified-Since".to_string(), last_modified.to_string()));
+        }
+    }
+
+    let request_time = now_secs();
+    let response = fetch(&conditional)?;
+    let response_time = now_secs();
+
+    if response.status_code == 304 {
+        if let Some((mut meta, body)) = cached {
+            debug!("http cache revalidated: {}", request.url);
+            meta.freshen(&response.headers, request_time, response_time);
+            refresh(dir, &key, &meta, &body)?;
+            return Ok((meta.to_response(body), CacheStatus::Revalidated));
+        }
+        return Ok((response, CacheStatus::Miss));
+    }
+
+    if is_storable(&response) {
+        let meta = EntryMeta::new(request, &response, request_time, response_time);
+        if let Err(e) = store(dir, &key, &meta, &response.body) {
+            debug!("http cache store failed: {:?}", e);
+        }
+    }
+
+    Ok((response, CacheStatus::Miss))
+}
+
+/// Removes every cached entry for every identity under `root`.
+pub fn clear(root: &Path) -> io::Result<()> {
+    let mut caches = caches().lock().unwrap();
+    caches.retain(|dir, _| !dir.starts_with(root));
+
+    match fs::remove_dir_all(root) {
+        Err(e) if e.kind() != io::ErrorKind::NotFound => Err(e),
+        _ => Ok(()),
+    }
+}
+
+fn caches() -> &'static Mutex<HashMap<PathBuf, Cache>> {
+    CACHES.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+/// Runs `f` on the index of the cache in `dir`, opening it on first use.
+///
+/// Every identity shares the lock, so `f` only looks up and updates the
+/// index; entry files are read and written outside of it.
+fn with_cache<T>(dir: &Path, f: impl FnOnce(&mut Cache) -> io::Result<T>) -> io::Result<T> {
+    let mut caches = caches().lock().unwrap();
+
+    if !caches.contains_key(dir) {
+        let cache = Cache::open(dir, DEFAULT_MAX_BYTES)?;
+        caches.insert(dir.to_path_buf(), cache);
+    }
+
+    f(caches.get_mut(dir).unwrap())
+}
+
+/// Reads the entry for `key` if it was stored for `request`.
+fn load(
+    dir: &Path,
+    key: &[u8; KEY_LEN],
+    request: &Request,
+) -> io::Result<Option<(EntryMeta, Vec<u8>)>> {
+    if !with_cache(dir, |cache| Ok(cache.find(key).is_some()))? {
+        return Ok(None);
+    }
+
+    // Metadata and body share one file that stores rename into place, so a
+    // read sees either the old entry or the new one, never half of each.
+    match read_entry(dir, key) {
+        Some((meta, body)) if meta.url == request.url && meta.matches_vary(request) => {
+            Ok(Some((meta, body)))
+        }
+        Some((meta, _)) if meta.url == request.url => Ok(None),
+        _ => {
+            // Index and file disagree, drop the slot. Stores move files in
+            // while holding the lock, so reading again under it can not drop
+            // an entry that was stored after the first read.
+            let removed = with_cache(dir, |cache| {
+                let broken = read_entry(dir, key).is_none_or(|(meta, _)| meta.url != request.url);
+                Ok(cache
+                    .find(key)
+                    .filter(|_| broken)
+                    .map(|slot| cache.remove(slot)))
+            })?;
+            remove_files(dir, removed.as_slice());
+            Ok(None)
+        }
+    }
+}
+
+/// Writes the file of an entry under a temporary name, then moves it into
+/// place while adding the entry to the index.
+fn store(dir: &Path, key: &[u8; KEY_LEN], meta: &EntryMeta, body: &[u8]) -> io::Result<()> {
+    let bytes = encode_entry(meta, body)?;
+    let size = bytes.len() as u64;
+    if size > with_cache(dir, |cache| Ok(cache.max_bytes))? {
+        return Ok(());
+    }
+
+    let tmp = write_tmp(&entry_path(dir, key), &bytes)?;
+    let mut evicted = Vec::new();
+    let result = with_cache(dir, |cache| cache.insert(key, size, &tmp, &mut evicted));
+    if result.is_err() {
+        let _ = fs::remove_file(&tmp);
+    }
+    remove_files(dir, &evicted);
+    result
+}
+
+/// Rewrites the entry for `key` with new metadata, if it is still cached.
+fn refresh(dir: &Path, key: &[u8; KEY_LEN], meta: &EntryMeta, body: &[u8]) -> io::Result<()> {
+    let tmp = write_tmp(&entry_path(dir, key), &encode_entry(meta, body)?)?;
+
+    let result = with_cache(dir, |cache| cache.replace(key, &tmp));
+    if !matches!(result, Ok(true)) {
+        let _ = fs::remove_file(&tmp);
+    }
+    result.map(|_| ())
+}
+
+fn read_entry(dir: &Path, key: &[u8; KEY_LEN]) -> Option<(EntryMeta, Vec<u8>)> {
+    decode_entry(fs::read(entry_path(dir, key)).ok()?)
+}
+
+/// Lays out an entry file: the length of the metadata JSON as a little
+/// endian u32, the JSON, then the body.
+fn encode_entry(meta: &EntryMeta, body: &[u8]) -> io::Result<Vec<u8>> {
+    let meta = serde_json::to_vec(meta).map_err(io::Error::other)?;
+    let mut bytes = Vec::with_capacity(4 + meta.len() + body.len());
+    bytes.extend_from_slice(&(meta.len() as u32).to_le_bytes());
+    bytes.extend_from_slice(&meta);
+    bytes.extend_from_slice(body);
+    Ok(bytes)
+}
+
+fn decode_entry(mut bytes: Vec<u8>) -> Option<(EntryMeta, Vec<u8>)> {
+    let meta_end = 4usize.checked_add(read_u32(bytes.get(..4)?, 0) as usize)?;
+    let meta = serde_json::from_slice(bytes.get(4..meta_end)?).ok()?;
+    let body = bytes.split_off(meta_end);
+    Some((meta, body))
+}
+
+fn cache_key(url: &str) -> [u8; KEY_LEN] {
+    let digest = Sha256::digest(url.as_bytes());
+    let mut key = [0u8; KEY_LEN];
+    key.copy_from_slice(&digest[..KEY_LEN]);
+
+    // Reserved slot markers can not be used as keys.
+    if key == EMPTY_KEY || key == TOMBSTONE_KEY {
+        key[0] ^= 0x01;
+    }
+    key
+}
+
+struct Cache {
+    dir: PathBuf,
+    index: MmapMut,
+    total_bytes: u64,
+    max_bytes: u64,
+}
+
+impl Cache {
+    fn open(dir: &Path, max_bytes: u64) -> io::Result<Cache> {
+        fs::create_dir_all(dir.join("entries"))?;
+
+        let index_len = (INDEX_HEADER_LEN + SLOT_LEN * SLOT_COUNT) as u64;
+        let file = OpenOptions::new()
+            .read(true)
+            .write(true)
+            .create(true)
+            .truncate(false)
+            .open(dir.join("index"))?;
+
+        let fresh = file.metadata()?.len() != index_len;
+        if fresh {
+            file.set_len(0)?;
+            file.set_len(index_len)?;
+        }
+
+        let mut index = unsafe { MmapMut::map_mut(&file)? };
+
+        let valid = &index[..4] == INDEX_MAGIC && read_u32(&index, 4) == INDEX_VERSION;
+        if fresh || !valid {
+            // Unknown layout: start over rather than trusting stale files.
+            index.fill(0);
+            index[..4].copy_from_slice(INDEX_MAGIC);
+            index[4..8].copy_from_slice(&INDEX_VERSION.to_le_bytes());
+            index[8..12].copy_from_slice(&(SLOT_COUNT as u32).to_le_bytes());
+            let _ = fs::remove_dir_all(dir.join("entries"));
+            fs::create_dir_all(dir.join("entries"))?;
+        }
+
+        let mut cache = Cache {
+            dir: dir.to_path_buf(),
+            index,
+            total_bytes: 0,
+            max_bytes,
+        };
+        cache.total_bytes = (0..SLOT_COUNT)
+            .filter(|&slot| cache.is_live(slot))
+            .map(|slot| cache.slot_size(slot))
+            .sum();
+
+        Ok(cache)
+    }
+
+    /// Adds `key`, whose file is at `tmp`, making room by evicting the least
+    /// recently used entries. The keys it evicts are added to `evicted`;
+    /// their files are left for the caller to remove.
+    fn insert(
+        &mut self,
+        key: &[u8; KEY_LEN],
+        size: u64,
+        tmp: &Path,
+        evicted: &mut Vec<[u8; KEY_LEN]>,
+    ) -> io::Result<()> {
+        // The file of an older entry for `key` is replaced below.
+        if let Some(slot) = self.find(key) {
+            self.remove(slot);
+        }
+        while self.total_bytes + size > self.max_bytes {
+            match self.evict_lru() {
+                Some(key) => evicted.push(key),
+                None => break,
+            }
+        }
+
+        let slot = match self.free_slot(key) {
+            Some(slot) => slot,
+            None => {
+                evicted.extend(self.evict_lru());
+                self.free_slot(key)
+                    .ok_or_else(|| io::Error::other("HTTP cache index is full"))?
+            }
+        };
+
+        fs::rename(tmp, entry_path(&self.dir, key))?;
+
+        self.set_slot(slot, key, now_millis(), size);
+        self.total_bytes += size;
+        self.index.flush_async()?;
+        Ok(())
+    }
+
+    /// Moves `tmp` into place as the file of `key`. Returns false when `key`
+    /// is no longer cached.
+    fn replace(&mut self, key: &[u8; KEY_LEN], tmp: &Path) -> io::Result<bool> {
+        let Some(slot) = self.find(key) else {
+            return Ok(false);
+        };
+
+        fs::rename(tmp, entry_path(&self.dir, key))?;
+        self.write_u64(slot, 16, now_millis());
+        Ok(true)
+    }
+
+    fn touch(&mut self, key: &[u8; KEY_LEN]) {
+        if let Some(slot) = self.find(key) {
+            self.write_u64(slot, 16, now_millis());
+        }
+    }
+
+    /// Drops the least recently used entry and returns its key.
+    fn evict_lru(&mut self) -> Option<[u8; KEY_LEN]> {
+        let oldest = (0..SLOT_COUNT)
+            .filter(|&slot| self.is_live(slot))
+            .min_by_key(|&slot| self.read_u64(slot, 16))?;
+        Some(self.remove(oldest))
+    }
+
+    /// Frees `slot` and returns the key it held, whose files are now unused.
+    fn remove(&mut self, slot: usize) -> [u8; KEY_LEN] {
+        let key = self.slot_key(slot);
+        self.total_bytes = self.total_bytes.saturating_sub(self.slot_size(slot));
+        self.set_slot(slot, &TOMBSTONE_KEY, 0, 0);
+        key
+    }
+
+    /// Linear probe for `key`, stopping at the first never-used slot.
+    fn find(&self, key: &[u8; KEY_LEN]) -> Option<usize> {
+        let start = probe_start(key);
+        for i in 0..SLOT_COUNT {
+            let slot = (start + i) % SLOT_COUNT;
+            let slot_key = self.slot_key(slot);
+            if slot_key == EMPTY_KEY {
+                return None;
+            }
+            if &slot_key == key {
+                return Some(slot);
+            }
+        }
+        None
+    }
+
+    fn free_slot(&self, key: &[u8; KEY_LEN]) -> Option<usize> {
+        let start = probe_start(key);
+        (0..SLOT_COUNT)
+            .map(|i| (start + i) % SLOT_COUNT)
+            .find(|&slot| !self.is_live(slot))
+    }
+
+    fn is_live(&self, slot: usize) -> bool {
+        let key = self.slot_key(slot);
+        key != EMPTY_KEY && key != TOMBSTONE_KEY
+    }
+
+    fn slot_offset(slot: usize) -> usize {
+        INDEX_HEADER_LEN + slot * SLOT_LEN
+    }
+
+    fn slot_key(&self, slot: usize) -> [u8; KEY_LEN] {
+        let offset = Self::slot_offset(slot);
+        let mut key = [0u8; KEY_LEN];
+        key.copy_from_slice(&self.index[offset..offset + KEY_LEN]);
+        key
+    }
+
+    fn slot_size(&self, slot: usize) -> u64 {
+        self.read_u64(slot, 24)
+    }
+
+    fn set_slot(&mut self, slot: usize, key: &[u8; KEY_LEN], last_used: u64, size: u64) {
+        let offset = Self::slot_offset(slot);
+        self.index[offset..offset + KEY_LEN].copy_from_slice(key);
+        self.write_u64(slot, 16, last_used);
+        self.write_u64(slot, 24, size);
+    }
+
+    fn read_u64(&self, slot: usize, field: usize) -> u64 {
+        let offset = Self::slot_offset(slot) + field;
+        u64::from_le_bytes(self.index[offset..offset + 8].try_into().unwrap())
+    }
+
+    fn write_u64(&mut self, slot: usize, field: usize, value: u64) {
+        let offset = Self::slot_offset(slot) + field;
+        self.index[offset..offset + 8].copy_from_slice(&value.to_le_bytes());
+    }
+}
+
+fn entry_path(dir: &Path, key: &[u8; KEY_LEN]) -> PathBuf {
+    dir.join("entries")
+        .join(format!("{}.entry", hex::encode(key)))
+}
+
+fn remove_files(dir: &Path, keys: &[[u8; KEY_LEN]]) {
+    for key in keys {
+        let _ = fs::remove_file(entry_path(dir, key));
+    }
+}
+
+fn probe_start(key: &[u8; KEY_LEN]) -> usize {
+    u32::from_le_bytes([key[0], key[1], key[2], key[3]]) as usize % SLOT_COUNT
+}
+
+fn read_u32(bytes: &[u8], offset: usize) -> u32 {
+    u32::from_le_bytes(bytes[offset..offset + 4].try_into().unwrap())
+}
+
+/// Writes `bytes` durably next to `path` under a unique temporary name,
+/// which is returned for renaming into place.
+fn write_tmp(path: &Path, bytes: &[u8]) -> io::Result<PathBuf> {
+    let tmp = path.with_extension(format!("{}.tmp", NEXT_TMP.fetch_add(1, Ordering::Relaxed)));
+    fs::write(&tmp, bytes)?;
+    if let Err(e) = File::open(&tmp).and_then(|file| file.sync_data()) {
+        let _ = fs::remove_file(&tmp);
+        return Err(e);
+    }
+    Ok(tmp)
+}
+
+#[derive(Serialize, Deserialize)]
+struct EntryMeta {
+    url: String,
+    status_code: u16,
+    headers: Vec<(String, String)>,
+    /// Request header values selected by the response's `Vary`.
+    vary: Vec<(String, Option<String>)>,
+    request_time: u64,
+    response_time: u64,
+}
+
+impl EntryMeta {
+    fn new(
+        request: &Request,
+        response: &Response,
+        request_time: u64,
+        response_time: u64,
+    ) -> EntryMeta {
+        let vary = header(&response.headers, "vary")
+            .map(|vary| {
+                vary.split(',')
+                    .map(|name| name.trim().to_ascii_lowercase())
+                    .filter(|name| !name.is_empty())
+                    .map(|name| {
+                        let value = header(&request.headers, &name).map(str::to_string);
+                        (name, value)
+                    })
+                    .collect()
+            })
+            .unwrap_or_default();
+
+        EntryMeta {
+            url: request.url.clone(),
+            status_code: response.status_code,
+            headers: response.headers.clone(),
+            vary,
+            request_time,
+            response_time,
+        }
+    }
+
+    fn matches_vary(&self, request: &Request) -> bool {
+        self.vary
+            .iter()
+            .all(|(name, value)| header(&request.headers, name) == value.as_deref())
+    }
+
+    /// Applies the headers of a 304 to the stored response (RFC 9111 §4.3.4).
+    fn freshen(&mut self, headers: &[(String, String)], request_time: u64, response_time: u64) {
+        for (name, value) in headers {
+            if name.eq_ignore_ascii_case("content-length") {
+                continue;
+            }
+            match self
+                .headers
+                .iter_mut()
+                .find(|(key, _)| key.eq_ignore_ascii_case(name))
+            {
+                Some((_, stored)) => *stored = value.clone(),
+                None => self.headers.push((name.clone(), value.clone())),
+            }
+        }
+        self.request_time = request_time;
+        self.response_time = response_time;
+    }
+
+    fn freshness_lifetime(&self) -> u64 {
+        if let Some(max_age) = directive_value(&self.headers, "max-age") {
+            return max_age;
+        }
+
+        let date = header(&self.headers, "date")
+            .and_then(parse_http_date)
+            .unwrap_or(self.response_time);
+
+        if let Some(expires) = header(&self.headers, "expires") {
+            // Invalid dates such as "0" mean already expired.
+            return parse_http_date(expires)
+                .map(|e| e.saturating_sub(date))
+                .unwrap_or(0);
+        }
+
+        if let Some(last_modified) =
+            header(&self.headers, "last-modified").and_then(parse_http_date)
+        {
+            return (date.saturating_sub(last_modified) / 10).min(MAX_HEURISTIC_SECS);
+        }
+
+        0
+    }
+
+    fn current_age(&self, now: u64) -> u64 {
+        let age_value = header(&self.headers, "age")
+            .and_then(|age| age.trim().parse::<u64>().ok())
+            .unwrap_or(0);
+        let date = header(&self.headers, "date")
+            .and_then(parse_http_date)
+            .unwrap_or(self.response_time);
+
+        let apparent_age = self.response_time.saturating_sub(date);
+        let response_delay = self.response_time.saturating_sub(self.request_time);
+        let corrected_initial_age = apparent_age.max(age_value + response_delay);
+
+        corrected_initial_age + now.saturating_sub(self.response_time)
+    }
+
+    fn is_fresh(&self, now: u64) -> bool {
+        !has_directive(&self.headers, "no-cache")
+            && self.current_age(now) < self.freshness_lifetime()
+    }
+
+    fn to_response(&self, body: Vec<u8>) -> Response {
+        Response {
+            status_code: self.status_code,
+            headers: self.headers.clone(),
+            body,
+            wire_bytes: 0,
+        }
+    }
+}
+
+fn is_storable(response: &Response) -> bool {
+    if !matches!(response.status_code, 200 | 203 | 300 | 301 | 404 | 410) {
+        return false;
+    }
+    if has_directive(&response.headers, "no-store") {
+        return false;
+    }
+    if header(&response.headers, "vary")
+        .map(|vary| vary.trim() == "*")
+        .unwrap_or(false)
+    {
+        return false;
+    }
+
+    // Only keep responses that can either be reused or revalidated.
+    directive_value(&response.headers, "max-age").is_some()
+        || header(&response.headers, "expires").is_some()
+        || header(&response.headers, "etag").is_some()
+        || header(&response.headers, "last-modified").is_some()
+}
+
+fn header<'a>(headers: &'a [(String, String)], name: &str) -> Option<&'a str> {
+    headers
+        .iter()
+        .find(|(key, _)| key.eq_ignore_ascii_case(name))
+        .map(|(_, value)| value.as_str())
+}
+
+fn cache_directives(
+    headers: &[(String, String)],
+) -> impl Iterator<Item = (String, Option<String>)> + '_ {
+    headers
+        .iter()
+        .filter(|(key, _)| key.eq_ignore_ascii_case("cache-control"))
+        .flat_map(|(_, value)| value.split(','))
+        .map(|directive| match directive.split_once('=') {
+            Some((name, value)) => (
+                name.trim().to_ascii_lowercase(),
+                Some(value.trim().trim_matches('"').to_string()),
+            ),
+            None => (directive.trim().to_ascii_lowercase(), None),
+        })
+}
+
+fn has_directive(headers: &[(String, String)], name: &str) -> bool {
+    cache_directives(headers).any(|(directive, _)| directive == name)
+}
+
+fn directive_value(headers: &[(String, String)], name: &str) -> Option<u64> {
+    cache_directives(headers)
+        .find(|(directive, _)| directive == name)
+        .and_then(|(_, value)| value)
+        .and_then(|value| value.parse::<u64>().ok())
+}
+
+/// Parses an IMF-fixdate (`Sun, 06 Nov 1994 08:49:37 GMT`) into Unix seconds.
+fn parse_http_date(value: &str) -> Option<u64> {
+    let parts: Vec<&str> = value.split_whitespace().collect();
+    if parts.len() != 6 || parts[5] != "GMT" {
+        return None;
+    }
+
+    let day: u64 = parts[1].parse().ok()?;
+    let month = [
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec",
+    ]
+    .iter()
+    .position(|m| *m == parts[2])? as u64
+        + 1;
+    let year: i64 = parts[3].parse().ok()?;
+
+    let time: Vec<u64> = parts[4].split(':').filter_map(|t| t.parse().ok()).collect();
+    if time.len() != 3 {
+        return None;
+    }
+
+    datetime::unix_time(year, month, day, time[0], time[1], time[2])
+}
+
+fn now_millis() -> u64 {
+    SystemTime::now()
+        .duration_since(UNIX_EPOCH)
+        .map(|d| d.as_millis() as u64)
+        .unwrap_or(0)
+}
+
+#[cfg(test)]
+mod tests {
+    use std::time::Duration;
+
+    use super::*;
+
+    /// `Sun, 06 Nov 1994 08:49:37 GMT`.
+    const DATE: u64 = 784_111_777;
+
+    fn entry(headers: &[(&str, &str)], response_time: u64) -> EntryMeta {
+        EntryMeta {
+            url: "http://example.com/".to_string(),
+            status_code: 200,
+            headers: headers
+                .iter()
+                .map(|(name, value)| (name.to_string(), value.to_string()))
+                .collect(),
+            vary: Vec::new(),
+            request_time: response_time,
+            response_time,
+        }
+    }
+
+    fn request(url: &str, headers: &[(&str, &str)]) -> Request {
+        Request {
+            url: url.to_string(),
+            method: Method::GET,
+            headers: headers
+                .iter()
+                .map(|(name, value)| (name.to_string(), value.to_string()))
+                .collect(),
+            body: None,
+            timeout: Duration::from_secs(1),
+            accept_encoding: String::new(),
+            socks_auth: None,
+        }
+    }
+
+    fn response(headers: &[(&str, &str)], body: &[u8]) -> Response {
+        Response {
+            status_code: 200,
+            headers: headers
+                .iter()
+                .map(|(name, value)| (name.to_string(), value.to_string()))
+                .collect(),
+            body: body.to_vec(),
+            wire_bytes: body.len() as u64,
+        }
+    }
+
+    #[test]
+    fn parses_imf_fixdate() {
+        assert_eq!(parse_http_date("Sun, 06 Nov 1994 08:49:37 GMT"), Some(DATE));
+        assert_eq!(parse_http_date("Thu, 01 Jan 1970 00:00:00 GMT"), Some(0));
+        assert_eq!(
+            parse_http_date("Thu, 29 Feb 2024 23:59:59 GMT"),
+            Some(1_709_251_199)
+        );
+        assert_eq!(
+            parse_http_date("  Sun,  06 Nov 1994 08:49:37  GMT "),
+            Some(DATE)
+        );
+    }
+
+    #[test]
+    fn rejects_malformed_dates() {
+        for value in [
+            "",
+            "0",
+            "-1",
+            "Sun, 06 Nov 1994 08:49:37",
+            "Sun, 06 Nov 1994 08:49:37 UTC",
+            "Sunday, 06-Nov-94 08:49:37 GMT",
+            "Sun Nov  6 08:49:37 1994",
+            "Sun, 06 Foo 1994 08:49:37 GMT",
+            "Sun, 00 Nov 1994 08:49:37 GMT",
+            "Sun, 32 Nov 1994 08:49:37 GMT",
+            "Sun, 06 Nov 1994 24:00:00 GMT",
+            "Sun, 06 Nov 1994 08:60:00 GMT",
+            "Sun, 06 Nov 1994 08:49 GMT",
+            "Sun, 06 Nov 1994 08:49:xx GMT",
+            "Wed, 31 Dec 1969 23:59:59 GMT",
+        ] {
+            assert_eq!(parse_http_date(value), None, "{:?}", value);
+        }
+    }
+
+    #[test]
+    fn max_age_takes_precedence_over_expires() {
+        let meta = entry(
+            &[
+                ("Cache-Control", "public, max-age=60"),
+                ("Date", "Sun, 06 Nov 1994 08:49:37 GMT"),
+                ("Expires", "Sun, 06 Nov 1994 09:49:37 GMT"),
+            ],
+            DATE,
+        );
+        assert_eq!(meta.freshness_lifetime(), 60);
+        assert!(meta.is_fresh(DATE + 59));
+        assert!(!meta.is_fresh(DATE + 60));
+    }
+
+    #[test]
+    fn expires_is_relative_to_date() {
+        let meta = entry(
+            &[
+                ("Date", "Sun, 06 Nov 1994 08:49:37 GMT"),
+                ("Expires", "Sun, 06 Nov 1994 08:59:37 GMT"),
+            ],
+            DATE + 1000,
+        );
+        assert_eq!(meta.freshness_lifetime(), 600);
+
+        // Invalid dates and dates in the past mean already expired.
+        assert_eq!(entry(&[("Expires", "0")], DATE).freshness_lifetime(), 0);
+        let expired = entry(
+            &[
+                ("Date", "Sun, 06 Nov 1994 08:49:37 GMT"),
+                ("Expires", "Sat, 05 Nov 1994 08:49:37 GMT"),
+            ],
+            DATE,
+        );
+        assert_eq!(expired.freshness_lifetime(), 0);
+        assert!(!expired.is_fresh(DATE));
+    }
+
+    #[test]
+    fn heuristic_freshness_is_a_capped_fraction_of_age() {
+        let recent = entry(
+            &[
+                ("Date", "Sun, 06 Nov 1994 08:49:37 GMT"),
+                ("Last-Modified", "Sun, 06 Nov 1994 07:49:37 GMT"),
+            ],
+            DATE,
+        );
+        assert_eq!(recent.freshness_lifetime(), 360);
+
+        let old = entry(
+            &[
+                ("Date", "Sun, 06 Nov 1994 08:49:37 GMT"),
+                ("Last-Modified", "Thu, 01 Jan 1970 00:00:00 GMT"),
+            ],
+            DATE,
+        );
+        assert_eq!(old.freshness_lifetime(), MAX_HEURISTIC_SECS);
+        assert_eq!(entry(&[], DATE).freshness_lifetime(), 0);
+    }
+
+    #[test]
+    fn age_counts_against_freshness() {
+        let meta = entry(&[("Cache-Control", "max-age=100"), ("Age", "90")], DATE);
+        assert_eq!(meta.current_age(DATE), 90);
+        assert!(meta.is_fresh(DATE + 9));
+        assert!(!meta.is_fresh(DATE + 10));
+
+        // A Date behind the response time is apparent age.
+        let late = entry(
+            &[
+                ("Cache-Control", "max-age=100"),
+                ("Date", "Sun, 06 Nov 1994 08:48:37 GMT"),
+            ],
+            DATE,
+        );
+        assert_eq!(late.current_age(DATE), 60);
+    }
+
+    #[test]
+    fn no_cache_is_never_fresh() {
+        let meta = entry(&[("Cache-Control", "max-age=100, no-cache")], DATE);
+        assert!(!meta.is_fresh(DATE));
+    }
+
+    #[test]
+    fn freshen_keeps_stored_body_headers() {
+        let mut meta = entry(
+            &[
+                ("Content-Length", "3"),
+                ("ETag", "\"a\""),
+                ("Cache-Control", "max-age=1"),
+            ],
+            DATE,
+        );
+        let update = [
+            ("content-length".to_string(), "0".to_string()),
+            ("cache-control".to_string(), "max-age=100".to_string()),
+        ];
+        meta.freshen(&update, DATE + 5, DATE + 6);
+        assert_eq!(header(&meta.headers, "content-length"), Some("3"));
+        assert_eq!(header(&meta.headers, "cache-control"), Some("max-age=100"));
+        assert_eq!(header(&meta.headers, "etag"), Some("\"a\""));
+        assert_eq!(
+            (meta.request_time, meta.response_time),
+            (DATE + 5, DATE + 6)
+        );
+    }
+
+    #[test]
+    fn stores_only_reusable_responses() {
+        assert!(is_storable(&response(
+            &[("Cache-Control", "max-age=10")],
+            b""
+        )));
+        assert!(is_storable(&response(&[("ETag", "\"a\"")], b"")));
+        assert!(!is_storable(&response(&[], b"")));
+        assert!(!is_storable(&response(
+            &[("Cache-Control", "max-age=10, no-store")],
+            b""
+        )));
+        assert!(!is_storable(&response(
+            &[("Cache-Control", "max-age=10"), ("Vary", "*")],
+            b""
+        )));
+        let mut created = response(&[("Cache-Control", "max-age=10")], b"");
+        created.status_code = 201;
+        assert!(!is_storable(&created));
+    }
+
+    #[test]
+    fn entry_files_hold_metadata_and_body() {
+        let meta = entry(&[("Cache-Control", "max-age=100")], DATE);
+        let bytes = encode_entry(&meta, b"hello").unwrap();
+
+        let (decoded, body) = decode_entry(bytes.clone()).unwrap();
+        assert_eq!(decoded.url, meta.url);
+        assert_eq!(decoded.headers, meta.headers);
+        assert_eq!(body, b"hello");
+
+        assert!(decode_entry(bytes[..10].to_vec()).is_none());
+        assert!(decode_entry(vec![0xff, 0xff, 0xff, 0xff]).is_none());
+        assert!(decode_entry(Vec::new()).is_none());
+    }
+
+    #[test]
+    fn replaced_entries_are_read_whole() {
+        let root = std::env::temp_dir().join(format!("rntc-replace-{}", std::process::id()));
+        let dir = identity_dir(&root, "replace");
+        let request = request("http://example.com/replace", &[]);
+        let headers = [("Cache-Control", "max-age=100")];
+
+        let key = cache_key(&request.url);
+
+        for body in [&b"first"[..], b"second, and longer"] {
+            let meta = EntryMeta::new(&request, &response(&headers, body), DATE, DATE);
+            store(&dir, &key, &meta, body).unwrap();
+            let (_, loaded) = load(&dir, &key, &request).unwrap().unwrap();
+            assert_eq!(loaded, body);
+        }
+
+        // An entry whose file went missing is dropped from the index.
+        remove_files(&dir, &[key]);
+        assert!(load(&dir, &key, &request).unwrap().is_none());
+        assert!(!with_cache(&dir, |cache| Ok(cache.find(&key).is_some())).unwrap());
+
+        clear(&root).unwrap();
+    }
+
+    #[test]
+    fn round_trips_entries_by_vary() {
+        let root = std::env::temp_dir().join(format!("rntc-test-{}", std::process::id()));
+        let dir = identity_dir(&root, "vary");
+        let url = "http://example.com/vary";
+        let stored = request(url, &[("Accept-Language", "en")]);
+        let headers = [
+            ("Cache-Control", "max-age=100"),
+            ("Vary", "Accept-Language"),
+        ];
+
+        let (_, status) =
+            fetch_cached(&dir, &stored, |_| Ok(response(&headers, b"hello"))).unwrap();
+        assert_eq!(status, CacheStatus::Miss);
+
+        let (hit, status) = fetch_cached(&dir, &stored, |_| panic!("not cached")).unwrap();
+        assert_eq!(status, CacheStatus::Hit);
+        assert_eq!(hit.body, b"hello");
+
+        let other = request(url, &[("Accept-Language", "de")]);
+        let (_, status) = fetch_cached(&dir, &other, |_| Ok(response(&[], b"hallo"))).unwrap();
+        assert_eq!(status, CacheStatus::Miss);
+
+        clear(&root).unwrap();
+        assert!(!root.exists());
+    }
+}
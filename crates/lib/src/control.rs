@@ -0,0 +1,350 @@
+use std::{
+    fs,
+    io::{self, BufRead, BufReader, Write},
+    net::{SocketAddr, TcpStream},
+    sync::Mutex,
+    time::Duration,
+};
+
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+
+const CONTROL_TIMEOUT: Duration = Duration::from_secs(10);
+
+static SHARED: OnceCell<Mutex<Option<(String, Controller)>>> = OnceCell::new();
+
+/// One line of a control port reply (control-spec §2.3).
+#[derive(Debug, Clone)]
+pub struct ReplyLine {
+    pub code: u16,
+    pub text: String,
+    /// Payload of a `+` data line, with dot-stuffing removed.
+    pub data: Option<String>,
+}
+
+/// Minimal client for Tor's control protocol.
+pub struct Controller {
+    reader: BufReader<TcpStream>,
+    writer: TcpStream,
+}
+
+impl Controller {
+    /// Connects to the control port at `addr` and authenticates.
+    ///
+    /// Supports the NULL and COOKIE methods, which cover the configurations
+    /// the embedded Tor runs with; the cookie path comes from PROTOCOLINFO.
+    pub fn connect(addr: &str) -> io::Result<Controller> {
+        let addr: SocketAddr = addr.trim().parse().map_err(|_| {
+            io::Error::new(io::ErrorKind::InvalidInput, "Invalid control port address")
+        })?;
+
+        let stream = TcpStream::connect_timeout(&addr, CONTROL_TIMEOUT)?;
+        stream.set_read_timeout(Some(CONTROL_TIMEOUT))?;
+        stream.set_write_timeout(Some(CONTROL_TIMEOUT))?;
+
+        let mut controller = Controller {
+            reader: BufReader::new(stream.try_clone()?),
+            writer: stream,
+        };
+        controller.authenticate()?;
+        Ok(controller)
+    }
+
+    fn authenticate(&mut self) -> io::Result<()> {
+        let info = self.command("PROTOCOLINFO 1")?;
+
+        let auth_line = info
+            .iter()
+            .find(|line| line.text.starts_with("AUTH "))
+            .map(|line| line.text.clone())
+            .unwrap_or_default();
+
+        let methods: Vec<&str> = auth_line
+            .split_whitespace()
+            .find_map(|field| field.strip_prefix("METHODS="))
+            .map(|methods| methods.split(',').collect())
+            .unwrap_or_default();
+
+        if methods.contains(&"NULL") {
+            self.command("AUTHENTICATE")?;
+            return Ok(());
+        }
+
+        if methods.contains(&"COOKIE") {
+            let cookie_file = quoted_value(&auth_line, "COOKIEFILE=")
+                .ok_or_else(|| io::Error::other("Control port did not report a cookie file"))?;
+            let cookie = fs::read(&cookie_file)?;
+            self.command(&format!("AUTHENTICATE {}", hex::encode(cookie)))?;
+            return Ok(());
+        }
+
+        Err(io::Error::new(
+            io::ErrorKind::PermissionDenied,
+            format!("Unsupported control port authentication: {}", auth_line),
+        ))
+    }
+
+    /// Sends `line` and returns the reply, failing on non-2xx status codes.
+    pub fn command(&mut self, line: &str) -> io::Result<Vec<ReplyLine>> {
+        self.writer.write_all(line.as_bytes())?;
+        self.writer.write_all(b"\r\n")?;
+        self.writer.flush()?;
+
+        let reply = self.read_reply()?;
+        match reply.last() {
+            Some(last) if (200..300).contains(&last.code) => Ok(reply),
+            Some(last) => Err(io::Error::other(format!(
+                "Control command failed: {} {}",
+                last.code, last.text
+            ))),
+            None => Err(io::Error::other("Empty control reply")),
+        }
+    }
+
+    /// Returns the value of a single `GETINFO` key.
+    pub fn get_info(&mut self, key: &str) -> io::Result<String> {
+        let reply = self.command(&format!("GETINFO {}", key))?;
+        let prefix = format!("{}=", key);
+
+        reply
+            .into_iter()
+            .find(|line| line.text.starts_with(&prefix))
+            .map(|line| match line.data {
+                Some(data) => data,
+                None => line.text[prefix.len()..].to_string(),
+            })
+            .ok_or_else(|| io::Error::other(format!("GETINFO {} returned no value", key)))
+    }
+
+    /// Waits for the next asynchronous event enabled with `SETEVENTS`.
+    ///
+    /// Meant for a connection of its own: it blocks until Tor sends one, or
+    /// the read timeout set with [`Controller::set_read_timeout`] expires.
+    pub fn read_event(&mut self) -> io::Result<Vec<ReplyLine>> {
+        let mut lines = Vec::new();
+
+        loop {
+            let (code, separator, text) = self.read_status_line()?;
+            let data = if separator == b'+' {
+                Some(self.read_data()?)
+            } else {
+                None
+            };
+
+            lines.push(ReplyLine { code, text, data });
+            if separator == b' ' {
+                return Ok(lines);
+            }
+        }
+    }
+
+    /// `None` blocks reads until Tor sends something.
+    pub fn set_read_timeout(&self, timeout: Option<Duration>) -> io::Result<()> {
+        self.writer.set_read_timeout(timeout)
+    }
+
+    fn read_reply(&mut self) -> io::Result<Vec<ReplyLine>> {
+        let mut lines = Vec::new();
+
+        loop {
+            let (code, separator, text) = self.read_status_line()?;
+
+            // Events are taken by read_event on connections that enable them.
+            if code == 650 {
+                continue;
+            }
+
+            let data = if separator == b'+' {
+                Some(self.read_data()?)
+            } else {
+                None
+            };
+
+            lines.push(ReplyLine { code, text, data });
+            if separator == b' ' {
+                return Ok(lines);
+            }
+        }
+    }
+
+    /// Splits a reply line into status code, separator and text.
+    fn read_status_line(&mut self) -> io::Result<(u16, u8, String)> {
+        let line = self.read_line()?;
+        if line.len() < 4 {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidData,
+                "Malformed control reply",
+            ));
+        }
+
+        let code: u16 = line[..3].parse().map_err(|_| {
+            io::Error::new(io::ErrorKind::InvalidData, "Malformed control reply code")
+        })?;
+        Ok((code, line.as_bytes()[3], line[4..].to_string()))
+    }
+
+    fn read_data(&mut self) -> io::Result<String> {
+        let mut data = String::new();
+        loop {
+            let line = self.read_line()?;
+            if line == "." {
+                return Ok(data);
+            }
+            if !data.is_empty() {
+                data.push('\n');
+            }
+            data.push_str(line.strip_prefix('.').unwrap_or(&line));
+        }
+    }
+
+    fn read_line(&mut self) -> io::Result<String> {
+        let mut line = String::new();
+        if self.reader.read_line(&mut line)? == 0 {
+            return Err(io::Error::new(
+                io::ErrorKind::UnexpectedEof,
+                "Control connection closed",
+            ));
+        }
+        Ok(line.trim_end_matches(['\r', '\n']).to_string())
+    }
+}
+
+/// Runs `f` on a shared, lazily authenticated connection to `addr`.
+///
+/// The connection is dropped after an I/O error so the next call reconnects.
+pub fn with_controller<T>(
+    addr: &str,
+    f: impl FnOnce(&mut Controller) -> io::Result<T>,
+) -> io::Result<T> {
+    let mut shared = SHARED.get_or_init(|| Mutex::new(None)).lock().unwrap();
+
+    if !matches!(&*shared, Some((connected, _)) if connected == addr) {
+        debug!("Rust FFI: Connecting to control port {}", addr);
+        *shared = Some((addr.to_string(), Controller::connect(addr)?));
+    }
+
+    let (_, controller) = shared.as_mut().unwrap();
+    let result = f(controller);
+    if result.is_err() {
+        *shared = None;
+    }
+    result
+}
+
+/// Closes the shared connection, e.g. when the service shuts down.
+pub fn disconnect() {
+    if let Some(shared) = SHARED.get() {
+        *shared.lock().unwrap() = None;
+    }
+}
+
+/// Extracts a quoted `KEY="value"` field from a reply line, unescaping it.
+///
+/// `key` only matches at the start of a field, so `USERNAME=` is not found
+/// inside `SOCKS_USERNAME=`. Tor escapes bytes outside printable ASCII as
+/// three octal digits, which are turned back into UTF-8.
+pub fn quoted_value(line: &str, key: &str) -> Option<String> {
+    let start = line
+        .match_indices(key)
+        .map(|(index, _)| index)
+        .find(|&index| index == 0 || line[..index].ends_with(' '))?
+        + key.len();
+    let rest = line[start..].strip_prefix('"')?.as_bytes();
+
+    let mut value = Vec::new();
+    let mut i = 0;
+    while i < rest.len() {
+        match rest[i] {
+            b'"' => return Some(String::from_utf8_lossy(&value).into_owned()),
+            b'\\' => {
+                let escaped = *rest.get(i + 1)?;
+                i += 2;
+                match escaped {
+                    b'n' => value.push(b'\n'),
+                    b'r' => value.push(b'\r'),
+                    b't' => value.push(b'\t'),
+                    b'0'..=b'7' => {
+                        // Up to three octal digits make one byte.
+                        let mut code = u16::from(escaped - b'0');
+                        for _ in 0..2 {
+                            match rest.get(i) {
+                                Some(digit @ b'0'..=b'7') => {
+                                    code = code * 8 + u16::from(digit - b'0');
+                                    i += 1;
+                                }
+                                _ => break,
+                            }
+                        }
+                        value.push(u8::try_from(code).ok()?);
+                    }
+                    other => value.push(other),
+                }
+            }
+            byte => {
+                value.push(byte);
+                i += 1;
+            }
+        }
+    }
+    None
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn reads_quoted_fields() {
+        let line = r#"AUTH METHODS=COOKIE,SAFECOOKIE COOKIEFILE="/data/tor/control_auth_cookie""#;
+        assert_eq!(
+            quoted_value(line, "COOKIEFILE=").as_deref(),
+            Some("/data/tor/control_auth_cookie")
+        );
+        assert_eq!(quoted_value(r#"KEY="" X=1"#, "KEY=").as_deref(), Some(""));
+        assert_eq!(
+            quoted_value(r#"A="x" B="y z""#, "B=").as_deref(),
+            Some("y z")
+        );
+    }
+
+    #[test]
+    fn matches_whole_keys_only() {
+        let line = r#"STREAM 1 SUCCEEDED 2 a.onion:80 SOCKS_USERNAME="iso:a" USERNAME="b""#;
+        assert_eq!(quoted_value(line, "USERNAME=").as_deref(), Some("b"));
+        assert_eq!(
+            quoted_value(line, "SOCKS_USERNAME=").as_deref(),
+            Some("iso:a")
+        );
+        assert_eq!(quoted_value(r#"SOCKS_USERNAME="a""#, "USERNAME="), None);
+    }
+
+    #[test]
+    fn unescapes_values() {
+        let line = r#"SUMMARY="say \"hi\"\\now\n\ttab" X="#;
+        assert_eq!(
+            quoted_value(line, "SUMMARY=").as_deref(),
+            Some("say \"hi\"\\now\n\ttab")
+        );
+        // Tor writes non-ASCII bytes as octal escapes.
+        let line = r#"SOCKS_USERNAME="iso:caf\303\251 \0\1017""#;
+        assert_eq!(
+            quoted_value(line, "SOCKS_USERNAME=").as_deref(),
+            Some("iso:café \0A7")
+        );
+    }
+
+    #[test]
+    fn rejects_unquoted_and_unterminated_values() {
+        for line in [
+            "",
+            "KEY=value",
+            r#"KEY= "value""#,
+            r#"KEY="value"#,
+            r#"KEY="value\"#,
+            r#"KEY="\777""#,
+            r#"OTHER="x""#,
+        ] {
+            assert_eq!(quoted_value(line, "KEY="), None, "{:?}", line);
+        }
+    }
+}
@@ -0,0 +1,157 @@
+use std::{
+    io,
+    sync::atomic::{AtomicBool, Ordering},
+    thread,
+    time::{Duration, Instant},
+};
+
+use logger::log::debug;
+
+use crate::control;
+
+const READY_POLL: Duration = Duration::from_millis(10);
+
+static SUSPENDED: AtomicBool = AtomicBool::new(false);
+
+/// Puts Tor into dormant mode: no circuit building, no directory fetches and
+/// no relay traffic beyond keeping existing connections.
+///
+/// The consensus, guards and open circuits are kept, so [`resume`] does not
+/// need to bootstrap again while the consensus is still fresh.
+pub fn suspend(control_port: &str) -> io::Result<()> {
+    control::with_controller(control_port, |c| c.command("SIGNAL DORMANT"))?;
+    SUSPENDED.store(true, Ordering::SeqCst);
+    debug!("Rust FFI: Tor is dormant");
+    Ok(())
+}
+
+/// Wakes Tor and waits until it can serve a stream again.
+///
+/// Returns the time from the wake-up signal until Tor reports an established
+/// circuit and enough directory information to use it.
+pub fn resume(control_port: &str, timeout: Duration) -> io::Result<Duration> {
+    let started = Instant::now();
+    control::with_controller(control_port, |c| c.command("SIGNAL ACTIVE"))?;
+    SUSPENDED.store(false, Ordering::SeqCst);
+
+    loop {
+        let ready = control::with_controller(control_port, |c| {
+            Ok(c.get_info("status/circuit-established")? == "1"
+                && c.get_info("status/enough-dir-info")? == "1")
+        })?;
+        if ready {
+            let elapsed = started.elapsed();
+            debug!("Rust FFI: Tor resumed in {} ms", elapsed.as_millis());
+            return Ok(elapsed);
+        }
+
+        if started.elapsed() >= timeout {
+            return Err(io::Error::new(
+                io::ErrorKind::TimedOut,
+                "Tor did not have a usable circuit before the timeout",
+            ));
+        }
+        thread::sleep(READY_POLL);
+    }
+}
+
+/// Whether [`suspend`] was called without a matching [`resume`].
+///
+/// Background work checks this so it does not wake Tor up on its own.
+pub fn is_suspended() -> bool {
+    SUSPENDED.load(Ordering::SeqCst)
+}
+
+/// Clears the suspended state after a request woke Tor up; Tor leaves
+/// dormant mode by itself when a client opens a stream.
+pub fn note_activity() {
+    SUSPENDED.store(false, Ordering::SeqCst);
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::{
+        io::{BufRead, BufReader, Write},
+        net::TcpListener,
+        sync::{Arc, Mutex},
+    };
+
+    /// A control port that accepts NULL authentication, answers every
+    /// command with 250 and reports a circuit once `ready_after` status
+    /// polls have been answered. Returns its address and the commands seen.
+    fn fake_tor(ready_after: usize) -> (String, Arc<Mutex<Vec<String>>>) {
+        let listener = TcpListener::bind("127.0.0.1:0").unwrap();
+        let address = listener.local_addr().unwrap().to_string();
+        let commands = Arc::new(Mutex::new(Vec::new()));
+
+        let seen = commands.clone();
+        thread::spawn(move || {
+            let Ok((stream, _)) = listener.accept() else {
+                return;
+            };
+            let mut writer = stream.try_clone().unwrap();
+            let mut polls = 0;
+            for line in BufReader::new(stream).lines() {
+                let Ok(line) = line else {
+                    return;
+                };
+                let reply = match line.as_str() {
+                    "PROTOCOLINFO 1" => {
+                        "250-PROTOCOLINFO 1\r\n250-AUTH METHODS=NULL\r\n250 OK\r\n".to_string()
+                    }
+                    "GETINFO status/circuit-established" => {
+                        polls += 1;
+                        format!(
+                            "250-status/circuit-established={}\r\n250 OK\r\n",
+                            (polls > ready_after) as u8
+                        )
+                    }
+                    "GETINFO status/enough-dir-info" => {
+                        "250-status/enough-dir-info=1\r\n250 OK\r\n".to_string()
+                    }
+                    _ => "250 OK\r\n".to_string(),
+                };
+                seen.lock().unwrap().push(line);
+                if writer.write_all(reply.as_bytes()).is_err() {
+                    return;
+                }
+            }
+        });
+        (address, commands)
+    }
+
+    #[test]
+    fn suspends_and_resumes_tor() {
+        let (address, commands) = fake_tor(2);
+
+        suspend(&address).unwrap();
+        assert!(is_suspended());
+        resume(&address, Duration::from_secs(5)).unwrap();
+        assert!(!is_suspended());
+
+        let commands = commands.lock().unwrap();
+        assert_eq!(
+            commands[..3],
+            ["PROTOCOLINFO 1", "AUTHENTICATE", "SIGNAL DORMANT"]
+        );
+        assert_eq!(commands[3], "SIGNAL ACTIVE");
+        // Two polls without a circuit, then one with it.
+        let polls = commands
+            .iter()
+            .filter(|command| *command == "GETINFO status/circuit-established")
+            .count();
+        assert_eq!(polls, 3);
+
+        // A request wakes Tor up by itself.
+        SUSPENDED.store(true, Ordering::SeqCst);
+        note_activity();
+        assert!(!is_suspended());
+
+        // Resuming gives up when no circuit comes in time.
+        let (address, _) = fake_tor(usize::MAX);
+        let error = resume(&address, Duration::from_millis(30)).unwrap_err();
+        assert_eq!(error.kind(), io::ErrorKind::TimedOut);
+        control::disconnect();
+    }
+}
@@ -0,0 +1,184 @@
+use std::io::{self, BufRead, BufReader, Read};
+
+use flate2::read::{DeflateDecoder, MultiGzDecoder, ZlibDecoder};
+
+/// Content codings this module can decode, in order of preference.
+pub const SUPPORTED_CODINGS: [&str; 4] = ["zstd", "br", "gzip", "deflate"];
+
+const BROTLI_BUFFER_SIZE: usize = 4096;
+
+/// Builds the `Accept-Encoding` value for a request.
+///
+/// `preference` is a comma separated list of codings the caller is willing to
+/// accept. An empty preference advertises every supported coding, `identity`
+/// disables compression. Unknown codings are ignored.
+pub fn accept_encoding(preference: &str) -> Option<String> {
+    let preference = preference.trim();
+
+    if preference.is_empty() {
+        return Some(SUPPORTED_CODINGS.join(", "));
+    }
+
+    let codings: Vec<&str> = preference
+        .split(',')
+        .map(|coding| coding.trim())
+        .filter(|coding| {
+            SUPPORTED_CODINGS
+                .iter()
+                .any(|supported| supported.eq_ignore_ascii_case(coding))
+        })
+        .collect();
+
+    if codings.is_empty() {
+        None
+    } else {
+        Some(codings.join(", "))
+    }
+}
+
+/// Wraps `body` in the decoders needed to undo `content_encoding`.
+///
+/// Codings are listed in the order they were applied, so they are undone in
+/// reverse. Decoding is streaming: compressed bytes are pulled from `body` only
+/// as the decoded output is consumed.
+pub fn decode<'a>(
+    content_encoding: &str,
+    body: Box<dyn Read + 'a>,
+) -> io::Result<Box<dyn Read + 'a>> {
+    let mut reader = body;
+
+    for coding in content_encoding
+        .split(',')
+        .map(|c| c.trim().to_ascii_lowercase())
+        .rev()
+    {
+        reader = match coding.as_str() {
+            "" | "identity" => reader,
+            "gzip" | "x-gzip" => Box::new(MultiGzDecoder::new(reader)),
+            "deflate" => deflate_decoder(reader)?,
+            "br" => Box::new(brotli_decompressor::Decompressor::new(
+                reader,
+                BROTLI_BUFFER_SIZE,
+            )),
+            "zstd" => Box::new(zstd::stream::read::Decoder::new(reader)?),
+            other => {
+                return Err(io::Error::new(
+                    io::ErrorKind::InvalidData,
+                    format!("Unsupported Content-Encoding: {}", other),
+                ))
+            }
+        };
+    }
+
+    Ok(reader)
+}
+
+/// HTTP `deflate` is specified as zlib-wrapped, but enough servers send raw
+/// deflate streams that both have to be accepted. The zlib header is detected
+/// from the first two bytes.
+fn deflate_decoder<'a>(body: Box<dyn Read + 'a>) -> io::Result<Box<dyn Read + 'a>> {
+    let mut reader = BufReader::new(body);
+    let head = reader.fill_buf()?;
+
+    let is_zlib = head.len() >= 2
+        && head[0] & 0x0F == 0x08
+        && (u16::from(head[0]) << 8 | u16::from(head[1])) % 31 == 0;
+
+    if is_zlib {
+        Ok(Box::new(ZlibDecoder::new(reader)))
+    } else {
+        Ok(Box::new(DeflateDecoder::new(reader)))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::io::Write;
+
+    use flate2::{
+        write::{DeflateEncoder, GzEncoder, ZlibEncoder},
+        Compression,
+    };
+
+    use super::*;
+
+    const TEXT: &[u8] = b"The quick brown fox jumps over the lazy dog. The quick brown fox.";
+
+    fn decoded(content_encoding: &str, body: &[u8]) -> io::Result<Vec<u8>> {
+        let mut out = Vec::new();
+        decode(content_encoding, Box::new(body))?.read_to_end(&mut out)?;
+        Ok(out)
+    }
+
+    fn gzip(body: &[u8]) -> Vec<u8> {
+        let mut encoder = GzEncoder::new(Vec::new(), Compression::default());
+        encoder.write_all(body).unwrap();
+        encoder.finish().unwrap()
+    }
+
+    #[test]
+    fn identity_passes_through() {
+        assert_eq!(decoded("", TEXT).unwrap(), TEXT);
+        assert_eq!(decoded("identity", TEXT).unwrap(), TEXT);
+    }
+
+    #[test]
+    fn gzip_round_trip() {
+        assert_eq!(decoded("gzip", &gzip(TEXT)).unwrap(), TEXT);
+        assert_eq!(decoded(" X-GZIP ", &gzip(TEXT)).unwrap(), TEXT);
+    }
+
+    #[test]
+    fn gzip_members_are_concatenated() {
+        let mut body = gzip(b"first ");
+        body.extend(gzip(b"second"));
+        assert_eq!(decoded("gzip", &body).unwrap(), b"first second");
+    }
+
+    #[test]
+    fn deflate_accepts_zlib_and_raw_streams() {
+        let mut zlib = ZlibEncoder::new(Vec::new(), Compression::default());
+        zlib.write_all(TEXT).unwrap();
+        assert_eq!(decoded("deflate", &zlib.finish().unwrap()).unwrap(), TEXT);
+
+        let mut raw = DeflateEncoder::new(Vec::new(), Compression::default());
+        raw.write_all(TEXT).unwrap();
+        assert_eq!(decoded("deflate", &raw.finish().unwrap()).unwrap(), TEXT);
+    }
+
+    #[test]
+    fn zstd_round_trip() {
+        let body = zstd::stream::encode_all(TEXT, 3).unwrap();
+        assert_eq!(decoded("zstd", &body).unwrap(), TEXT);
+    }
+
+    #[test]
+    fn stacked_codings_are_undone_in_reverse() {
+        let body = gzip(&zstd::stream::encode_all(TEXT, 3).unwrap());
+        assert_eq!(decoded("zstd, gzip", &body).unwrap(), TEXT);
+    }
+
+    #[test]
+    fn rejects_unknown_and_malformed_bodies() {
+        let unknown = decode("compress", Box::new(TEXT)).err().unwrap();
+        assert_eq!(unknown.kind(), io::ErrorKind::InvalidData);
+
+        let truncated = gzip(TEXT);
+        assert!(decoded("gzip", &truncated[..truncated.len() / 2]).is_err());
+        assert!(decoded("gzip", TEXT).is_err());
+        assert!(decoded("zstd", TEXT).is_err());
+    }
+
+    #[test]
+    fn accept_encoding_filters_unknown_codings() {
+        assert_eq!(
+            accept_encoding("").as_deref(),
+            Some("zstd, br, gzip, deflate")
+        );
+        assert_eq!(
+            accept_encoding("GZIP, lzma, br").as_deref(),
+            Some("GZIP, br")
+        );
+        assert_eq!(accept_encoding("identity"), None);
+    }
+}
@@ -0,0 +1,91 @@
+use std::{
+    sync::{Condvar, Mutex},
+    time::{Duration, Instant},
+};
+
+use once_cell::sync::OnceCell;
+use serde::Serialize;
+
+use crate::{inbound, publish, server, streams, websocket};
+
+/// Bumped whenever a source has something for JS, with the condvar
+/// [`poll_json`] sleeps on.
+static SIGNAL: OnceCell<(Mutex<u64>, Condvar)> = OnceCell::new();
+
+/// Everything taken by one [`poll_json`], by source.
+#[derive(Serialize)]
+struct Batch {
+    /// Streams with data, their end or an error waiting to be read.
+    streams: Vec<u64>,
+    /// Messages, errors and closes of WebSockets.
+    web_sockets: Vec<websocket::Event>,
+    /// Requests for the JS handlers of HTTP servers.
+    http_requests: Vec<server::Incoming>,
+    /// Streams clients opened to onion services created with
+    /// `accept_streams`.
+    onion_streams: Vec<inbound::Accepted>,
+    /// Descriptor uploads of onion services.
+    onion_publish: Vec<publish::Event>,
+}
+
+impl Batch {
+    fn take() -> Batch {
+        Batch {
+            streams: streams::take_ready(),
+            web_sockets: websocket::take(),
+            http_requests: server::take(),
+            onion_streams: inbound::take(),
+            onion_publish: publish::take(),
+        }
+    }
+
+    fn is_empty(&self) -> bool {
+        self.streams.is_empty()
+            && self.web_sockets.is_empty()
+            && self.http_requests.is_empty()
+            && self.onion_streams.is_empty()
+            && self.onion_publish.is_empty()
+    }
+}
+
+fn signal() -> &'static (Mutex<u64>, Condvar) {
+    SIGNAL.get_or_init(|| (Mutex::new(0), Condvar::new()))
+}
+
+/// Wakes [`poll_json`]; sources call it after queueing something for JS.
+pub fn notify() {
+    let (generation, changed) = signal();
+    *generation.lock().unwrap() += 1;
+    changed.notify_all();
+}
+
+/// Takes what every source has for JS as one JSON object, waiting up to
+/// `wait` for the first item.
+///
+/// Native calls run on a small worker pool, so nothing else may park a
+/// worker waiting for the network: JS keeps this single call pending for
+/// streams, WebSockets, servers and onion services alike, and makes
+/// non-blocking calls for the items it reports.
+pub fn poll_json(wait: Duration) -> String {
+    let (generation, changed) = signal();
+    let deadline = Instant::now() + wait;
+
+    loop {
+        let seen = *generation.lock().unwrap();
+        let batch = Batch::take();
+        if !batch.is_empty() || Instant::now() >= deadline {
+            return serde_json::to_string(&batch).unwrap_or_else(|_| "{}".to_string());
+        }
+
+        // A notify between taking and sleeping bumps the generation, so it
+        // is never slept through.
+        let mut current = generation.lock().unwrap();
+        while *current == seen {
+            let now = Instant::now();
+            if now >= deadline {
+                break;
+            }
+            current = changed.wait_timeout(current, deadline - now).unwrap().0;
+        }
+    }
+}
@@ -13,6 +13,7 @@ pub mod bridging {
         is_success: bool,
         onion_address: String,
         control: String,
+        socks_port: f64,
         error_message: String,
         onion_addresses_json: String,
     }
@@ -23,6 +24,8 @@ pub mod bridging {
         target_port: f64,
         timeout_ms: f64,
         keys_json: String,
+        profile: String,
+        torrc_overrides_json: String,
     }
 
     struct HttpPostParams {
@@ -30,35 +33,55 @@ pub mod bridging {
         body: String,
         headers: String,
         timeout_ms: f64,
+        accept_encoding: String,
+        isolation: String,
+        fresh_circuit: bool,
     }
 
     struct HttpGetParams {
         url: String,
         headers: String,
         timeout_ms: f64,
+        accept_encoding: String,
+        cache: bool,
+        hedge_percentile: f64,
+        isolation: String,
+        fresh_circuit: bool,
     }
 
     struct HttpDeleteParams {
         url: String,
         headers: String,
         timeout_ms: f64,
+        accept_encoding: String,
+        isolation: String,
+        fresh_circuit: bool,
     }
 
     struct HiddenServiceParams {
         port: f64,
         target_port: f64,
+        ports_json: String,
+        accept_streams: bool,
+        defenses_json: String,
     }
 
     struct TorConfig {
         socks_port: f64,
         data_dir: String,
         timeout_ms: f64,
+        profile: String,
+        torrc_overrides_json: String,
     }
 
     struct HttpResponse {
         status_code: f64,
         body: String,
         error: String,
+        wire_bytes: f64,
+        decoded_bytes: f64,
+        cache_status: String,
+        conflux: bool,
     }
 
     struct HttpPutParams {
@@ -66,12 +89,121 @@ pub mod bridging {
         body: String,
         headers: String,
         timeout_ms: f64,
+        accept_encoding: String,
+        isolation: String,
+        fresh_circuit: bool,
     }
 
     struct HiddenServiceResponse {
         is_success: bool,
         onion_address: String,
         control: String,
+        error: String,
+    }
+
+    struct PrewarmParams {
+        targets_json: String,
+        keepalive_ms: f64,
+        isolation: String,
+    }
+
+    struct DirectorySnapshotParams {
+        data_dir: String,
+        snapshot_dir: String,
+    }
+
+    struct DirectorySnapshotResponse {
+        is_success: bool,
+        error: String,
+        valid_until: f64,
+    }
+
+    struct TorListeners {
+        socks_port: f64,
+        socks_socket: String,
+        control: String,
+    }
+
+    struct ResumeResponse {
+        is_success: bool,
+        error: String,
+        resume_ms: f64,
+    }
+
+    struct OpenStreamParams {
+        host: String,
+        port: f64,
+        timeout_ms: f64,
+        isolation: String,
+    }
+
+    struct StreamResponse {
+        is_success: bool,
+        error: String,
+        stream_id: f64,
+    }
+
+    struct StreamReadResponse {
+        data_base64: String,
+        eof: bool,
+        error: String,
+    }
+
+    struct WebSocketParams {
+        url: String,
+        headers: String,
+        protocols: String,
+        timeout_ms: f64,
+        ping_interval_ms: f64,
+        deflate: bool,
+        isolation: String,
+    }
+
+    struct WebSocketResponse {
+        is_success: bool,
+        error: String,
+        socket_id: f64,
+        protocol: String,
+        extensions: String,
+    }
+
+    struct ProxyParams {
+        listen: String,
+        isolation: String,
+    }
+
+    struct ProxyResponse {
+        is_success: bool,
+        error: String,
+        address: String,
+        credentials: String,
+    }
+
+    struct HttpServerParams {
+        listen: String,
+        static_dir: String,
+        routes_json: String,
+        dispatch: bool,
+        handler_timeout_ms: f64,
+    }
+
+    struct HttpServerResponse {
+        is_success: bool,
+        error: String,
+        server_id: f64,
+        address: String,
+    }
+
+    struct OnionPublishParams {
+        onion_address: String,
+        min_hsdirs: f64,
+        timeout_ms: f64,
+    }
+
+    struct OnionPublishResponse {
+        is_success: bool,
+        hsdirs: f64,
+        error: String,
     }
 
 
@@ -82,15 +214,39 @@ pub mod bridging {
         #[cxx_name = "createReactNativeNitroTor"]
         fn create_react_native_nitro_tor(id: usize, data_path: &str) -> Box<ReactNativeNitroTor>;
 
+        #[cxx_name = "attachHttpServer"]
+        fn react_native_nitro_tor_attach_http_server(it_: &mut ReactNativeNitroTor, server_id: f64) -> Result<bool>;
+
+        #[cxx_name = "clearHttpCache"]
+        fn react_native_nitro_tor_clear_http_cache(it_: &mut ReactNativeNitroTor) -> Result<bool>;
+
         #[cxx_name = "createHiddenService"]
         fn react_native_nitro_tor_create_hidden_service(it_: &mut ReactNativeNitroTor, params: HiddenServiceParams) -> Result<HiddenServiceResponse>;
 
         #[cxx_name = "deleteHiddenService"]
         fn react_native_nitro_tor_delete_hidden_service(it_: &mut ReactNativeNitroTor, onion_address: &str) -> Result<bool>;
 
+        #[cxx_name = "exportDirectorySnapshot"]
+        fn react_native_nitro_tor_export_directory_snapshot(it_: &mut ReactNativeNitroTor, params: DirectorySnapshotParams) -> Result<DirectorySnapshotResponse>;
+
+        #[cxx_name = "getCircuitStats"]
+        fn react_native_nitro_tor_get_circuit_stats(it_: &mut ReactNativeNitroTor) -> Result<String>;
+
+        #[cxx_name = "getListeners"]
+        fn react_native_nitro_tor_get_listeners(it_: &mut ReactNativeNitroTor) -> Result<TorListeners>;
+
+        #[cxx_name = "getOnionServiceMetrics"]
+        fn react_native_nitro_tor_get_onion_service_metrics(it_: &mut ReactNativeNitroTor, onion_address: &str) -> Result<String>;
+
+        #[cxx_name = "getPrewarmStatus"]
+        fn react_native_nitro_tor_get_prewarm_status(it_: &mut ReactNativeNitroTor) -> Result<String>;
+
         #[cxx_name = "getServiceStatus"]
         fn react_native_nitro_tor_get_service_status(it_: &mut ReactNativeNitroTor) -> Result<f64>;
 
+        #[cxx_name = "getStartupReport"]
+        fn react_native_nitro_tor_get_startup_report(it_: &mut ReactNativeNitroTor) -> Result<String>;
+
         #[cxx_name = "httpDelete"]
         fn react_native_nitro_tor_http_delete(it_: &mut ReactNativeNitroTor, params: HttpDeleteParams) -> Result<HttpResponse>;
 
@@ -106,11 +262,71 @@ pub mod bridging {
         #[cxx_name = "initTorService"]
         fn react_native_nitro_tor_init_tor_service(it_: &mut ReactNativeNitroTor, config: TorConfig) -> Result<bool>;
 
+        #[cxx_name = "openStream"]
+        fn react_native_nitro_tor_open_stream(it_: &mut ReactNativeNitroTor, params: OpenStreamParams) -> Result<StreamResponse>;
+
+        #[cxx_name = "pollEvents"]
+        fn react_native_nitro_tor_poll_events(it_: &mut ReactNativeNitroTor, wait_ms: f64) -> Result<String>;
+
+        #[cxx_name = "prewarm"]
+        fn react_native_nitro_tor_prewarm(it_: &mut ReactNativeNitroTor, params: PrewarmParams) -> Result<bool>;
+
+        #[cxx_name = "respondHttpRequests"]
+        fn react_native_nitro_tor_respond_http_requests(it_: &mut ReactNativeNitroTor, replies_json: &str) -> Result<bool>;
+
+        #[cxx_name = "resume"]
+        fn react_native_nitro_tor_resume(it_: &mut ReactNativeNitroTor, timeout_ms: f64) -> Result<ResumeResponse>;
+
+        #[cxx_name = "seedDirectorySnapshot"]
+        fn react_native_nitro_tor_seed_directory_snapshot(it_: &mut ReactNativeNitroTor, params: DirectorySnapshotParams) -> Result<DirectorySnapshotResponse>;
+
         #[cxx_name = "shutdownService"]
         fn react_native_nitro_tor_shutdown_service(it_: &mut ReactNativeNitroTor) -> Result<bool>;
 
+        #[cxx_name = "startHttpServer"]
+        fn react_native_nitro_tor_start_http_server(it_: &mut ReactNativeNitroTor, params: HttpServerParams) -> Result<HttpServerResponse>;
+
+        #[cxx_name = "startProxy"]
+        fn react_native_nitro_tor_start_proxy(it_: &mut ReactNativeNitroTor, params: ProxyParams) -> Result<ProxyResponse>;
+
         #[cxx_name = "startTorIfNotRunning"]
         fn react_native_nitro_tor_start_tor_if_not_running(it_: &mut ReactNativeNitroTor, params: StartTorParams) -> Result<StartTorResponse>;
+
+        #[cxx_name = "stopHttpServer"]
+        fn react_native_nitro_tor_stop_http_server(it_: &mut ReactNativeNitroTor, server_id: f64) -> Result<bool>;
+
+        #[cxx_name = "stopProxy"]
+        fn react_native_nitro_tor_stop_proxy(it_: &mut ReactNativeNitroTor, address: &str) -> Result<bool>;
+
+        #[cxx_name = "streamClose"]
+        fn react_native_nitro_tor_stream_close(it_: &mut ReactNativeNitroTor, stream_id: f64) -> Result<bool>;
+
+        #[cxx_name = "streamRead"]
+        fn react_native_nitro_tor_stream_read(it_: &mut ReactNativeNitroTor, stream_id: f64, max_bytes: f64) -> Result<StreamReadResponse>;
+
+        #[cxx_name = "streamShutdownWrite"]
+        fn react_native_nitro_tor_stream_shutdown_write(it_: &mut ReactNativeNitroTor, stream_id: f64) -> Result<StreamResponse>;
+
+        #[cxx_name = "streamWrite"]
+        fn react_native_nitro_tor_stream_write(it_: &mut ReactNativeNitroTor, stream_id: f64, data_base64: &str) -> Result<StreamResponse>;
+
+        #[cxx_name = "suspend"]
+        fn react_native_nitro_tor_suspend(it_: &mut ReactNativeNitroTor) -> Result<bool>;
+
+        #[cxx_name = "waitOnionPublished"]
+        fn react_native_nitro_tor_wait_onion_published(it_: &mut ReactNativeNitroTor, params: OnionPublishParams) -> Result<OnionPublishResponse>;
+
+        #[cxx_name = "webSocketAttach"]
+        fn react_native_nitro_tor_web_socket_attach(it_: &mut ReactNativeNitroTor, socket_id: f64) -> Result<bool>;
+
+        #[cxx_name = "webSocketClose"]
+        fn react_native_nitro_tor_web_socket_close(it_: &mut ReactNativeNitroTor, socket_id: f64, code: f64, reason: &str) -> Result<bool>;
+
+        #[cxx_name = "webSocketConnect"]
+        fn react_native_nitro_tor_web_socket_connect(it_: &mut ReactNativeNitroTor, params: WebSocketParams) -> Result<WebSocketResponse>;
+
+        #[cxx_name = "webSocketSend"]
+        fn react_native_nitro_tor_web_socket_send(it_: &mut ReactNativeNitroTor, socket_id: f64, data: &str, binary: bool) -> Result<bool>;
     }
 
 }
@@ -120,6 +336,20 @@ fn create_react_native_nitro_tor(id: usize, data_path: &str) -> Box<ReactNativeN
     Box::new(ReactNativeNitroTor::new(ctx))
 }
 
+fn react_native_nitro_tor_attach_http_server(it_: &mut ReactNativeNitroTor, server_id: f64) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.attach_http_server(server_id);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_clear_http_cache(it_: &mut ReactNativeNitroTor) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.clear_http_cache();
+        ret
+    }).and_then(|r| r)
+}
+
 fn react_native_nitro_tor_create_hidden_service(it_: &mut ReactNativeNitroTor, params: HiddenServiceParams) -> Result<HiddenServiceResponse, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.create_hidden_service(params);
@@ -134,6 +364,41 @@ fn react_native_nitro_tor_delete_hidden_service(it_: &mut ReactNativeNitroTor, o
     }).and_then(|r| r)
 }
 
+fn react_native_nitro_tor_export_directory_snapshot(it_: &mut ReactNativeNitroTor, params: DirectorySnapshotParams) -> Result<DirectorySnapshotResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.export_directory_snapshot(params);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_get_circuit_stats(it_: &mut ReactNativeNitroTor) -> Result<String, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.get_circuit_stats();
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_get_listeners(it_: &mut ReactNativeNitroTor) -> Result<TorListeners, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.get_listeners();
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_get_onion_service_metrics(it_: &mut ReactNativeNitroTor, onion_address: &str) -> Result<String, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.get_onion_service_metrics(onion_address);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_get_prewarm_status(it_: &mut ReactNativeNitroTor) -> Result<String, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.get_prewarm_status();
+        ret
+    }).and_then(|r| r)
+}
+
 fn react_native_nitro_tor_get_service_status(it_: &mut ReactNativeNitroTor) -> Result<f64, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.get_service_status();
@@ -141,6 +406,13 @@ fn react_native_nitro_tor_get_service_status(it_: &mut ReactNativeNitroTor) -> R
     }).and_then(|r| r)
 }
 
+fn react_native_nitro_tor_get_startup_report(it_: &mut ReactNativeNitroTor) -> Result<String, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.get_startup_report();
+        ret
+    }).and_then(|r| r)
+}
+
 fn react_native_nitro_tor_http_delete(it_: &mut ReactNativeNitroTor, params: HttpDeleteParams) -> Result<HttpResponse, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.http_delete(params);
@@ -176,6 +448,48 @@ fn react_native_nitro_tor_init_tor_service(it_: &mut ReactNativeNitroTor, config
     }).and_then(|r| r)
 }
 
+fn react_native_nitro_tor_open_stream(it_: &mut ReactNativeNitroTor, params: OpenStreamParams) -> Result<StreamResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.open_stream(params);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_poll_events(it_: &mut ReactNativeNitroTor, wait_ms: f64) -> Result<String, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.poll_events(wait_ms);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_prewarm(it_: &mut ReactNativeNitroTor, params: PrewarmParams) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.prewarm(params);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_respond_http_requests(it_: &mut ReactNativeNitroTor, replies_json: &str) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.respond_http_requests(replies_json);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_resume(it_: &mut ReactNativeNitroTor, timeout_ms: f64) -> Result<ResumeResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.resume(timeout_ms);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_seed_directory_snapshot(it_: &mut ReactNativeNitroTor, params: DirectorySnapshotParams) -> Result<DirectorySnapshotResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.seed_directory_snapshot(params);
+        ret
+    }).and_then(|r| r)
+}
+
 fn react_native_nitro_tor_shutdown_service(it_: &mut ReactNativeNitroTor) -> Result<bool, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.shutdown_service();
@@ -183,9 +497,107 @@ fn react_native_nitro_tor_shutdown_service(it_: &mut ReactNativeNitroTor) -> Res
     }).and_then(|r| r)
 }
 
+fn react_native_nitro_tor_start_http_server(it_: &mut ReactNativeNitroTor, params: HttpServerParams) -> Result<HttpServerResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.start_http_server(params);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_start_proxy(it_: &mut ReactNativeNitroTor, params: ProxyParams) -> Result<ProxyResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.start_proxy(params);
+        ret
+    }).and_then(|r| r)
+}
+
 fn react_native_nitro_tor_start_tor_if_not_running(it_: &mut ReactNativeNitroTor, params: StartTorParams) -> Result<StartTorResponse, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.start_tor_if_not_running(params);
         ret
     }).and_then(|r| r)
 }
+
+fn react_native_nitro_tor_stop_http_server(it_: &mut ReactNativeNitroTor, server_id: f64) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.stop_http_server(server_id);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_stop_proxy(it_: &mut ReactNativeNitroTor, address: &str) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.stop_proxy(address);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_stream_close(it_: &mut ReactNativeNitroTor, stream_id: f64) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.stream_close(stream_id);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_stream_read(it_: &mut ReactNativeNitroTor, stream_id: f64, max_bytes: f64) -> Result<StreamReadResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.stream_read(stream_id, max_bytes);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_stream_shutdown_write(it_: &mut ReactNativeNitroTor, stream_id: f64) -> Result<StreamResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.stream_shutdown_write(stream_id);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_stream_write(it_: &mut ReactNativeNitroTor, stream_id: f64, data_base64: &str) -> Result<StreamResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.stream_write(stream_id, data_base64);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_suspend(it_: &mut ReactNativeNitroTor) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.suspend();
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_wait_onion_published(it_: &mut ReactNativeNitroTor, params: OnionPublishParams) -> Result<OnionPublishResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.wait_onion_published(params);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_web_socket_attach(it_: &mut ReactNativeNitroTor, socket_id: f64) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.web_socket_attach(socket_id);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_web_socket_close(it_: &mut ReactNativeNitroTor, socket_id: f64, code: f64, reason: &str) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.web_socket_close(socket_id, code, reason);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_web_socket_connect(it_: &mut ReactNativeNitroTor, params: WebSocketParams) -> Result<WebSocketResponse, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.web_socket_connect(params);
+        ret
+    }).and_then(|r| r)
+}
+
+fn react_native_nitro_tor_web_socket_send(it_: &mut ReactNativeNitroTor, socket_id: f64, data: &str, binary: bool) -> Result<bool, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.web_socket_send(socket_id, data, binary);
+        ret
+    }).and_then(|r| r)
+}
@@ -0,0 +1,465 @@
+use std::{
+    fs::{File, Metadata},
+    io::{self, Read, Seek, SeekFrom, Write},
+    path::{Path, PathBuf},
+    time::UNIX_EPOCH,
+};
+
+use crate::http;
+use crate::socks::Stream;
+
+/// Precompressed variants looked for next to a file, in order of preference.
+const VARIANTS: [(&str, &str); 2] = [("br", "br"), ("gzip", "gz")];
+
+/// Maps requests under a path prefix to a directory.
+pub struct Route {
+    prefix: String,
+    root: PathBuf,
+}
+
+impl Route {
+    /// `prefix` is a URL path such as `/media`; `/` matches every request.
+    pub fn new(prefix: &str, root: PathBuf) -> Route {
+        let prefix = format!("/{}", prefix.trim_matches('/'));
+        Route { prefix, root }
+    }
+
+    /// Path below the prefix, if `path` falls under this route.
+    fn strip<'a>(&self, path: &'a str) -> Option<&'a str> {
+        if self.prefix == "/" {
+            return Some(path);
+        }
+        let rest = path.strip_prefix(&self.prefix)?;
+        (rest.is_empty() || rest.starts_with('/')).then_some(rest)
+    }
+}
+
+/// Orders routes so the longest matching prefix is found first.
+pub fn sort_routes(routes: &mut [Route]) {
+    routes.sort_by(|a, b| b.prefix.len().cmp(&a.prefix.len()));
+}
+
+/// Maps a request target to a regular file through the first matching route.
+///
+/// `.` and `..` segments are refused rather than resolved, so the target can
+/// never name something outside the route's directory. Directories serve
+/// their `index.html`.
+pub fn resolve(routes: &[Route], target: &str) -> Option<PathBuf> {
+    let path = target.split(['?', '#']).next().unwrap_or("");
+    if !path.starts_with('/') {
+        return None;
+    }
+    let route = routes.iter().find(|route| route.strip(path).is_some())?;
+
+    let mut resolved = route.root.clone();
+    for segment in route.strip(path)?.split('/').filter(|s| !s.is_empty()) {
+        let segment = percent_decode(segment)?;
+        if segment == "." || segment == ".." || segment.contains(['/', '\\', '\0']) {
+            return None;
+        }
+        resolved.push(segment);
+    }
+    if resolved.is_dir() {
+        resolved.push("index.html");
+    }
+
+    resolved.is_file().then_some(resolved)
+}
+
+fn percent_decode(segment: &str) -> Option<String> {
+    let bytes = segment.as_bytes();
+    let mut decoded = Vec::with_capacity(bytes.len());
+    let mut i = 0;
+    while i < bytes.len() {
+        if bytes[i] == b'%' {
+            let hex = segment.get(i + 1..i + 3)?;
+            if !hex.bytes().all(|b| b.is_ascii_hexdigit()) {
+                return None;
+            }
+            decoded.push(u8::from_str_radix(hex, 16).ok()?);
+            i += 3;
+        } else {
+            decoded.push(bytes[i]);
+            i += 1;
+        }
+    }
+    String::from_utf8(decoded).ok()
+}
+
+/// Answers a `GET` or `HEAD` for the file at `path`.
+///
+/// A `.br` or `.gz` file next to it is sent instead when the client accepts
+/// that coding. `If-None-Match` is answered with a 304 and a single byte
+/// range with a 206. The body is copied from the file straight to the
+/// socket, which std turns into `sendfile` on Linux and Android, so the
+/// contents never pass through user space.
+pub fn send(
+    out: &mut Stream,
+    request: &http::RequestHead,
+    path: &Path,
+    close: bool,
+) -> io::Result<()> {
+    let accept_encoding = http::find_header(&request.headers, "accept-encoding").unwrap_or("");
+    let (mut file, metadata, coding) = open_variant(path, accept_encoding)?;
+
+    let length = metadata.len();
+    let etag = etag(&metadata, coding);
+    let mut headers = vec![
+        ("Content-Type", content_type(path).to_string()),
+        ("ETag", etag.clone()),
+        ("Accept-Ranges", "bytes".to_string()),
+        ("Vary", "Accept-Encoding".to_string()),
+    ];
+    if let Some(coding) = coding {
+        headers.push(("Content-Encoding", coding.to_string()));
+    }
+
+    if let Some(tags) = http::find_header(&request.headers, "if-none-match") {
+        if etag_matches(tags, &etag) {
+            return write_head(out, 304, &headers, length, close);
+        }
+    }
+
+    let range = match http::find_header(&request.headers, "range") {
+        // A stale If-Range means the client's partial copy is outdated, so
+        // it gets the whole file.
+        Some(_)
+            if http::find_header(&request.headers, "if-range")
+                .is_some_and(|tag| tag.trim() != etag) =>
+        {
+            None
+        }
+        Some(value) => parse_range(value, length),
+        None => None,
+    };
+
+    let (status, start, count) = match range {
+        None => (200, 0, length),
+        Some(Some((start, end))) => {
+            headers.push((
+                "Content-Range",
+                format!("bytes {}-{}/{}", start, end, length),
+            ));
+            (206, start, end - start + 1)
+        }
+        Some(None) => {
+            headers.push(("Content-Range", format!("bytes */{}", length)));
+            return write_head(out, 416, &headers, 0, close);
+        }
+    };
+
+    write_head(out, status, &headers, count, close)?;
+    if request.method == "HEAD" {
+        return Ok(());
+    }
+
+    file.seek(SeekFrom::Start(start))?;
+    let mut contents = file.take(count);
+    let copied = match out {
+        Stream::Tcp(stream) => io::copy(&mut contents, stream)?,
+        #[cfg(unix)]
+        Stream::Unix(stream) => io::copy(&mut contents, stream)?,
+    };
+    if copied < count {
+        // The file shrank while being sent; the client cannot tell where
+        // the response ends, so the connection has to go.
+        return Err(io::Error::new(
+            io::ErrorKind::UnexpectedEof,
+            "File truncated while sending",
+        ));
+    }
+    out.flush()
+}
+
+/// Opens the best precompressed variant of `path` the client accepts, or
+/// `path` itself.
+fn open_variant(
+    path: &Path,
+    accept_encoding: &str,
+) -> io::Result<(File, Metadata, Option<&'static str>)> {
+    for (coding, extension) in VARIANTS {
+        if !accepts(accept_encoding, coding) {
+            continue;
+        }
+        let mut variant = path.as_os_str().to_owned();
+        variant.push(".");
+        variant.push(extension);
+        if let Ok(file) = File::open(&variant) {
+            let metadata = file.metadata()?;
+            if metadata.is_file() {
+                return Ok((file, metadata, Some(coding)));
+            }
+        }
+    }
+
+    let file = File::open(path)?;
+    let metadata = file.metadata()?;
+    Ok((file, metadata, None))
+}
+
+/// Whether `Accept-Encoding` allows `coding`, honouring `q=0`.
+fn accepts(accept_encoding: &str, coding: &str) -> bool {
+    accept_encoding.split(',').any(|entry| {
+        let mut parts = entry.split(';');
+        let name = parts.next().unwrap_or("").trim();
+        let refused = parts.any(|param| {
+            param
+                .trim()
+                .strip_prefix("q=")
+                .and_then(|q| q.trim().parse::<f32>().ok())
+                .is_some_and(|q| q <= 0.0)
+        });
+        (name.eq_ignore_ascii_case(coding) || name == "*") && !refused
+    })
+}
+
+/// Strong validator from size and modification time; each variant gets its
+/// own, as their bytes differ.
+fn etag(metadata: &Metadata, coding: Option<&str>) -> String {
+    let modified = metadata
+        .modified()
+        .ok()
+        .and_then(|time| time.duration_since(UNIX_EPOCH).ok())
+        .map(|since| since.as_nanos())
+        .unwrap_or(0);
+    match coding {
+        Some(coding) => format!("\"{:x}-{:x}-{}\"", metadata.len(), modified, coding),
+        None => format!("\"{:x}-{:x}\"", metadata.len(), modified),
+    }
+}
+
+/// `If-None-Match` uses weak comparison: `W/` prefixes are ignored.
+fn etag_matches(tags: &str, etag: &str) -> bool {
+    tags.split(',')
+        .map(str::trim)
+        .any(|tag| tag == "*" || tag.strip_prefix("W/").unwrap_or(tag) == etag)
+}
+
+/// Parses a single `bytes=` range against a file of `length` bytes.
+///
+/// Returns `None` when the header should be ignored (other units, several
+/// ranges or bad syntax) and `Some(None)` when the range is unsatisfiable.
+fn parse_range(value: &str, length: u64) -> Option<Option<(u64, u64)>> {
+    let spec = value.trim().strip_prefix("bytes=")?;
+    if spec.contains(',') {
+        return None;
+    }
+    let (first, last) = spec.trim().split_once('-')?;
+
+    let range = if first.is_empty() {
+        // Suffix range: the last `last` bytes.
+        let suffix = decimal(last)?;
+        if suffix == 0 || length == 0 {
+            None
+        } else {
+            Some((length.saturating_sub(suffix), length - 1))
+        }
+    } else {
+        let start = decimal(first)?;
+        let end = if last.is_empty() {
+            u64::MAX
+        } else {
+            decimal(last)?
+        };
+        if end < start {
+            return None;
+        }
+        (start < length).then(|| (start, end.min(length - 1)))
+    };
+    Some(range)
+}
+
+/// A range bound: digits only, where `str::parse` would also take a sign.
+fn decimal(value: &str) -> Option<u64> {
+    if value.is_empty() || !value.bytes().all(|b| b.is_ascii_digit()) {
+        return None;
+    }
+    value.parse().ok()
+}
+
+fn write_head(
+    out: &mut Stream,
+    status: u16,
+    headers: &[(&str, String)],
+    length: u64,
+    close: bool,
+) -> io::Result<()> {
+    let headers: Vec<(&str, &str)> = headers
+        .iter()
+        .map(|(name, value)| (*name, value.as_str()))
+        .collect();
+    out.write_all(http::response_head(status, &headers, length, close).as_bytes())?;
+    out.flush()
+}
+
+fn content_type(path: &Path) -> &'static str {
+    let extension = path
+        .extension()
+        .and_then(|extension| extension.to_str())
+        .unwrap_or("")
+        .to_ascii_lowercase();
+    match extension.as_str() {
+        "html" | "htm" => "text/html; charset=utf-8",
+        "css" => "text/css; charset=utf-8",
+        "js" | "mjs" => "text/javascript; charset=utf-8",
+        "json" => "application/json",
+        "txt" => "text/plain; charset=utf-8",
+        "xml" => "application/xml",
+        "svg" => "image/svg+xml",
+        "png" => "image/png",
+        "jpg" | "jpeg" => "image/jpeg",
+        "gif" => "image/gif",
+        "webp" => "image/webp",
+        "avif" => "image/avif",
+        "ico" => "image/x-icon",
+        "wasm" => "application/wasm",
+        "woff" => "font/woff",
+        "woff2" => "font/woff2",
+        "pdf" => "application/pdf",
+        "mp3" => "audio/mpeg",
+        "ogg" => "audio/ogg",
+        "mp4" => "video/mp4",
+        "webm" => "video/webm",
+        _ => "application/octet-stream",
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::fs;
+
+    use super::*;
+
+    #[test]
+    fn parses_single_ranges() {
+        assert_eq!(parse_range("bytes=0-0", 10), Some(Some((0, 0))));
+        assert_eq!(parse_range("bytes=2-5", 10), Some(Some((2, 5))));
+        assert_eq!(parse_range(" bytes= 3- ", 10), Some(Some((3, 9))));
+        // The last byte, by offset and as a suffix.
+        assert_eq!(parse_range("bytes=9-9", 10), Some(Some((9, 9))));
+        assert_eq!(parse_range("bytes=9-", 10), Some(Some((9, 9))));
+        assert_eq!(parse_range("bytes=-1", 10), Some(Some((9, 9))));
+        // Ends past the file are clamped.
+        assert_eq!(parse_range("bytes=5-100", 10), Some(Some((5, 9))));
+        assert_eq!(parse_range("bytes=-100", 10), Some(Some((0, 9))));
+        assert_eq!(
+            parse_range("bytes=0-18446744073709551615", 10),
+            Some(Some((0, 9)))
+        );
+    }
+
+    #[test]
+    fn reports_unsatisfiable_ranges() {
+        assert_eq!(parse_range("bytes=10-", 10), Some(None));
+        assert_eq!(parse_range("bytes=10-20", 10), Some(None));
+        assert_eq!(parse_range("bytes=-0", 10), Some(None));
+        assert_eq!(parse_range("bytes=0-", 0), Some(None));
+        assert_eq!(parse_range("bytes=-5", 0), Some(None));
+    }
+
+    #[test]
+    fn ignores_malformed_ranges() {
+        for value in [
+            "",
+            "bytes=",
+            "bytes=-",
+            "bytes=5",
+            "bytes=5-2",
+            "bytes=a-b",
+            "bytes=+1-2",
+            "bytes=1-+2",
+            "bytes=--1",
+            "bytes=0-1,3-4",
+            "bytes=18446744073709551616-",
+            "items=0-1",
+        ] {
+            assert_eq!(parse_range(value, 10), None, "{:?}", value);
+        }
+    }
+
+    /// `public/` with an index and a nested file, next to a file that must
+    /// stay out of reach.
+    fn site(name: &str) -> PathBuf {
+        let root = std::env::temp_dir().join(format!("rntf-{}-{}", name, std::process::id()));
+        let _ = fs::remove_dir_all(&root);
+        fs::create_dir_all(root.join("public/sub dir")).unwrap();
+        fs::write(root.join("public/index.html"), "index").unwrap();
+        fs::write(root.join("public/sub dir/a.txt"), "a").unwrap();
+        fs::write(root.join("secret.txt"), "secret").unwrap();
+        root
+    }
+
+    #[test]
+    fn resolves_files_and_indexes() {
+        let root = site("resolve");
+        let public = root.join("public");
+        let routes = [Route::new("/static/", public.clone())];
+
+        let resolve = |target| resolve(&routes, target);
+        assert_eq!(resolve("/static"), Some(public.join("index.html")));
+        assert_eq!(resolve("/static/"), Some(public.join("index.html")));
+        assert_eq!(
+            resolve("/static/sub%20dir/a.txt?v=1#top"),
+            Some(public.join("sub dir/a.txt"))
+        );
+        assert_eq!(
+            resolve("/static//sub%20dir//a.txt"),
+            Some(public.join("sub dir/a.txt"))
+        );
+        assert_eq!(resolve("/static/missing"), None);
+        assert_eq!(resolve("/staticfoo/index.html"), None);
+        assert_eq!(resolve("static/index.html"), None);
+        assert_eq!(resolve("http://host/static/index.html"), None);
+
+        fs::remove_dir_all(root).unwrap();
+    }
+
+    #[test]
+    fn refuses_traversal() {
+        let root = site("traversal");
+        let routes = [Route::new("/", root.join("public"))];
+
+        for target in [
+            "/../secret.txt",
+            "/sub%20dir/../../secret.txt",
+            "/./index.html",
+            "/%2e%2e/secret.txt",
+            "/%2E%2E/secret.txt",
+            "/.%2e/secret.txt",
+            "/..%2fsecret.txt",
+            "/sub%20dir%2f..%2f..%2fsecret.txt",
+            "/..%5csecret.txt",
+            "/..\\secret.txt",
+            "/index.html%00.txt",
+            "/%ff",
+            "/%2",
+            "/%+2e",
+            "/%zz",
+        ] {
+            assert_eq!(resolve(&routes, target), None, "{:?}", target);
+        }
+
+        fs::remove_dir_all(root).unwrap();
+    }
+
+    #[test]
+    fn longest_prefix_wins() {
+        let root = site("routes");
+        let mut routes = vec![
+            Route::new("/", root.join("public")),
+            Route::new("/sub", root.join("public/sub dir")),
+        ];
+        sort_routes(&mut routes);
+
+        assert_eq!(
+            resolve(&routes, "/sub/a.txt"),
+            Some(root.join("public/sub dir/a.txt"))
+        );
+        assert_eq!(
+            resolve(&routes, "/index.html"),
+            Some(root.join("public/index.html"))
+        );
+
+        fs::remove_dir_all(root).unwrap();
+    }
+}
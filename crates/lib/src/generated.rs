@@ -8,16 +8,44 @@ use crate::ffi::bridging::*;
 pub trait ReactNativeNitroTorSpec {
     fn new(ctx: Context) -> Self;
     fn id(&self) -> usize;
+    fn attach_http_server(&mut self, server_id: f64) -> Promise<Boolean>;
+    fn clear_http_cache(&mut self) -> Promise<Boolean>;
     fn create_hidden_service(&mut self, params: HiddenServiceParams) -> Promise<HiddenServiceResponse>;
     fn delete_hidden_service(&mut self, onion_address: &str) -> Promise<Boolean>;
+    fn export_directory_snapshot(&mut self, params: DirectorySnapshotParams) -> Promise<DirectorySnapshotResponse>;
+    fn get_circuit_stats(&mut self) -> Promise<String>;
+    fn get_listeners(&mut self) -> Promise<TorListeners>;
+    fn get_onion_service_metrics(&mut self, onion_address: &str) -> Promise<String>;
+    fn get_prewarm_status(&mut self) -> Promise<String>;
     fn get_service_status(&mut self) -> Promise<Number>;
+    fn get_startup_report(&mut self) -> Promise<String>;
     fn http_delete(&mut self, params: HttpDeleteParams) -> Promise<HttpResponse>;
     fn http_get(&mut self, params: HttpGetParams) -> Promise<HttpResponse>;
     fn http_post(&mut self, params: HttpPostParams) -> Promise<HttpResponse>;
     fn http_put(&mut self, params: HttpPutParams) -> Promise<HttpResponse>;
     fn init_tor_service(&mut self, config: TorConfig) -> Promise<Boolean>;
+    fn open_stream(&mut self, params: OpenStreamParams) -> Promise<StreamResponse>;
+    fn poll_events(&mut self, wait_ms: f64) -> Promise<String>;
+    fn prewarm(&mut self, params: PrewarmParams) -> Promise<Boolean>;
+    fn respond_http_requests(&mut self, replies_json: &str) -> Promise<Boolean>;
+    fn resume(&mut self, timeout_ms: f64) -> Promise<ResumeResponse>;
+    fn seed_directory_snapshot(&mut self, params: DirectorySnapshotParams) -> Promise<DirectorySnapshotResponse>;
     fn shutdown_service(&mut self) -> Promise<Boolean>;
+    fn start_http_server(&mut self, params: HttpServerParams) -> Promise<HttpServerResponse>;
+    fn start_proxy(&mut self, params: ProxyParams) -> Promise<ProxyResponse>;
     fn start_tor_if_not_running(&mut self, params: StartTorParams) -> Promise<StartTorResponse>;
+    fn stop_http_server(&mut self, server_id: f64) -> Promise<Boolean>;
+    fn stop_proxy(&mut self, address: &str) -> Promise<Boolean>;
+    fn stream_close(&mut self, stream_id: f64) -> Promise<Boolean>;
+    fn stream_read(&mut self, stream_id: f64, max_bytes: f64) -> Promise<StreamReadResponse>;
+    fn stream_shutdown_write(&mut self, stream_id: f64) -> Promise<StreamResponse>;
+    fn stream_write(&mut self, stream_id: f64, data_base64: &str) -> Promise<StreamResponse>;
+    fn suspend(&mut self) -> Promise<Boolean>;
+    fn wait_onion_published(&mut self, params: OnionPublishParams) -> Promise<OnionPublishResponse>;
+    fn web_socket_attach(&mut self, socket_id: f64) -> Promise<Boolean>;
+    fn web_socket_close(&mut self, socket_id: f64, code: f64, reason: &str) -> Promise<Boolean>;
+    fn web_socket_connect(&mut self, params: WebSocketParams) -> Promise<WebSocketResponse>;
+    fn web_socket_send(&mut self, socket_id: f64, data: &str, binary: bool) -> Promise<Boolean>;
 }
 
 impl Default for HiddenServiceResponse {
@@ -25,7 +53,8 @@ impl Default for HiddenServiceResponse {
         HiddenServiceResponse {
             is_success: false,
             onion_address: String::default(),
-            control: String::default()
+            control: String::default(),
+            error: String::default()
         }
     }
 }
@@ -36,6 +65,7 @@ impl Default for StartTorResponse {
             is_success: false,
             onion_address: String::default(),
             control: String::default(),
+            socks_port: 0.0,
             error_message: String::default(),
             onion_addresses_json: String::default()
         }
@@ -47,7 +77,10 @@ impl Default for HttpDeleteParams {
         HttpDeleteParams {
             url: String::default(),
             headers: String::default(),
-            timeout_ms: 0.0
+            timeout_ms: 0.0,
+            accept_encoding: String::default(),
+            isolation: String::default(),
+            fresh_circuit: false
         }
     }
 }
@@ -58,7 +91,10 @@ impl Default for HttpPostParams {
             url: String::default(),
             body: String::default(),
             headers: String::default(),
-            timeout_ms: 0.0
+            timeout_ms: 0.0,
+            accept_encoding: String::default(),
+            isolation: String::default(),
+            fresh_circuit: false
         }
     }
 }
@@ -68,7 +104,9 @@ impl Default for TorConfig {
         TorConfig {
             socks_port: 0.0,
             data_dir: String::default(),
-            timeout_ms: 0.0
+            timeout_ms: 0.0,
+            profile: String::default(),
+            torrc_overrides_json: String::default()
         }
     }
 }
@@ -77,7 +115,10 @@ impl Default for HiddenServiceParams {
     fn default() -> Self {
         HiddenServiceParams {
             port: 0.0,
-            target_port: 0.0
+            target_port: 0.0,
+            ports_json: String::default(),
+            accept_streams: false,
+            defenses_json: String::default()
         }
     }
 }
@@ -87,7 +128,12 @@ impl Default for HttpGetParams {
         HttpGetParams {
             url: String::default(),
             headers: String::default(),
-            timeout_ms: 0.0
+            timeout_ms: 0.0,
+            accept_encoding: String::default(),
+            cache: false,
+            hedge_percentile: 0.0,
+            isolation: String::default(),
+            fresh_circuit: false
         }
     }
 }
@@ -99,7 +145,9 @@ impl Default for StartTorParams {
             socks_port: 0.0,
             target_port: 0.0,
             timeout_ms: 0.0,
-            keys_json: String::default()
+            keys_json: String::default(),
+            profile: String::default(),
+            torrc_overrides_json: String::default()
         }
     }
 }
@@ -110,7 +158,10 @@ impl Default for HttpPutParams {
             url: String::default(),
             body: String::default(),
             headers: String::default(),
-            timeout_ms: 0.0
+            timeout_ms: 0.0,
+            accept_encoding: String::default(),
+            isolation: String::default(),
+            fresh_circuit: false
         }
     }
 }
@@ -120,6 +171,179 @@ impl Default for HttpResponse {
         HttpResponse {
             status_code: 0.0,
             body: String::default(),
+            error: String::default(),
+            wire_bytes: 0.0,
+            decoded_bytes: 0.0,
+            cache_status: String::default(),
+            conflux: false
+        }
+    }
+}
+
+impl Default for PrewarmParams {
+    fn default() -> Self {
+        PrewarmParams {
+            targets_json: String::default(),
+            keepalive_ms: 0.0,
+            isolation: String::default()
+        }
+    }
+}
+
+impl Default for DirectorySnapshotParams {
+    fn default() -> Self {
+        DirectorySnapshotParams {
+            data_dir: String::default(),
+            snapshot_dir: String::default()
+        }
+    }
+}
+
+impl Default for DirectorySnapshotResponse {
+    fn default() -> Self {
+        DirectorySnapshotResponse {
+            is_success: false,
+            error: String::default(),
+            valid_until: 0.0
+        }
+    }
+}
+
+impl Default for TorListeners {
+    fn default() -> Self {
+        TorListeners {
+            socks_port: 0.0,
+            socks_socket: String::default(),
+            control: String::default()
+        }
+    }
+}
+
+impl Default for ResumeResponse {
+    fn default() -> Self {
+        ResumeResponse {
+            is_success: false,
+            error: String::default(),
+            resume_ms: 0.0
+        }
+    }
+}
+
+impl Default for OpenStreamParams {
+    fn default() -> Self {
+        OpenStreamParams {
+            host: String::default(),
+            port: 0.0,
+            timeout_ms: 0.0,
+            isolation: String::default()
+        }
+    }
+}
+
+impl Default for StreamResponse {
+    fn default() -> Self {
+        StreamResponse {
+            is_success: false,
+            error: String::default(),
+            stream_id: 0.0
+        }
+    }
+}
+
+impl Default for StreamReadResponse {
+    fn default() -> Self {
+        StreamReadResponse {
+            data_base64: String::default(),
+            eof: false,
+            error: String::default()
+        }
+    }
+}
+
+impl Default for WebSocketParams {
+    fn default() -> Self {
+        WebSocketParams {
+            url: String::default(),
+            headers: String::default(),
+            protocols: String::default(),
+            timeout_ms: 0.0,
+            ping_interval_ms: 0.0,
+            deflate: false,
+            isolation: String::default()
+        }
+    }
+}
+
+impl Default for WebSocketResponse {
+    fn default() -> Self {
+        WebSocketResponse {
+            is_success: false,
+            error: String::default(),
+            socket_id: 0.0,
+            protocol: String::default(),
+            extensions: String::default()
+        }
+    }
+}
+
+impl Default for ProxyParams {
+    fn default() -> Self {
+        ProxyParams {
+            listen: String::default(),
+            isolation: String::default()
+        }
+    }
+}
+
+impl Default for ProxyResponse {
+    fn default() -> Self {
+        ProxyResponse {
+            is_success: false,
+            error: String::default(),
+            address: String::default(),
+            credentials: String::default()
+        }
+    }
+}
+
+impl Default for HttpServerParams {
+    fn default() -> Self {
+        HttpServerParams {
+            listen: String::default(),
+            static_dir: String::default(),
+            routes_json: String::default(),
+            dispatch: false,
+            handler_timeout_ms: 0.0
+        }
+    }
+}
+
+impl Default for HttpServerResponse {
+    fn default() -> Self {
+        HttpServerResponse {
+            is_success: false,
+            error: String::default(),
+            server_id: 0.0,
+            address: String::default()
+        }
+    }
+}
+
+impl Default for OnionPublishParams {
+    fn default() -> Self {
+        OnionPublishParams {
+            onion_address: String::default(),
+            min_hsdirs: 0.0,
+            timeout_ms: 0.0
+        }
+    }
+}
+
+impl Default for OnionPublishResponse {
+    fn default() -> Self {
+        OnionPublishResponse {
+            is_success: false,
+            hsdirs: 0.0,
             error: String::default()
         }
     }
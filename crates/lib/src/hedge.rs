@@ -0,0 +1,272 @@
+use std::{
+    collections::{HashMap, VecDeque},
+    io,
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        mpsc, Mutex,
+    },
+    thread,
+    time::Duration,
+};
+
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use url::Url;
+
+use crate::http::{self, Attempt, Request, Response};
+use crate::socks;
+
+/// Time-to-first-byte samples kept per host.
+const MAX_SAMPLES: usize = 64;
+/// Below this many samples the quantile is not trusted.
+const MIN_SAMPLES: usize = 8;
+/// Hedge delay used until a host has enough samples.
+const DEFAULT_DELAY: Duration = Duration::from_millis(3000);
+const MIN_DELAY: Duration = Duration::from_millis(250);
+
+static LATENCIES: OnceCell<Mutex<HashMap<String, VecDeque<u64>>>> = OnceCell::new();
+static HEDGE_COUNTER: AtomicU64 = AtomicU64::new(0);
+
+fn latencies() -> &'static Mutex<HashMap<String, VecDeque<u64>>> {
+    LATENCIES.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+enum Event {
+    FirstByte(usize),
+    Done(usize, io::Result<Response>),
+}
+
+/// Fetches `request`, hedging it when `percentile` is set.
+///
+/// A hedged request that has not received a first byte once the host's
+/// `percentile` time-to-first-byte has passed is duplicated on another circuit.
+/// Whichever leg answers first wins and the other one is cancelled. Every
+/// fetch feeds the per-host latency samples the delay is derived from.
+pub fn fetch(request: &Request, proxy: &str, percentile: Option<f64>) -> io::Result<Response> {
+    let host = host_key(&request.url);
+
+    let Some(percentile) = percentile else {
+        let attempt = Attempt::new();
+        let result = http::fetch(request, proxy, &attempt);
+        if let Some(ttfb) = attempt.first_byte() {
+            record(&host, ttfb);
+        }
+        return result;
+    };
+
+    let delay = hedge_delay(&host, percentile).min(request.timeout);
+    let (tx, rx) = mpsc::channel::<Event>();
+    let mut legs = vec![spawn_leg(0, request.clone(), proxy, tx.clone())];
+
+    let mut winner = match rx.recv_timeout(delay) {
+        Ok(Event::Done(_, result)) => {
+            if let Some(ttfb) = legs[0].first_byte() {
+                record(&host, ttfb);
+            }
+            return result;
+        }
+        Ok(Event::FirstByte(leg)) => Some(leg),
+        Err(_) => None,
+    };
+
+    if winner.is_none() {
+        debug!("http hedging {} after {:?}", host, delay);
+        let mut hedged = request.clone();
+        hedged.socks_auth = Some(hedge_auth(request.socks_auth.as_ref()));
+        legs.push(spawn_leg(1, hedged, proxy, tx.clone()));
+    }
+    drop(tx);
+
+    let mut pending = legs.len();
+    let mut last_error = None;
+
+    while pending > 0 {
+        let event = match rx.recv() {
+            Ok(event) => event,
+            Err(_) => break,
+        };
+
+        match event {
+            Event::FirstByte(leg) => {
+                if winner.is_none() {
+                    winner = Some(leg);
+                    cancel_others(&legs, leg, &host);
+                }
+            }
+            Event::Done(leg, result) => {
+                pending -= 1;
+                if let Some(ttfb) = legs[leg].first_byte() {
+                    record(&host, ttfb);
+                }
+
+                match result {
+                    Ok(response) if winner.is_none() || winner == Some(leg) => {
+                        debug!("http hedge for {} won by leg {}", host, leg);
+                        cancel_others(&legs, leg, &host);
+                        return Ok(response);
+                    }
+                    Err(e) if winner == Some(leg) => return Err(e),
+                    Err(e) => last_error = Some(e),
+                    Ok(_) => {}
+                }
+            }
+        }
+    }
+
+    Err(last_error.unwrap_or_else(|| io::Error::other("Hedged request failed")))
+}
+
+fn spawn_leg(leg: usize, request: Request, proxy: &str, events: mpsc::Sender<Event>) -> Attempt {
+    let attempt = Attempt::new();
+
+    let first_byte = events.clone();
+    attempt.on_first_byte(move || {
+        let _ = first_byte.send(Event::FirstByte(leg));
+    });
+
+    let proxy = proxy.to_string();
+    let leg_attempt = attempt.clone();
+    thread::spawn(move || {
+        let result = http::fetch(&request, &proxy, &leg_attempt);
+        let _ = events.send(Event::Done(leg, result));
+    });
+
+    attempt
+}
+
+fn cancel_others(legs: &[Attempt], winner: usize, host: &str) {
+    for (leg, attempt) in legs.iter().enumerate() {
+        if leg == winner || attempt.is_cancelled() {
+            continue;
+        }
+        // A slow leg still tells us something: its first byte took at least
+        // this long.
+        if attempt.first_byte().is_none() {
+            record(host, attempt.elapsed());
+        }
+        attempt.cancel();
+    }
+}
+
+/// Credentials for a hedge leg, distinct from the primary so Tor puts the
+/// stream on a different circuit.
+fn hedge_auth(primary: Option<&socks::Auth>) -> socks::Auth {
+    let id = HEDGE_COUNTER.fetch_add(1, Ordering::Relaxed);
+    let username = match primary {
+        Some(auth) => format!("{}#hedge-{}", auth.username, id),
+        None => format!("hedge-{}", id),
+    };
+    socks::Auth {
+        username,
+        password: "hedge".to_string(),
+    }
+}
+
+/// Delay before hedging: the `percentile` of the host's recent TTFB samples.
+fn hedge_delay(host: &str, percentile: f64) -> Duration {
+    let latencies = latencies().lock().unwrap();
+    let Some(samples) = latencies.get(host).filter(|s| s.len() >= MIN_SAMPLES) else {
+        return DEFAULT_DELAY;
+    };
+
+    let mut sorted: Vec<u64> = samples.iter().copied().collect();
+    sorted.sort_unstable();
+
+    let rank = (percentile.clamp(0.0, 100.0) / 100.0 * (sorted.len() - 1) as f64).round() as usize;
+    Duration::from_millis(sorted[rank]).max(MIN_DELAY)
+}
+
+fn record(host: &str, ttfb: Duration) {
+    let mut latencies = latencies().lock().unwrap();
+    let samples = latencies.entry(host.to_string()).or_default();
+    if samples.len() == MAX_SAMPLES {
+        samples.pop_front();
+    }
+    samples.push_back(ttfb.as_millis() as u64);
+}
+
+fn host_key(url: &str) -> String {
+    Url::parse(url)
+        .ok()
+        .and_then(|url| {
+            let host = url.host_str()?.to_ascii_lowercase();
+            Some(format!(
+                "{}:{}",
+                host,
+                url.port_or_known_default().unwrap_or(0)
+            ))
+        })
+        .unwrap_or_default()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn record_millis(host: &str, samples: impl IntoIterator<Item = u64>) {
+        for ms in samples {
+            record(host, Duration::from_millis(ms));
+        }
+    }
+
+    #[test]
+    fn waits_the_default_until_enough_samples() {
+        let host = "few.example:443";
+        assert_eq!(hedge_delay(host, 95.0), DEFAULT_DELAY);
+        record_millis(host, [900; MIN_SAMPLES - 1]);
+        assert_eq!(hedge_delay(host, 95.0), DEFAULT_DELAY);
+        record(host, Duration::from_millis(900));
+        assert_eq!(hedge_delay(host, 95.0), Duration::from_millis(900));
+    }
+
+    #[test]
+    fn picks_the_percentile_of_recent_samples() {
+        let host = "percentile.example:443";
+        // 1000, 2000, ..., 20000 in shuffled order.
+        record_millis(host, (1..=20).map(|i| (i * 7 % 20 + 1) * 1000));
+
+        assert_eq!(hedge_delay(host, 0.0), Duration::from_millis(1000));
+        assert_eq!(hedge_delay(host, 50.0), Duration::from_millis(11000));
+        assert_eq!(hedge_delay(host, 95.0), Duration::from_millis(19000));
+        assert_eq!(hedge_delay(host, 100.0), Duration::from_millis(20000));
+        // Out of range percentiles are clamped.
+        assert_eq!(hedge_delay(host, 250.0), Duration::from_millis(20000));
+        assert_eq!(hedge_delay(host, -5.0), Duration::from_millis(1000));
+    }
+
+    #[test]
+    fn keeps_only_the_latest_samples() {
+        let host = "window.example:443";
+        record_millis(host, [60_000; MAX_SAMPLES]);
+        record_millis(host, [2000; MAX_SAMPLES]);
+        assert_eq!(hedge_delay(host, 100.0), Duration::from_millis(2000));
+        assert_eq!(latencies().lock().unwrap()[host].len(), MAX_SAMPLES);
+    }
+
+    #[test]
+    fn never_hedges_sooner_than_the_minimum() {
+        let host = "fast.example:443";
+        record_millis(host, [10; MIN_SAMPLES]);
+        assert_eq!(hedge_delay(host, 95.0), MIN_DELAY);
+    }
+
+    #[test]
+    fn hedge_legs_get_their_own_credentials() {
+        let primary = socks::Auth {
+            username: "wallet".to_string(),
+            password: "secret".to_string(),
+        };
+        let first = hedge_auth(Some(&primary));
+        let second = hedge_auth(Some(&primary));
+        assert!(first.username.starts_with("wallet#hedge-"));
+        assert_ne!(first.username, second.username);
+        assert!(hedge_auth(None).username.starts_with("hedge-"));
+    }
+
+    #[test]
+    fn keys_hosts_by_name_and_port() {
+        assert_eq!(host_key("https://Example.com/a"), "example.com:443");
+        assert_eq!(host_key("http://example.onion:8080/"), "example.onion:8080");
+        assert_eq!(host_key("not a url"), "");
+    }
+}
@@ -0,0 +1,306 @@
+use std::{
+    collections::HashMap,
+    fs,
+    path::{Path, PathBuf},
+    sync::Mutex,
+    thread,
+    time::Duration,
+};
+
+use base64::{engine::general_purpose::STANDARD, Engine};
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use serde::{Deserialize, Serialize};
+
+use crate::datetime::now_secs;
+use crate::{control, tor};
+
+const STATE_FILE: &str = "rn-onion-descriptors.json";
+const BOOTSTRAP_POLL: Duration = Duration::from_millis(250);
+const BOOTSTRAP_WAIT: Duration = Duration::from_secs(120);
+const CERT_BEGIN: &str = "-----BEGIN ED25519 CERT-----";
+const CERT_END: &str = "-----END ED25519 CERT-----";
+
+/// Onion services visited this session or restored from disk, mapped to the
+/// Unix time their descriptor stops being valid (0 when not known yet).
+static VISITED: OnceCell<Mutex<HashMap<String, u64>>> = OnceCell::new();
+
+#[derive(Serialize, Deserialize)]
+struct SavedDescriptor {
+    onion: String,
+    expires_at: u64,
+}
+
+fn visited() -> &'static Mutex<HashMap<String, u64>> {
+    VISITED.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+/// Notes that a request reached `host`, so its descriptor is kept on shutdown.
+pub fn remember(host: &str) {
+    let host = host.to_ascii_lowercase();
+    if let Some(onion) = host.strip_suffix(".onion") {
+        // Subdomains of an onion service share its descriptor.
+        let onion = onion.rsplit('.').next().unwrap_or(onion);
+        visited()
+            .lock()
+            .unwrap()
+            .entry(onion.to_string())
+            .or_insert(0);
+    }
+}
+
+/// Records which client descriptors Tor holds and until when they are valid.
+///
+/// Tor's control protocol can read the client descriptor cache but offers no
+/// way to load descriptors back into it, so only the onion addresses and
+/// validity windows are persisted; [`restore`] refetches them.
+pub fn save(control_port: &str, data_dir: &str) {
+    let now = now_secs();
+    let onions: Vec<(String, u64)> = visited()
+        .lock()
+        .unwrap()
+        .iter()
+        .map(|(onion, expires_at)| (onion.clone(), *expires_at))
+        .collect();
+
+    let mut saved = Vec::new();
+    for (onion, known_expiry) in onions {
+        let descriptor = control::with_controller(control_port, |c| {
+            c.get_info(&format!("hs/client/desc/id/{}", onion))
+        });
+
+        let expires_at = match descriptor {
+            Ok(descriptor) => descriptor_expiry(&descriptor, now).unwrap_or(known_expiry),
+            Err(_) => known_expiry,
+        };
+
+        if expires_at > now {
+            saved.push(SavedDescriptor { onion, expires_at });
+        }
+    }
+
+    let path = state_path(data_dir);
+    let result = serde_json::to_vec(&saved)
+        .map_err(std::io::Error::other)
+        .and_then(|bytes| fs::write(&path, bytes));
+
+    match result {
+        Ok(()) => debug!("Rust FFI: Saved {} onion descriptors", saved.len()),
+        Err(e) => debug!("Rust FFI: Failed to save onion descriptors {:?}", e),
+    }
+}
+
+/// Refetches still valid descriptors saved by [`save`] in the background.
+///
+/// Fetching starts as soon as Tor has bootstrapped, so the first request to a
+/// previously visited onion service finds the descriptor already cached.
+pub fn restore(data_dir: &str) {
+    let saved: Vec<SavedDescriptor> = match fs::read(state_path(data_dir)) {
+        Ok(bytes) => serde_json::from_slice(&bytes).unwrap_or_default(),
+        Err(_) => return,
+    };
+
+    let now = now_secs();
+    let onions: Vec<String> = {
+        let mut visited = visited().lock().unwrap();
+        saved
+            .into_iter()
+            .filter(|entry| entry.expires_at > now)
+            .map(|entry| {
+                visited.insert(entry.onion.clone(), entry.expires_at);
+                entry.onion
+            })
+            .collect()
+    };
+
+    if onions.is_empty() {
+        return;
+    }
+
+    thread::spawn(move || {
+        let mut waited = Duration::ZERO;
+        while tor::bootstrapped_socks_proxy().is_none() {
+            if waited >= BOOTSTRAP_WAIT {
+                return;
+            }
+            thread::sleep(BOOTSTRAP_POLL);
+            waited += BOOTSTRAP_POLL;
+        }
+
+        let Some(control_port) = tor::control_port() else {
+            return;
+        };
+
+        for onion in onions {
+            // HSFETCH returns immediately; Tor caches the descriptor when the
+            // fetch completes.
+            let result = control::with_controller(&control_port, |c| {
+                c.command(&format!("HSFETCH {}", onion))
+            });
+            debug!(
+                "Rust FFI: Prefetching descriptor for {} {:?}",
+                onion,
+                result.is_ok()
+            );
+        }
+    });
+}
+
+/// Expiry of a v3 descriptor: the earlier of its lifetime (counted from now,
+/// since the fetch time is unknown) and its signing certificate's expiry.
+fn descriptor_expiry(descriptor: &str, now: u64) -> Option<u64> {
+    let lifetime_minutes: u64 = descriptor
+        .lines()
+        .find_map(|line| line.strip_prefix("descriptor-lifetime "))
+        .and_then(|value| value.trim().parse().ok())?;
+    let lifetime_expiry = now.saturating_add(lifetime_minutes.saturating_mul(60));
+
+    Some(match signing_cert_expiry(descriptor) {
+        Some(cert_expiry) => lifetime_expiry.min(cert_expiry),
+        None => lifetime_expiry,
+    })
+}
+
+/// Reads the expiration (hours since the epoch) of the Ed25519 certificate
+/// following `descriptor-signing-key-cert` (cert-spec §2.1).
+fn signing_cert_expiry(descriptor: &str) -> Option<u64> {
+    let start = descriptor.find("descriptor-signing-key-cert")?;
+    let block = &descriptor[start..];
+    let block = &block[block.find(CERT_BEGIN)? + CERT_BEGIN.len()..];
+    let end = block.find(CERT_END)?;
+
+    let encoded: String = block[..end].split_whitespace().collect();
+    let cert = STANDARD.decode(encoded).ok()?;
+    // VERSION is 1; other versions may lay the fields out differently.
+    if cert.len() < 6 || cert[0] != 1 {
+        return None;
+    }
+
+    let hours = u32::from_be_bytes([cert[2], cert[3], cert[4], cert[5]]) as u64;
+    Some(hours * 3600)
+}
+
+fn state_path(data_dir: &str) -> PathBuf {
+    Path::new(data_dir).join(STATE_FILE)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// A signing key certificate expiring `hours` after the epoch, in the
+    /// layout of cert-spec §2.1 with one signed-with-key extension.
+    fn cert(version: u8, hours: u32) -> Vec<u8> {
+        let mut cert = vec![version, 0x08];
+        cert.extend_from_slice(&hours.to_be_bytes());
+        cert.push(0x01);
+        cert.extend_from_slice(&[0xaa; 32]);
+        cert.extend_from_slice(&[0x01, 0x00, 0x20, 0x04, 0x00]);
+        cert.extend_from_slice(&[0xbb; 32]);
+        cert.extend_from_slice(&[0xcc; 64]);
+        cert
+    }
+
+    /// The outer layer of a v3 descriptor around `cert`, wrapped at 64
+    /// columns like Tor does.
+    fn descriptor(lifetime: &str, cert: &[u8]) -> String {
+        let encoded = STANDARD.encode(cert);
+        let lines: Vec<&str> = encoded
+            .as_bytes()
+            .chunks(64)
+            .map(|line| std::str::from_utf8(line).unwrap())
+            .collect();
+        format!(
+            "hs-descriptor 3\ndescriptor-lifetime {}\n\
+             descriptor-signing-key-cert\n{}\n{}\n{}\nrevision-counter 7\n",
+            lifetime,
+            CERT_BEGIN,
+            lines.join("\n"),
+            CERT_END
+        )
+    }
+
+    #[test]
+    fn reads_signing_cert_expiry() {
+        assert_eq!(
+            signing_cert_expiry(&descriptor("180", &cert(1, 475_000))),
+            Some(475_000 * 3600)
+        );
+        assert_eq!(
+            signing_cert_expiry(&descriptor("180", &cert(1, u32::MAX))),
+            Some(u64::from(u32::MAX) * 3600)
+        );
+        // Only the first six bytes are needed.
+        assert_eq!(
+            signing_cert_expiry(&descriptor("180", &cert(1, 5)[..6])),
+            Some(5 * 3600)
+        );
+    }
+
+    #[test]
+    fn rejects_malformed_certs() {
+        let valid = descriptor("180", &cert(1, 475_000));
+        for broken in [
+            String::new(),
+            valid.replace("descriptor-signing-key-cert", "signing-key-cert"),
+            valid.replace(CERT_BEGIN, ""),
+            valid.replace(CERT_END, ""),
+            descriptor("180", &cert(1, 475_000)[..5]),
+            descriptor("180", &cert(2, 475_000)),
+            descriptor("180", b""),
+            format!(
+                "descriptor-signing-key-cert\n{}\nAQg*\n{}\n",
+                CERT_BEGIN, CERT_END
+            ),
+            // The end marker before the start one.
+            format!(
+                "descriptor-signing-key-cert\n{}\n{}\nAQgAB0/YAQ==\n",
+                CERT_END, CERT_BEGIN
+            ),
+        ] {
+            assert_eq!(signing_cert_expiry(&broken), None, "{:?}", broken);
+        }
+    }
+
+    #[test]
+    fn expiry_is_the_earlier_of_lifetime_and_cert() {
+        let now = 475_000 * 3600;
+        let later = descriptor("180", &cert(1, 475_010));
+        assert_eq!(descriptor_expiry(&later, now), Some(now + 180 * 60));
+
+        let sooner = descriptor("720", &cert(1, 475_001));
+        assert_eq!(descriptor_expiry(&sooner, now), Some(now + 3600));
+
+        let no_cert = "hs-descriptor 3\ndescriptor-lifetime 10\n";
+        assert_eq!(descriptor_expiry(no_cert, now), Some(now + 600));
+
+        let huge = descriptor("18446744073709551615", &cert(1, u32::MAX));
+        assert_eq!(
+            descriptor_expiry(&huge, now),
+            Some(u64::from(u32::MAX) * 3600)
+        );
+    }
+
+    #[test]
+    fn expiry_needs_a_lifetime() {
+        let now = 1_000;
+        for lifetime in ["", "-5", "ten", "1.5"] {
+            let descriptor = descriptor(lifetime, &cert(1, 475_000));
+            assert_eq!(descriptor_expiry(&descriptor, now), None, "{:?}", lifetime);
+        }
+        assert_eq!(descriptor_expiry("hs-descriptor 3\n", now), None);
+    }
+
+    #[test]
+    fn remembers_onion_hosts_only() {
+        remember("Sub.ABC.onion");
+        remember("abc.onion");
+        remember("example.com");
+        remember("def.onion");
+
+        let visited = visited().lock().unwrap();
+        let mut onions: Vec<&String> = visited.keys().collect();
+        onions.sort();
+        assert_eq!(onions, ["abc", "def"]);
+    }
+}
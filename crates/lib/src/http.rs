@@ -0,0 +1,777 @@
+use std::{
+    cell::Cell,
+    cmp,
+    io::{self, BufRead, BufReader, Read, Write},
+    net::Shutdown,
+    sync::{
+        atomic::{AtomicBool, Ordering},
+        Arc, Mutex,
+    },
+    time::{Duration, Instant},
+};
+
+use once_cell::sync::OnceCell;
+use rustls::{pki_types::ServerName, ClientConfig, ClientConnection, StreamOwned};
+use url::{Host, Url};
+
+use crate::{encoding, socks};
+
+const MAX_REDIRECTS: usize = 10;
+pub const MAX_HEADER_BYTES: usize = 64 * 1024;
+/// Largest response body kept in memory, counted after content decoding so
+/// a small compressed body cannot expand without bound.
+pub const MAX_BODY_BYTES: u64 = 64 * 1024 * 1024;
+
+static TLS_CONFIG: OnceCell<Arc<ClientConfig>> = OnceCell::new();
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum Method {
+    GET,
+    POST,
+    PUT,
+    DELETE,
+}
+
+impl Method {
+    pub fn as_str(&self) -> &'static str {
+        match self {
+            Method::GET => "GET",
+            Method::POST => "POST",
+            Method::PUT => "PUT",
+            Method::DELETE => "DELETE",
+        }
+    }
+}
+
+#[derive(Debug, Clone)]
+pub struct Request {
+    pub url: String,
+    pub method: Method,
+    pub headers: Vec<(String, String)>,
+    pub body: Option<Vec<u8>>,
+    /// Limit for the whole fetch: connecting, every redirect and the body.
+    pub timeout: Duration,
+    /// Codings to advertise in `Accept-Encoding`, see [`encoding::accept_encoding`].
+    pub accept_encoding: String,
+    /// SOCKS credentials, which select the circuit the request is sent on.
+    pub socks_auth: Option<socks::Auth>,
+}
+
+#[derive(Debug, Clone)]
+pub struct Response {
+    pub status_code: u16,
+    pub headers: Vec<(String, String)>,
+    /// Decoded body.
+    pub body: Vec<u8>,
+    /// Body bytes as received, before content decoding (excluding chunk framing).
+    pub wire_bytes: u64,
+}
+
+impl Response {
+    pub fn header(&self, name: &str) -> Option<&str> {
+        find_header(&self.headers, name)
+    }
+}
+
+pub fn find_header<'a>(headers: &'a [(String, String)], name: &str) -> Option<&'a str> {
+    headers
+        .iter()
+        .find(|(key, _)| key.eq_ignore_ascii_case(name))
+        .map(|(_, value)| value.as_str())
+}
+
+/// Handle on an in-flight fetch, used to observe its progress and abort it.
+#[derive(Clone)]
+pub struct Attempt {
+    inner: Arc<AttemptState>,
+}
+
+struct AttemptState {
+    started: Instant,
+    cancelled: AtomicBool,
+    first_byte: Mutex<Option<Duration>>,
+    on_first_byte: Mutex<Option<Box<dyn FnOnce() + Send>>>,
+    stream: Mutex<Option<socks::Stream>>,
+}
+
+impl Attempt {
+    pub fn new() -> Attempt {
+        Attempt {
+            inner: Arc::new(AttemptState {
+                started: Instant::now(),
+                cancelled: AtomicBool::new(false),
+                first_byte: Mutex::new(None),
+                on_first_byte: Mutex::new(None),
+                stream: Mutex::new(None),
+            }),
+        }
+    }
+
+    /// Time from the start of the attempt to the first response byte.
+    pub fn first_byte(&self) -> Option<Duration> {
+        *self.inner.first_byte.lock().unwrap()
+    }
+
+    pub fn elapsed(&self) -> Duration {
+        self.inner.started.elapsed()
+    }
+
+    /// Registers a callback run once, when the first response byte arrives.
+    pub fn on_first_byte<F: FnOnce() + Send + 'static>(&self, callback: F) {
+        *self.inner.on_first_byte.lock().unwrap() = Some(Box::new(callback));
+    }
+
+    /// Aborts the attempt by shutting its socket down; the fetch then fails.
+    pub fn cancel(&self) {
+        self.inner.cancelled.store(true, Ordering::SeqCst);
+        if let Some(stream) = self.inner.stream.lock().unwrap().take() {
+            let _ = stream.shutdown(Shutdown::Both);
+        }
+    }
+
+    pub fn is_cancelled(&self) -> bool {
+        self.inner.cancelled.load(Ordering::SeqCst)
+    }
+
+    fn register(&self, stream: &socks::Stream) -> io::Result<()> {
+        let mut slot = self.inner.stream.lock().unwrap();
+        if self.is_cancelled() {
+            return Err(cancelled());
+        }
+        *slot = Some(stream.try_clone()?);
+        Ok(())
+    }
+
+    fn mark_first_byte(&self) {
+        let mut first_byte = self.inner.first_byte.lock().unwrap();
+        if first_byte.is_some() {
+            return;
+        }
+        *first_byte = Some(self.inner.started.elapsed());
+        drop(first_byte);
+
+        if let Some(callback) = self.inner.on_first_byte.lock().unwrap().take() {
+            callback();
+        }
+    }
+}
+
+fn cancelled() -> io::Error {
+    io::Error::new(io::ErrorKind::Interrupted, "Request cancelled")
+}
+
+/// Performs `request` through the SOCKS proxy at `proxy`, following redirects.
+///
+/// Progress is reported to `attempt`, which can also be used to cancel it.
+/// The fetch fails once `request.timeout` has passed, however far it got.
+pub fn fetch(request: &Request, proxy: &str, attempt: &Attempt) -> io::Result<Response> {
+    let deadline = Instant::now() + request.timeout;
+    let mut url =
+        Url::parse(&request.url).map_err(|e| invalid_input(format!("Invalid URL: {}", e)))?;
+    let mut method = request.method;
+    let mut body = request.body.clone();
+    let mut headers = request.headers.clone();
+
+    for _ in 0..=MAX_REDIRECTS {
+        let response = send(
+            &url,
+            method,
+            &headers,
+            body.as_deref(),
+            request,
+            proxy,
+            attempt,
+            deadline,
+        )?;
+
+        let location = match response.status_code {
+            301 | 302 | 303 | 307 | 308 => response.header("location"),
+            _ => None,
+        };
+        let Some(location) = location else {
+            return Ok(response);
+        };
+
+        let next = url.join(location).map_err(|e| {
+            io::Error::new(
+                io::ErrorKind::InvalidData,
+                format!("Invalid redirect: {}", e),
+            )
+        })?;
+
+        if response.status_code == 303
+            || (matches!(response.status_code, 301 | 302) && method == Method::POST)
+        {
+            method = Method::GET;
+            body = None;
+        }
+        if next.host_str() != url.host_str() {
+            headers.retain(|(key, _)| {
+                !key.eq_ignore_ascii_case("authorization") && !key.eq_ignore_ascii_case("cookie")
+            });
+        }
+        url = next;
+    }
+
+    Err(io::Error::other("Too many redirects"))
+}
+
+fn send(
+    url: &Url,
+    method: Method,
+    headers: &[(String, String)],
+    body: Option<&[u8]>,
+    request: &Request,
+    proxy: &str,
+    attempt: &Attempt,
+    deadline: Instant,
+) -> io::Result<Response> {
+    let host = match url.host() {
+        Some(Host::Domain(domain)) => domain.to_string(),
+        Some(Host::Ipv4(addr)) => addr.to_string(),
+        Some(Host::Ipv6(addr)) => addr.to_string(),
+        None => return Err(invalid_input("URL has no host".to_string())),
+    };
+    let port = url
+        .port_or_known_default()
+        .ok_or_else(|| invalid_input(format!("Unsupported URL scheme: {}", url.scheme())))?;
+
+    let stream = socks::open(proxy, remaining(deadline)?)?;
+    attempt.register(&stream)?;
+    let stream = socks::negotiate(stream, &host, port, request.socks_auth.as_ref())?;
+    let stream = Timed { stream, deadline };
+    let mut conn = match url.scheme() {
+        "http" => Connection::Plain(stream),
+        "https" => Connection::Tls(Box::new(tls_connect(&host, stream)?)),
+        scheme => return Err(invalid_input(format!("Unsupported URL scheme: {}", scheme))),
+    };
+
+    write_request(
+        &mut conn,
+        url,
+        method,
+        headers,
+        body,
+        &request.accept_encoding,
+    )?;
+    conn.flush()?;
+
+    let mut reader = BufReader::new(conn);
+    if reader.fill_buf()?.is_empty() {
+        if attempt.is_cancelled() {
+            return Err(cancelled());
+        }
+    } else {
+        attempt.mark_first_byte();
+    }
+
+    read_response(reader)
+}
+
+fn write_request<W: Write>(
+    out: &mut W,
+    url: &Url,
+    method: Method,
+    headers: &[(String, String)],
+    body: Option<&[u8]>,
+    accept_encoding: &str,
+) -> io::Result<()> {
+    let mut target = url.path().to_string();
+    if let Some(query) = url.query() {
+        target.push('?');
+        target.push_str(query);
+    }
+
+    let mut head = format!("{} {} HTTP/1.1\r\n", method.as_str(), target);
+
+    let host = url.host_str().unwrap_or_default();
+    match url.port() {
+        Some(port) => head.push_str(&format!("Host: {}:{}\r\n", host, port)),
+        None => head.push_str(&format!("Host: {}\r\n", host)),
+    }
+
+    for (key, value) in headers {
+        if is_managed_header(key) {
+            continue;
+        }
+        head.push_str(&format!("{}: {}\r\n", key, value));
+    }
+
+    if find_header(headers, "accept-encoding").is_none() {
+        if let Some(codings) = encoding::accept_encoding(accept_encoding) {
+            head.push_str(&format!("Accept-Encoding: {}\r\n", codings));
+        }
+    }
+
+    match body {
+        Some(body) => head.push_str(&format!("Content-Length: {}\r\n", body.len())),
+        None if matches!(method, Method::POST | Method::PUT) => {
+            head.push_str("Content-Length: 0\r\n")
+        }
+        None => {}
+    }
+    head.push_str("Connection: close\r\n\r\n");
+
+    out.write_all(head.as_bytes())?;
+    if let Some(body) = body {
+        out.write_all(body)?;
+    }
+    Ok(())
+}
+
+/// Headers the client derives itself; caller supplied values are dropped.
+fn is_managed_header(name: &str) -> bool {
+    ["host", "content-length", "connection", "transfer-encoding"]
+        .iter()
+        .any(|managed| managed.eq_ignore_ascii_case(name))
+}
+
+fn read_response<R: BufRead>(mut reader: R) -> io::Result<Response> {
+    let (status_code, headers) = loop {
+        let (status_code, headers) = read_head(&mut reader)?;
+        // Skip interim responses such as 100 Continue.
+        if (100..200).contains(&status_code) && status_code != 101 {
+            continue;
+        }
+        break (status_code, headers);
+    };
+
+    let has_body = !matches!(status_code, 100..=199 | 204 | 304);
+    let chunked = find_header(&headers, "transfer-encoding")
+        .map(|te| te.to_ascii_lowercase().contains("chunked"))
+        .unwrap_or(false);
+    let content_length =
+        find_header(&headers, "content-length").and_then(|len| len.trim().parse::<u64>().ok());
+    let content_encoding = find_header(&headers, "content-encoding")
+        .unwrap_or("")
+        .to_string();
+
+    let wire_bytes = Cell::new(0u64);
+    let mut body = Vec::new();
+
+    if has_body {
+        let framed: Box<dyn Read + '_> = if chunked {
+            Box::new(ChunkedReader::new(&mut reader))
+        } else if let Some(len) = content_length {
+            Box::new((&mut reader).take(len))
+        } else {
+            Box::new(&mut reader)
+        };
+
+        let counted = CountingReader {
+            inner: framed,
+            count: &wire_bytes,
+        };
+
+        let decoded = encoding::decode(&content_encoding, Box::new(counted))?;
+        decoded.take(MAX_BODY_BYTES + 1).read_to_end(&mut body)?;
+        if body.len() as u64 > MAX_BODY_BYTES {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidData,
+                format!("Response body larger than {} bytes", MAX_BODY_BYTES),
+            ));
+        }
+    }
+
+    Ok(Response {
+        status_code,
+        headers,
+        body,
+        wire_bytes: wire_bytes.get(),
+    })
+}
+
+pub fn read_head<R: BufRead>(reader: &mut R) -> io::Result<(u16, Vec<(String, String)>)> {
+    let mut line = String::new();
+    let total = read_line(reader, &mut line)?;
+    let status_code = line
+        .split_whitespace()
+        .nth(1)
+        .and_then(|code| code.parse::<u16>().ok())
+        .filter(|_| line.starts_with("HTTP/"))
+        .ok_or_else(|| io::Error::new(io::ErrorKind::InvalidData, "Invalid HTTP status line"))?;
+
+    let headers = read_headers(reader, total)?;
+    Ok((status_code, headers))
+}
+
+/// Request line and headers of a request received by the proxy or server.
+pub struct RequestHead {
+    pub method: String,
+    pub target: String,
+    pub version: String,
+    pub headers: Vec<(String, String)>,
+}
+
+pub fn read_request_head<R: BufRead>(reader: &mut R) -> io::Result<RequestHead> {
+    let mut line = String::new();
+    let total = read_line(reader, &mut line)?;
+    let mut parts = line.split_whitespace();
+    let (Some(method), Some(target), Some(version)) = (parts.next(), parts.next(), parts.next())
+    else {
+        return Err(io::Error::new(
+            io::ErrorKind::InvalidData,
+            "Invalid HTTP request line",
+        ));
+    };
+
+    Ok(RequestHead {
+        method: method.to_string(),
+        target: target.to_string(),
+        version: version.to_string(),
+        headers: read_headers(reader, total)?,
+    })
+}
+
+/// Whether the connection ends after this message, from its `Connection`
+/// header and HTTP version.
+pub fn wants_close(headers: &[(String, String)], version: &str) -> bool {
+    let connection = find_header(headers, "connection")
+        .unwrap_or("")
+        .to_ascii_lowercase();
+    if version == "HTTP/1.0" {
+        !connection.contains("keep-alive")
+    } else {
+        connection.contains("close")
+    }
+}
+
+/// Status line and headers of a response sent by the server, with the
+/// framing headers it manages.
+pub fn response_head(status: u16, headers: &[(&str, &str)], length: u64, close: bool) -> String {
+    let mut head = format!("HTTP/1.1 {} {}\r\n", status, reason(status));
+    for (name, value) in headers {
+        let managed = ["content-length", "transfer-encoding", "connection"]
+            .iter()
+            .any(|managed| name.eq_ignore_ascii_case(managed));
+        if managed || name.contains(['\r', '\n']) || value.contains(['\r', '\n']) {
+            continue;
+        }
+        head.push_str(&format!("{}: {}\r\n", name, value));
+    }
+    head.push_str(&format!("Content-Length: {}\r\n", length));
+    if close {
+        head.push_str("Connection: close\r\n");
+    }
+    head.push_str("\r\n");
+    head
+}
+
+fn reason(status: u16) -> &'static str {
+    match status {
+        200 => "OK",
+        201 => "Created",
+        204 => "No Content",
+        206 => "Partial Content",
+        301 => "Moved Permanently",
+        302 => "Found",
+        304 => "Not Modified",
+        400 => "Bad Request",
+        401 => "Unauthorized",
+        403 => "Forbidden",
+        404 => "Not Found",
+        405 => "Method Not Allowed",
+        413 => "Content Too Large",
+        416 => "Range Not Satisfiable",
+        500 => "Internal Server Error",
+        503 => "Service Unavailable",
+        504 => "Gateway Timeout",
+        _ => "",
+    }
+}
+
+/// Reads header lines up to the blank line that ends a message head.
+///
+/// `total` is the size of the start line already read, counted against
+/// [`MAX_HEADER_BYTES`].
+pub fn read_headers<R: BufRead>(
+    reader: &mut R,
+    mut total: usize,
+) -> io::Result<Vec<(String, String)>> {
+    let mut line = String::new();
+    let mut headers: Vec<(String, String)> = Vec::new();
+    loop {
+        line.clear();
+        total += read_line(reader, &mut line)?;
+        if total > MAX_HEADER_BYTES {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidData,
+                "HTTP header too large",
+            ));
+        }
+
+        let trimmed = line.trim_end_matches(['\r', '\n']);
+        if trimmed.is_empty() {
+            break;
+        }
+
+        // Obsolete line folding continues the previous header value.
+        if trimmed.starts_with([' ', '\t']) {
+            if let Some((_, value)) = headers.last_mut() {
+                value.push(' ');
+                value.push_str(trimmed.trim());
+            }
+            continue;
+        }
+
+        if let Some((key, value)) = trimmed.split_once(':') {
+            headers.push((key.trim().to_string(), value.trim().to_string()));
+        }
+    }
+
+    Ok(headers)
+}
+
+pub fn read_line<R: BufRead>(reader: &mut R, line: &mut String) -> io::Result<usize> {
+    let read = reader.read_line(line)?;
+    if read == 0 {
+        return Err(io::Error::new(
+            io::ErrorKind::UnexpectedEof,
+            "Connection closed before the header was complete",
+        ));
+    }
+    Ok(read)
+}
+
+fn tls_config() -> Arc<ClientConfig> {
+    TLS_CONFIG
+        .get_or_init(|| {
+            let mut roots = rustls::RootCertStore::empty();
+            roots.extend(webpki_roots::TLS_SERVER_ROOTS.iter().cloned());
+
+            let mut config = ClientConfig::builder_with_provider(Arc::new(
+                rustls::crypto::ring::default_provider(),
+            ))
+            .with_safe_default_protocol_versions()
+            .expect("ring provider supports the default protocol versions")
+            .with_root_certificates(roots)
+            .with_no_client_auth();
+            config.alpn_protocols = vec![b"http/1.1".to_vec()];
+
+            Arc::new(config)
+        })
+        .clone()
+}
+
+/// TLS client state for `host`, verified against the bundled web PKI roots.
+pub fn tls_client(host: &str) -> io::Result<ClientConnection> {
+    let server_name = ServerName::try_from(host.to_string())
+        .map_err(|e| invalid_input(format!("Invalid TLS server name: {}", e)))?;
+    ClientConnection::new(tls_config(), server_name).map_err(io::Error::other)
+}
+
+fn tls_connect(host: &str, stream: Timed) -> io::Result<StreamOwned<ClientConnection, Timed>> {
+    Ok(StreamOwned::new(tls_client(host)?, stream))
+}
+
+/// Time left until `deadline`, or a timeout error once it has passed.
+fn remaining(deadline: Instant) -> io::Result<Duration> {
+    let left = deadline.saturating_duration_since(Instant::now());
+    if left.is_zero() {
+        return Err(io::Error::new(io::ErrorKind::TimedOut, "Request timed out"));
+    }
+    Ok(left)
+}
+
+/// A proxied stream whose reads and writes all end by one deadline.
+///
+/// Socket timeouts only bound a single read, so a server dripping bytes could
+/// otherwise hold a request open indefinitely.
+struct Timed {
+    stream: socks::Stream,
+    deadline: Instant,
+}
+
+impl Read for Timed {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        self.stream
+            .set_read_timeout(Some(remaining(self.deadline)?))?;
+        self.stream.read(buf)
+    }
+}
+
+impl Write for Timed {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        self.stream
+            .set_write_timeout(Some(remaining(self.deadline)?))?;
+        self.stream.write(buf)
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        self.stream.flush()
+    }
+}
+
+enum Connection {
+    Plain(Timed),
+    Tls(Box<StreamOwned<ClientConnection, Timed>>),
+}
+
+impl Read for Connection {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        match self {
+            Connection::Plain(stream) => stream.read(buf),
+            // Many servers close without sending close_notify; with
+            // `Connection: close` that is an ordinary end of body.
+            Connection::Tls(stream) => match stream.read(buf) {
+                Err(e) if e.kind() == io::ErrorKind::UnexpectedEof => Ok(0),
+                result => result,
+            },
+        }
+    }
+}
+
+impl Write for Connection {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        match self {
+            Connection::Plain(stream) => stream.write(buf),
+            Connection::Tls(stream) => stream.write(buf),
+        }
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        match self {
+            Connection::Plain(stream) => stream.flush(),
+            Connection::Tls(stream) => stream.flush(),
+        }
+    }
+}
+
+struct CountingReader<'a, R> {
+    inner: R,
+    count: &'a Cell<u64>,
+}
+
+impl<R: Read> Read for CountingReader<'_, R> {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        let read = self.inner.read(buf)?;
+        self.count.set(self.count.get() + read as u64);
+        Ok(read)
+    }
+}
+
+/// Decodes a `Transfer-Encoding: chunked` body.
+pub struct ChunkedReader<R> {
+    inner: R,
+    remaining: u64,
+    done: bool,
+}
+
+impl<R: BufRead> ChunkedReader<R> {
+    pub fn new(inner: R) -> Self {
+        ChunkedReader {
+            inner,
+            remaining: 0,
+            done: false,
+        }
+    }
+
+    fn next_chunk_size(&mut self) -> io::Result<u64> {
+        let mut line = String::new();
+        read_line(&mut self.inner, &mut line)?;
+
+        let size = line.trim().split(';').next().unwrap_or("").trim();
+        u64::from_str_radix(size, 16)
+            .map_err(|_| io::Error::new(io::ErrorKind::InvalidData, "Invalid chunk size"))
+    }
+
+    fn skip_trailers(&mut self) -> io::Result<()> {
+        let mut line = String::new();
+        loop {
+            line.clear();
+            if self.inner.read_line(&mut line)? == 0 || line.trim().is_empty() {
+                return Ok(());
+            }
+        }
+    }
+}
+
+impl<R: BufRead> Read for ChunkedReader<R> {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        if self.done || buf.is_empty() {
+            return Ok(0);
+        }
+
+        if self.remaining == 0 {
+            self.remaining = self.next_chunk_size()?;
+            if self.remaining == 0 {
+                self.skip_trailers()?;
+                self.done = true;
+                return Ok(0);
+            }
+        }
+
+        let max = cmp::min(buf.len() as u64, self.remaining) as usize;
+        let read = self.inner.read(&mut buf[..max])?;
+        if read == 0 {
+            return Err(io::Error::new(
+                io::ErrorKind::UnexpectedEof,
+                "Connection closed inside chunk",
+            ));
+        }
+
+        self.remaining -= read as u64;
+        if self.remaining == 0 {
+            let mut crlf = [0u8; 2];
+            self.inner.read_exact(&mut crlf)?;
+            if &crlf != b"\r\n" {
+                return Err(io::Error::new(
+                    io::ErrorKind::InvalidData,
+                    "Missing CRLF after chunk",
+                ));
+            }
+        }
+
+        Ok(read)
+    }
+}
+
+fn invalid_input(message: String) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidInput, message)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn dechunk(wire: &[u8]) -> io::Result<Vec<u8>> {
+        let mut body = Vec::new();
+        ChunkedReader::new(wire).read_to_end(&mut body)?;
+        Ok(body)
+    }
+
+    #[test]
+    fn chunked_round_trip() {
+        let wire = b"5\r\nhello\r\n1;name=value\r\n \r\nA\r\n0123456789\r\n0\r\n\r\n";
+        assert_eq!(dechunk(wire).unwrap(), b"hello 0123456789");
+    }
+
+    #[test]
+    fn chunked_skips_trailers_and_stops_at_last_chunk() {
+        let wire = b"3\r\nabc\r\n0\r\nExpires: never\r\n\r\nGET / HTTP/1.1\r\n";
+        let mut reader = &wire[..];
+        let mut body = Vec::new();
+        ChunkedReader::new(&mut reader)
+            .read_to_end(&mut body)
+            .unwrap();
+        assert_eq!(body, b"abc");
+        assert_eq!(reader, b"GET / HTTP/1.1\r\n");
+    }
+
+    #[test]
+    fn chunked_empty_body() {
+        assert_eq!(dechunk(b"0\r\n\r\n").unwrap(), b"");
+    }
+
+    #[test]
+    fn chunked_rejects_malformed_input() {
+        let kind = |wire: &[u8]| dechunk(wire).unwrap_err().kind();
+        assert_eq!(kind(b"zz\r\nabc\r\n0\r\n\r\n"), io::ErrorKind::InvalidData);
+        assert_eq!(kind(b"\r\n"), io::ErrorKind::InvalidData);
+        assert_eq!(kind(b"10000000000000000\r\n"), io::ErrorKind::InvalidData);
+        assert_eq!(kind(b"3\r\nabcXY0\r\n\r\n"), io::ErrorKind::InvalidData);
+        assert_eq!(kind(b"5\r\nabc"), io::ErrorKind::UnexpectedEof);
+        assert_eq!(kind(b"3\r\nabc"), io::ErrorKind::UnexpectedEof);
+        assert_eq!(kind(b""), io::ErrorKind::UnexpectedEof);
+    }
+}
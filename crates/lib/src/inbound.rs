@@ -0,0 +1,227 @@
+use std::{
+    io, mem,
+    sync::{
+        atomic::{AtomicBool, Ordering},
+        Arc, Mutex,
+    },
+    thread,
+};
+
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use serde::Serialize;
+
+use crate::events;
+use crate::listener;
+use crate::streams;
+
+static TARGETS: OnceCell<Mutex<Vec<Target>>> = OnceCell::new();
+/// Streams accepted on every target, waiting to be taken by [`take`].
+static ACCEPTED: OnceCell<Mutex<Vec<Accepted>>> = OnceCell::new();
+
+/// Local socket an onion service forwards its inbound streams to.
+struct Target {
+    address: String,
+    /// Address of the onion service, known once `ADD_ONION` returned.
+    onion: Arc<Mutex<String>>,
+    stopped: Arc<AtomicBool>,
+}
+
+/// An inbound onion stream, registered with [`streams`] and delivered to JS
+/// by [`take`].
+#[derive(Serialize)]
+pub struct Accepted {
+    stream_id: u64,
+    onion_address: String,
+    port: u16,
+}
+
+fn targets() -> &'static Mutex<Vec<Target>> {
+    TARGETS.get_or_init(|| Mutex::new(Vec::new()))
+}
+
+fn accepted() -> &'static Mutex<Vec<Accepted>> {
+    ACCEPTED.get_or_init(|| Mutex::new(Vec::new()))
+}
+
+/// Starts accepting the streams Tor forwards to `listen`, a `unix:/path` or
+/// loopback `host:port`, from the virtual `port` of an onion service.
+///
+/// Each connection from Tor is one stream a client opened to the onion
+/// service. It becomes a stream handle right away instead of going through
+/// a server in app code. Returns the address to use as the `ADD_ONION`
+/// target.
+pub fn start(port: u16, listen: &str) -> io::Result<String> {
+    let (listener, address) = listener::bind(listen)?;
+    let onion = Arc::new(Mutex::new(String::new()));
+    let stopped = Arc::new(AtomicBool::new(false));
+    targets().lock().unwrap().push(Target {
+        address: address.clone(),
+        onion: onion.clone(),
+        stopped: stopped.clone(),
+    });
+
+    thread::spawn(move || {
+        listener::accept_loop(
+            listener,
+            &stopped,
+            "Onion target",
+            |socket| match streams::open(socket) {
+                Ok(stream_id) => {
+                    accepted().lock().unwrap().push(Accepted {
+                        stream_id,
+                        onion_address: onion.lock().unwrap().clone(),
+                        port,
+                    });
+                    events::notify();
+                }
+                Err(e) => debug!("Rust FFI: Failed to register onion stream {:?}", e),
+            },
+        );
+    });
+
+    debug!("Rust FFI: Accepting onion streams on {}", address);
+    Ok(address)
+}
+
+/// Labels the streams accepted on `address` with the onion service's address.
+pub fn set_onion(address: &str, onion: &str) {
+    if let Some(target) = targets()
+        .lock()
+        .unwrap()
+        .iter()
+        .find(|target| target.address == address)
+    {
+        *target.onion.lock().unwrap() = onion.to_string();
+    }
+}
+
+/// Stops accepting on `address`. Streams already accepted stay open.
+pub fn stop(address: &str) {
+    let target = {
+        let mut targets = targets().lock().unwrap();
+        match targets.iter().position(|target| target.address == address) {
+            Some(index) => targets.remove(index),
+            None => return,
+        }
+    };
+    target.stopped.store(true, Ordering::Relaxed);
+    listener::wake(&target.address);
+}
+
+/// Stops the targets of the onion service `onion`, one per virtual port.
+pub fn stop_onion(onion: &str) {
+    let addresses: Vec<String> = targets()
+        .lock()
+        .unwrap()
+        .iter()
+        .filter(|target| {
+            target.onion.lock().unwrap().trim_end_matches(".onion")
+                == onion.trim_end_matches(".onion")
+        })
+        .map(|target| target.address.clone())
+        .collect();
+
+    for address in addresses {
+        stop(&address);
+    }
+}
+
+/// Stops every target, e.g. when the service shuts down.
+pub fn stop_all() {
+    let addresses: Vec<String> = targets()
+        .lock()
+        .unwrap()
+        .iter()
+        .map(|target| target.address.clone())
+        .collect();
+
+    for address in addresses {
+        stop(&address);
+    }
+}
+
+/// Takes the streams accepted since the previous call.
+pub fn take() -> Vec<Accepted> {
+    mem::take(&mut *accepted().lock().unwrap())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::{
+        io::{Read, Write},
+        net::TcpStream,
+        time::{Duration, Instant},
+    };
+
+    fn wait_until(mut done: impl FnMut() -> bool) {
+        let deadline = Instant::now() + Duration::from_secs(5);
+        while !done() {
+            assert!(Instant::now() < deadline, "timed out");
+            thread::sleep(Duration::from_millis(5));
+        }
+    }
+
+    fn listening(address: &str) -> bool {
+        targets()
+            .lock()
+            .unwrap()
+            .iter()
+            .any(|target| target.address == address)
+    }
+
+    #[test]
+    fn delivers_connections_as_labelled_streams() {
+        let address = start(8080, "127.0.0.1:0").unwrap();
+        set_onion(&address, "inboundtest.onion");
+
+        let mut client = TcpStream::connect(&address).unwrap();
+        client.write_all(b"hi").unwrap();
+
+        let mut taken = Vec::new();
+        wait_until(|| {
+            taken.extend(take());
+            !taken.is_empty()
+        });
+        assert_eq!(taken.len(), 1);
+        let accepted = &taken[0];
+        assert_eq!(accepted.onion_address, "inboundtest.onion");
+        assert_eq!(accepted.port, 8080);
+
+        let id = accepted.stream_id;
+        let mut data = Vec::new();
+        wait_until(|| {
+            data.extend(streams::read(id, 64).unwrap().data);
+            data == b"hi"
+        });
+
+        // Accepted streams outlive their target.
+        stop(&address);
+        assert!(!listening(&address));
+        streams::write(id, b"ok").unwrap();
+        let mut reply = [0u8; 2];
+        client.read_exact(&mut reply).unwrap();
+        assert_eq!(&reply, b"ok");
+        streams::close(id);
+    }
+
+    #[test]
+    fn stops_every_port_of_an_onion_service() {
+        let http = start(80, "127.0.0.1:0").unwrap();
+        let https = start(443, "127.0.0.1:0").unwrap();
+        let other = start(80, "127.0.0.1:0").unwrap();
+        set_onion(&http, "stoptest.onion");
+        set_onion(&https, "stoptest.onion");
+        set_onion(&other, "otherstoptest.onion");
+
+        stop_onion("stoptest");
+        assert!(!listening(&http));
+        assert!(!listening(&https));
+        assert!(listening(&other));
+        wait_until(|| TcpStream::connect(&http).is_err());
+
+        stop(&other);
+        assert!(!listening(&other));
+    }
+}
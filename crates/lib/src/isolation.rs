@@ -0,0 +1,232 @@
+use std::{
+    collections::{HashMap, VecDeque},
+    io,
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        Mutex,
+    },
+    thread,
+};
+
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use serde::Serialize;
+
+use crate::control::{self, Controller};
+use crate::socks;
+
+/// Label under which requests with `fresh_circuit` are counted.
+const FRESH_KEY: &str = "fresh";
+/// Tor ignores the password, but RFC 1929 requires a non-empty one.
+const SOCKS_PASSWORD: &str = "rn-tor";
+/// Streams remembered for [`used_conflux`]; a request looks its own up right
+/// after its response, so only the latest few are needed.
+const RECENT_STREAMS: usize = 64;
+
+static FRESH_COUNTER: AtomicU64 = AtomicU64::new(0);
+static STATS: OnceCell<Mutex<HashMap<String, KeyStats>>> = OnceCell::new();
+/// Latest streams Tor attached, newest last.
+static RECENT: OnceCell<Mutex<VecDeque<StreamUse>>> = OnceCell::new();
+/// Id of the watcher thread following the running Tor.
+static WATCHER: OnceCell<Mutex<Option<u64>>> = OnceCell::new();
+static NEXT_WATCHER: AtomicU64 = AtomicU64::new(1);
+
+#[derive(Default, Serialize)]
+struct KeyStats {
+    built: u64,
+    reused: u64,
+}
+
+/// A stream Tor attached to a circuit, as reported by a `STREAM` event.
+struct StreamUse {
+    username: Option<String>,
+    /// `host:port` the stream was opened to.
+    target: String,
+    conflux: bool,
+}
+
+/// What a watcher knows about one circuit.
+#[derive(Default)]
+struct Circuit {
+    purpose: String,
+    /// Streams attached so far; the first one is the one it was built for.
+    streams: u64,
+}
+
+fn stats() -> &'static Mutex<HashMap<String, KeyStats>> {
+    STATS.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+fn recent() -> &'static Mutex<VecDeque<StreamUse>> {
+    RECENT.get_or_init(|| Mutex::new(VecDeque::new()))
+}
+
+fn watcher() -> &'static Mutex<Option<u64>> {
+    WATCHER.get_or_init(|| Mutex::new(None))
+}
+
+/// SOCKS credentials for a request.
+///
+/// Requests sharing an `isolation` key share circuits, an empty key uses Tor's
+/// default circuits and `fresh` forces a circuit no other request will use.
+pub fn socks_auth(isolation: &str, fresh: bool) -> Option<socks::Auth> {
+    let username = if fresh {
+        format!("fresh:{}", FRESH_COUNTER.fetch_add(1, Ordering::Relaxed))
+    } else if !isolation.is_empty() {
+        format!("iso:{}", isolation)
+    } else {
+        return None;
+    };
+
+    Some(socks::Auth {
+        username,
+        password: SOCKS_PASSWORD.to_string(),
+    })
+}
+
+/// Follows the circuits and streams of the Tor listening for control
+/// connections on `control_port`.
+///
+/// Runs on a control connection of its own subscribed to `CIRC`,
+/// `CIRC_MINOR` and `STREAM`, so requests never wait for the control port to
+/// learn which circuit they used. The thread ends when Tor closes the
+/// connection.
+pub fn watch(control_port: &str) -> io::Result<()> {
+    if watcher().lock().unwrap().is_some() {
+        return Ok(());
+    }
+
+    let mut controller = Controller::connect(control_port.trim())?;
+    controller.command("SETEVENTS CIRC CIRC_MINOR STREAM")?;
+    controller.set_read_timeout(None)?;
+    let id = NEXT_WATCHER.fetch_add(1, Ordering::Relaxed);
+    *watcher().lock().unwrap() = Some(id);
+
+    thread::spawn(move || {
+        let registered = || *watcher().lock().unwrap() == Some(id);
+        let mut circuits: HashMap<String, Circuit> = HashMap::new();
+        loop {
+            match controller.read_event() {
+                Ok(lines) if registered() => {
+                    for line in lines {
+                        record(&mut circuits, &line.text);
+                    }
+                }
+                Ok(_) => break,
+                Err(e) => {
+                    debug!("Rust FFI: Circuit events ended {:?}", e);
+                    break;
+                }
+            }
+        }
+        let mut watcher = watcher().lock().unwrap();
+        if *watcher == Some(id) {
+            *watcher = None;
+        }
+    });
+    Ok(())
+}
+
+/// Applies one event line to the known circuits and the counters.
+///
+/// `CIRC Id Status ... PURPOSE=...` and `CIRC_MINOR Id Event ... PURPOSE=...`
+/// track each circuit's purpose, which changes to `CONFLUX_LINKED` when it
+/// joins a Conflux set. `STREAM Id SUCCEEDED CircuitId Target ...
+/// SOCKS_USERNAME="..."` attaches a request to a circuit: the first stream on
+/// a circuit counts as building it for the stream's key, later ones as reuse.
+fn record(circuits: &mut HashMap<String, Circuit>, text: &str) {
+    let mut fields = text.split_whitespace();
+    let (Some(event), Some(id), Some(status)) = (fields.next(), fields.next(), fields.next())
+    else {
+        return;
+    };
+    let purpose = || {
+        text.split_whitespace()
+            .find_map(|field| field.strip_prefix("PURPOSE="))
+            .map(str::to_string)
+    };
+
+    match event {
+        "CIRC" if matches!(status, "FAILED" | "CLOSED") => {
+            circuits.remove(id);
+        }
+        "CIRC" | "CIRC_MINOR" => {
+            let circuit = circuits.entry(id.to_string()).or_default();
+            if let Some(purpose) = purpose() {
+                circuit.purpose = purpose;
+            }
+        }
+        "STREAM" if status == "SUCCEEDED" => {
+            let (Some(circuit_id), Some(target)) = (fields.next(), fields.next()) else {
+                return;
+            };
+            let circuit = circuits.entry(circuit_id.to_string()).or_default();
+            circuit.streams += 1;
+            let username = control::quoted_value(text, "SOCKS_USERNAME=");
+            count(username.as_deref(), circuit.streams == 1);
+
+            let mut recent = recent().lock().unwrap();
+            if recent.len() >= RECENT_STREAMS {
+                recent.pop_front();
+            }
+            recent.push_back(StreamUse {
+                username,
+                target: target.to_string(),
+                conflux: circuit.purpose == "CONFLUX_LINKED",
+            });
+        }
+        _ => {}
+    }
+}
+
+/// Counts a stream of `username` that got a new circuit, or reused one.
+fn count(username: Option<&str>, new_circuit: bool) {
+    let key = match username {
+        Some(username) if username.starts_with("fresh:") => FRESH_KEY,
+        Some(username) => match username.strip_prefix("iso:") {
+            Some(key) => key,
+            None => return,
+        },
+        None => return,
+    };
+
+    let mut stats = stats().lock().unwrap();
+    let entry = stats.entry(key.to_string()).or_default();
+    if new_circuit {
+        entry.built += 1;
+    } else {
+        entry.reused += 1;
+    }
+}
+
+/// Circuit and reuse counters per isolation key, as JSON.
+pub fn stats_json() -> String {
+    let stats = stats().lock().unwrap();
+    serde_json::to_string(&*stats).unwrap_or_else(|_| "{}".to_string())
+}
+
+/// Whether the latest stream to `target` (`host:port`) opened with `auth`
+/// went over a Conflux set.
+///
+/// Tor gives both legs of a linked set the `CONFLUX_LINKED` purpose. Answered
+/// from the events already seen, so it costs no control port round trip.
+pub fn used_conflux(target: &str, auth: Option<&socks::Auth>) -> bool {
+    let username = auth.map(|auth| auth.username.as_str());
+    recent()
+        .lock()
+        .unwrap()
+        .iter()
+        .rev()
+        .find(|stream| {
+            stream.username.as_deref() == username && stream.target.eq_ignore_ascii_case(target)
+        })
+        .is_some_and(|stream| stream.conflux)
+}
+
+/// Stops following the Tor that shut down and drops its counters; circuit
+/// ids restart with the next one.
+pub fn reset() {
+    stats().lock().unwrap().clear();
+    recent().lock().unwrap().clear();
+    *watcher().lock().unwrap() = None;
+}
@@ -4,4 +4,30 @@ pub(crate) mod ffi;
 pub(crate) mod generated;
 
 pub(crate) mod react_native_nitro_tor_impl;
+mod cache;
+mod control;
+mod datetime;
+mod dormant;
+mod encoding;
+mod events;
+mod files;
+mod hedge;
+mod hsdesc;
+mod http;
+mod inbound;
+mod isolation;
+mod listener;
+mod metrics;
+mod onion;
+mod prewarm;
+mod profile;
+mod proxy;
+mod publish;
+mod server;
+mod singleflight;
+mod snapshot;
+mod socks;
+mod startup;
+mod streams;
 mod tor;
+mod websocket;
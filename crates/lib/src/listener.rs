@@ -0,0 +1,159 @@
+#[cfg(unix)]
+use std::os::unix::net::{UnixListener, UnixStream};
+use std::{
+    fs, io,
+    net::{SocketAddr, TcpListener, TcpStream},
+    sync::{
+        atomic::{AtomicBool, AtomicUsize, Ordering},
+        Arc,
+    },
+    thread,
+    time::Duration,
+};
+
+use logger::log::debug;
+
+use crate::socks::{self, Stream};
+
+/// Pause after a failed accept, doubled on each further failure up to
+/// [`MAX_ACCEPT_BACKOFF`].
+const ACCEPT_BACKOFF: Duration = Duration::from_millis(10);
+const MAX_ACCEPT_BACKOFF: Duration = Duration::from_secs(1);
+
+/// Local endpoint of the proxy and the HTTP server: a loopback TCP port or a
+/// Unix domain socket.
+pub enum Listener {
+    Tcp(TcpListener),
+    #[cfg(unix)]
+    Unix(UnixListener),
+}
+
+impl Listener {
+    pub fn accept(&self) -> io::Result<Stream> {
+        match self {
+            Listener::Tcp(listener) => {
+                let (stream, _) = listener.accept()?;
+                stream.set_nodelay(true)?;
+                Ok(Stream::Tcp(stream))
+            }
+            #[cfg(unix)]
+            Listener::Unix(listener) => Ok(Stream::Unix(listener.accept()?.0)),
+        }
+    }
+}
+
+/// One of a listener's connection slots, given back when dropped.
+pub struct Permit(Arc<AtomicUsize>);
+
+impl Permit {
+    /// Takes one of the `max` slots counted by `connections`, or returns
+    /// `None` when all of them are in use.
+    pub fn acquire(connections: &Arc<AtomicUsize>, max: usize) -> Option<Permit> {
+        if connections.fetch_add(1, Ordering::Relaxed) >= max {
+            connections.fetch_sub(1, Ordering::Relaxed);
+            return None;
+        }
+        Some(Permit(connections.clone()))
+    }
+}
+
+impl Drop for Permit {
+    fn drop(&mut self) {
+        self.0.fetch_sub(1, Ordering::Relaxed);
+    }
+}
+
+/// Accepts connections on `listener` until `stopped` is set and the listener
+/// woken with [`wake`], passing each one to `handle`. `name` labels the log
+/// lines.
+///
+/// Errors such as running out of file descriptors would come back right
+/// away, so the loop sleeps after each one, longer while they keep coming.
+pub fn accept_loop(
+    listener: Listener,
+    stopped: &AtomicBool,
+    name: &str,
+    mut handle: impl FnMut(Stream),
+) {
+    let mut backoff = ACCEPT_BACKOFF;
+    while !stopped.load(Ordering::Relaxed) {
+        match listener.accept() {
+            Ok(client) => {
+                backoff = ACCEPT_BACKOFF;
+                if !stopped.load(Ordering::Relaxed) {
+                    handle(client);
+                }
+            }
+            Err(e) if e.kind() == io::ErrorKind::Interrupted => {}
+            Err(e) => {
+                debug!("Rust FFI: {} accept failed {:?}", name, e);
+                thread::sleep(backoff);
+                backoff = (backoff * 2).min(MAX_ACCEPT_BACKOFF);
+            }
+        }
+    }
+    debug!("Rust FFI: {} stopped", name);
+}
+
+/// Binds `listen`, a loopback `host:port` (port 0 picks a free one) or
+/// `unix:/path`, and returns the listener with the address it is bound to.
+pub fn bind(listen: &str) -> io::Result<(Listener, String)> {
+    if let Some(path) = listen.strip_prefix(socks::UNIX_PREFIX) {
+        return bind_unix(path);
+    }
+
+    let addr: SocketAddr = listen
+        .parse()
+        .map_err(|_| io::Error::new(io::ErrorKind::InvalidInput, "Invalid listen address"))?;
+    // Anything that can connect acts as this app; keep it on the device.
+    if !addr.ip().is_loopback() {
+        return Err(io::Error::new(
+            io::ErrorKind::InvalidInput,
+            "Only loopback addresses can be listened on",
+        ));
+    }
+
+    let listener = TcpListener::bind(addr)?;
+    let address = listener.local_addr()?.to_string();
+    Ok((Listener::Tcp(listener), address))
+}
+
+#[cfg(unix)]
+fn bind_unix(path: &str) -> io::Result<(Listener, String)> {
+    // A socket file left behind by a previous run would make bind fail.
+    if UnixStream::connect(path).is_err() {
+        let _ = fs::remove_file(path);
+    }
+    let listener = UnixListener::bind(path)?;
+    Ok((
+        Listener::Unix(listener),
+        format!("{}{}", socks::UNIX_PREFIX, path),
+    ))
+}
+
+#[cfg(not(unix))]
+fn bind_unix(_path: &str) -> io::Result<(Listener, String)> {
+    Err(io::Error::new(
+        io::ErrorKind::Unsupported,
+        "Unix domain sockets are not supported on this platform",
+    ))
+}
+
+/// Unblocks a thread waiting in [`Listener::accept`] on `address` so it can
+/// see that it was stopped, and removes the socket file of a Unix listener.
+pub fn wake(address: &str) {
+    match address.strip_prefix(socks::UNIX_PREFIX) {
+        #[cfg(unix)]
+        Some(path) => {
+            let _ = UnixStream::connect(path);
+            let _ = fs::remove_file(path);
+        }
+        #[cfg(not(unix))]
+        Some(_) => {}
+        None => {
+            if let Ok(addr) = address.parse::<SocketAddr>() {
+                let _ = TcpStream::connect_timeout(&addr, Duration::from_secs(1));
+            }
+        }
+    }
+}
@@ -0,0 +1,257 @@
+use std::{
+    collections::{BTreeMap, HashMap},
+    io::{self, BufReader, Read, Write},
+    net::{SocketAddr, TcpStream},
+    sync::Mutex,
+    time::Duration,
+};
+
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+
+use crate::control;
+use crate::http;
+
+const METRICS_TIMEOUT: Duration = Duration::from_secs(5);
+/// Metrics Tor keeps per onion service, labelled with its address.
+const ONION_PREFIX: &str = "tor_hs_";
+
+/// MetricsPort opened on each control port, by control port.
+static PORTS: OnceCell<Mutex<HashMap<String, u16>>> = OnceCell::new();
+
+fn ports() -> &'static Mutex<HashMap<String, u16>> {
+    PORTS.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+/// Current metrics of the onion service `address`, as a JSON object of
+/// metric name to value.
+///
+/// Covers whatever Tor exports for the service, such as introduction counts,
+/// the suggested proof-of-work effort and the pending introduction queue.
+/// Labels other than the onion address stay in the name, Prometheus style.
+/// The MetricsPort is opened on first use, on loopback only.
+pub fn onion_json(control_port: &str, address: &str) -> io::Result<String> {
+    let text = scrape(control_port)?;
+    let service_id = address.trim().trim_end_matches(".onion");
+
+    let mut values: BTreeMap<String, f64> = BTreeMap::new();
+    for line in text.lines() {
+        let Some((name, labels, value)) = parse_sample(line) else {
+            continue;
+        };
+        if !name.starts_with(ONION_PREFIX) {
+            continue;
+        }
+        let onion = labels
+            .iter()
+            .find(|(key, _)| key == "onion")
+            .map(|(_, value)| value.trim_end_matches(".onion"));
+        if onion != Some(service_id) {
+            continue;
+        }
+
+        let rest: Vec<String> = labels
+            .iter()
+            .filter(|(key, _)| key != "onion")
+            .map(|(key, value)| format!("{}=\"{}\"", key, value))
+            .collect();
+        let key = if rest.is_empty() {
+            name.to_string()
+        } else {
+            format!("{}{{{}}}", name, rest.join(","))
+        };
+        *values.entry(key).or_insert(0.0) += value;
+    }
+
+    serde_json::to_string(&values).map_err(|e| io::Error::other(e.to_string()))
+}
+
+/// Forgets the MetricsPort of a Tor instance that stopped.
+pub fn forget(control_port: &str) {
+    ports().lock().unwrap().remove(control_port);
+}
+
+fn scrape(control_port: &str) -> io::Result<String> {
+    let port = metrics_port(control_port)?;
+    let addr = SocketAddr::from(([127, 0, 0, 1], port));
+    let mut stream = match TcpStream::connect_timeout(&addr, METRICS_TIMEOUT) {
+        Ok(stream) => stream,
+        Err(e) => {
+            // Tor may have dropped the port, e.g. after a SETCONF that did not
+            // repeat it; open it again next time.
+            forget(control_port);
+            return Err(e);
+        }
+    };
+    stream.set_read_timeout(Some(METRICS_TIMEOUT))?;
+    stream.set_write_timeout(Some(METRICS_TIMEOUT))?;
+    stream.write_all(b"GET /metrics HTTP/1.0\r\nHost: 127.0.0.1\r\n\r\n")?;
+
+    let mut reader = BufReader::new(stream);
+    let (status, _) = http::read_head(&mut reader)?;
+    if status != 200 {
+        return Err(io::Error::other(format!("MetricsPort returned {}", status)));
+    }
+    let mut text = String::new();
+    reader.read_to_string(&mut text)?;
+    Ok(text)
+}
+
+fn metrics_port(control_port: &str) -> io::Result<u16> {
+    if let Some(port) = ports().lock().unwrap().get(control_port) {
+        return Ok(*port);
+    }
+
+    // Tor binds the port itself and reports it, so no other process can take
+    // it between choosing and binding.
+    let listeners = control::with_controller(control_port, |c| {
+        c.command("SETCONF MetricsPort=127.0.0.1:auto MetricsPortPolicy=\"accept 127.0.0.1\"")?;
+        c.get_info("net/listeners/metrics")
+    })?;
+    let port = listeners
+        .split_whitespace()
+        .find_map(|listener| listener.trim_matches('"').rsplit_once(':')?.1.parse().ok())
+        .ok_or_else(|| io::Error::other(format!("No MetricsPort in {:?}", listeners)))?;
+    debug!("Rust FFI: MetricsPort listening on {}", port);
+    ports()
+        .lock()
+        .unwrap()
+        .insert(control_port.to_string(), port);
+    Ok(port)
+}
+
+/// Splits a Prometheus sample line, `name{key="value",...} value
+/// [timestamp]`, into name, labels and value.
+fn parse_sample(line: &str) -> Option<(&str, Vec<(String, String)>, f64)> {
+    let line = line.trim();
+    if line.is_empty() || line.starts_with('#') {
+        return None;
+    }
+
+    let (name, mut rest) = line.split_at(line.find(['{', ' ', '\t']).unwrap_or(line.len()));
+    if name.is_empty() {
+        return None;
+    }
+
+    let mut labels = Vec::new();
+    if let Some(mut text) = rest.strip_prefix('{') {
+        loop {
+            text = text.trim_start_matches([' ', ',']);
+            if let Some(after) = text.strip_prefix('}') {
+                rest = after;
+                break;
+            }
+
+            let (key, quoted) = text.split_once('=')?;
+            let key = key.trim();
+            let quoted = quoted.trim_start().strip_prefix('"')?;
+            if key.is_empty() {
+                return None;
+            }
+            let mut value = String::new();
+            let mut chars = quoted.char_indices();
+            let end = loop {
+                match chars.next()? {
+                    (_, '\\') => match chars.next()?.1 {
+                        'n' => value.push('\n'),
+                        c => value.push(c),
+                    },
+                    (i, '"') => break i,
+                    (_, c) => value.push(c),
+                }
+            };
+            labels.push((key.to_string(), value));
+            text = &quoted[end + 1..];
+        }
+    }
+
+    // The value, then an optional timestamp.
+    let mut fields = rest.split_whitespace();
+    let value: f64 = fields.next()?.parse().ok()?;
+    if fields.nth(1).is_some() {
+        return None;
+    }
+    Some((name, labels, value))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn labels(pairs: &[(&str, &str)]) -> Vec<(String, String)> {
+        pairs
+            .iter()
+            .map(|(key, value)| (key.to_string(), value.to_string()))
+            .collect()
+    }
+
+    #[test]
+    fn parses_samples() {
+        assert_eq!(
+            parse_sample(r#"tor_hs_app_write_bytes_total{onion="abc",port="80"} 12"#),
+            Some((
+                "tor_hs_app_write_bytes_total",
+                labels(&[("onion", "abc"), ("port", "80")]),
+                12.0
+            ))
+        );
+        assert_eq!(
+            parse_sample("  tor_hs_pow_suggested_effort 3  "),
+            Some(("tor_hs_pow_suggested_effort", Vec::new(), 3.0))
+        );
+        assert_eq!(parse_sample("x{} 1.5e3"), Some(("x", Vec::new(), 1500.0)));
+        assert_eq!(
+            parse_sample(r#"x{ a = "1" , b="2", } -4"#),
+            Some(("x", labels(&[("a", "1"), ("b", "2")]), -4.0))
+        );
+    }
+
+    #[test]
+    fn unescapes_label_values() {
+        assert_eq!(
+            parse_sample(r#"x{reason="a \"b\" c\\d\ne}",onion="o"} 1"#),
+            Some((
+                "x",
+                labels(&[("reason", "a \"b\" c\\d\ne}"), ("onion", "o")]),
+                1.0
+            ))
+        );
+        assert_eq!(
+            parse_sample(r#"x{a="} 2"} 3"#),
+            Some(("x", labels(&[("a", "} 2")]), 3.0))
+        );
+    }
+
+    #[test]
+    fn accepts_special_values_and_timestamps() {
+        let value = |line| parse_sample(line).map(|(_, _, value)| value);
+        assert_eq!(value("x +Inf"), Some(f64::INFINITY));
+        assert_eq!(value("x -Inf"), Some(f64::NEG_INFINITY));
+        assert!(value("x NaN").is_some_and(f64::is_nan));
+        assert_eq!(value(r#"x{a="1"} 7 1712345678000"#), Some(7.0));
+        assert_eq!(value("x\t8"), Some(8.0));
+    }
+
+    #[test]
+    fn skips_comments_and_malformed_lines() {
+        for line in [
+            "",
+            "   ",
+            "# HELP x Help text",
+            "# TYPE x counter",
+            "x",
+            "x{}",
+            "x one",
+            "x 1 2 3",
+            "{a=\"1\"} 1",
+            r#"x{a="1" 1"#,
+            r#"x{a="1} 1"#,
+            r#"x{a=1} 1"#,
+            r#"x{="1"} 1"#,
+            r#"x{a} 1"#,
+            r#"x{a="\"} 1"#,
+        ] {
+            assert_eq!(parse_sample(line), None, "{:?}", line);
+        }
+    }
+}
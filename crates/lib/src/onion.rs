@@ -0,0 +1,457 @@
+use std::{
+    fs, io,
+    path::{Path, PathBuf},
+    sync::Mutex,
+};
+
+use base64::{engine::general_purpose::STANDARD, Engine};
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use ring::rand::{SecureRandom, SystemRandom};
+use serde::Deserialize;
+
+use crate::control;
+
+/// Directory under the Tor data directory holding configured services.
+const SERVICES_DIR: &str = "onion-services";
+/// Header of Tor's `hs_ed25519_secret_key` file, padded to 32 bytes.
+const SECRET_KEY_HEADER: &[u8; 32] = b"== ed25519v1-secret: type0 ==\0\0\0";
+
+/// Onion services added by [`add`].
+static OWNED: OnceCell<Mutex<Vec<Owned>>> = OnceCell::new();
+
+struct Owned {
+    control_port: String,
+    service_id: String,
+    /// Set for services configured with `HiddenServiceDir`.
+    configured: Option<Configured>,
+}
+
+struct Configured {
+    dir: PathBuf,
+    /// `HiddenService*` options that follow its `HiddenServiceDir`.
+    options: Vec<String>,
+}
+
+fn owned() -> &'static Mutex<Vec<Owned>> {
+    OWNED.get_or_init(|| Mutex::new(Vec::new()))
+}
+
+/// Settings of an onion service the SDK's `TorHiddenServiceParam` cannot
+/// express.
+pub struct Spec {
+    /// Expanded Ed25519 secret key; a new key is generated when `None`.
+    pub key: Option<[u8; 64]>,
+    /// Virtual ports and their targets, `host:port` or `unix:/path`, all
+    /// served under the one address.
+    pub ports: Vec<(u16, String)>,
+    pub defenses: Defenses,
+}
+
+/// Per-service limits against introduction floods, as the `HiddenService*`
+/// torrc options of the same names. Unset fields keep Tor's defaults.
+#[derive(Deserialize, Default)]
+pub struct Defenses {
+    /// `HiddenServicePoWDefensesEnabled`: clients solve a proof of work
+    /// whose effort rises with the queue of pending introductions.
+    pub pow_enabled: Option<bool>,
+    /// `HiddenServicePoWQueueRate`: introductions handled per second.
+    pub pow_queue_rate: Option<u32>,
+    /// `HiddenServicePoWQueueBurst`: introductions handled in a burst.
+    pub pow_queue_burst: Option<u32>,
+    /// `HiddenServiceEnableIntroDoSRatePerSec`, enforced at the intro points.
+    pub intro_rate_per_sec: Option<u32>,
+    /// `HiddenServiceEnableIntroDoSBurstPerSec`.
+    pub intro_burst_per_sec: Option<u32>,
+    /// `HiddenServiceMaxStreams`: streams allowed per rendezvous circuit.
+    pub max_streams: Option<u32>,
+    /// `HiddenServiceMaxStreamsCloseCircuit`: close the circuit, rather than
+    /// the stream, when `max_streams` is exceeded.
+    pub max_streams_close_circuit: Option<bool>,
+}
+
+impl Defenses {
+    /// `ADD_ONION` only takes the stream limits; the rest needs a service
+    /// configured through `HiddenServiceDir`.
+    fn needs_config(&self) -> bool {
+        self.pow_enabled.is_some()
+            || self.pow_queue_rate.is_some()
+            || self.pow_queue_burst.is_some()
+            || self.intro_rate_per_sec.is_some()
+            || self.intro_burst_per_sec.is_some()
+    }
+
+    fn options(&self) -> Vec<String> {
+        let mut options = Vec::new();
+        if let Some(enabled) = self.pow_enabled {
+            options.push(format!("HiddenServicePoWDefensesEnabled={}", enabled as u8));
+        }
+        if let Some(rate) = self.pow_queue_rate {
+            options.push(format!("HiddenServicePoWQueueRate={}", rate));
+        }
+        if let Some(burst) = self.pow_queue_burst {
+            options.push(format!("HiddenServicePoWQueueBurst={}", burst));
+        }
+        if self.intro_rate_per_sec.is_some() || self.intro_burst_per_sec.is_some() {
+            options.push("HiddenServiceEnableIntroDoSDefense=1".to_string());
+        }
+        if let Some(rate) = self.intro_rate_per_sec {
+            options.push(format!("HiddenServiceEnableIntroDoSRatePerSec={}", rate));
+        }
+        if let Some(burst) = self.intro_burst_per_sec {
+            options.push(format!("HiddenServiceEnableIntroDoSBurstPerSec={}", burst));
+        }
+        if let Some(max) = self.max_streams {
+            options.push(format!("HiddenServiceMaxStreams={}", max));
+        }
+        if let Some(close) = self.max_streams_close_circuit {
+            options.push(format!(
+                "HiddenServiceMaxStreamsCloseCircuit={}",
+                close as u8
+            ));
+        }
+        options
+    }
+}
+
+/// Adds an onion service and returns its `.onion` address.
+///
+/// Services whose defenses `ADD_ONION` can express are ephemeral: detached
+/// from the control connection and gone when Tor stops, like the ones the
+/// SDK creates. The others get a directory under `data_dir` and are set with
+/// `SETCONF`, which has to list every such service of the instance at once.
+pub fn add(control_port: &str, data_dir: &str, spec: &Spec) -> io::Result<String> {
+    let service_id = if spec.defenses.needs_config() {
+        add_configured(control_port, data_dir, spec)?
+    } else {
+        add_ephemeral(control_port, spec)?
+    };
+    debug!(
+        "Rust FFI: Added onion service {} for {} ports",
+        service_id,
+        spec.ports.len()
+    );
+    Ok(format!("{}.onion", service_id))
+}
+
+fn add_ephemeral(control_port: &str, spec: &Spec) -> io::Result<String> {
+    let command = add_onion_command(spec);
+    let reply = control::with_controller(control_port, |c| c.command(&command))?;
+    let service_id = reply
+        .iter()
+        .find_map(|line| line.text.strip_prefix("ServiceID="))
+        .ok_or_else(|| io::Error::other("ADD_ONION returned no service id"))?
+        .to_string();
+
+    owned().lock().unwrap().push(Owned {
+        control_port: control_port.to_string(),
+        service_id: service_id.clone(),
+        configured: None,
+    });
+    Ok(service_id)
+}
+
+/// One `ADD_ONION` for the service with all of its ports.
+fn add_onion_command(spec: &Spec) -> String {
+    let key = match &spec.key {
+        Some(key) => format!("ED25519-V3:{}", STANDARD.encode(key)),
+        None => "NEW:ED25519-V3".to_string(),
+    };
+    let mut flags = vec!["Detach", "DiscardPK"];
+    if spec.defenses.max_streams_close_circuit == Some(true) {
+        flags.push("MaxStreamsCloseCircuit");
+    }
+    let mut command = format!("ADD_ONION {} Flags={}", key, flags.join(","));
+    if let Some(max) = spec.defenses.max_streams {
+        command.push_str(&format!(" MaxStreams={}", max));
+    }
+    for (virtual_port, target) in &spec.ports {
+        command.push_str(&format!(" Port={},{}", virtual_port, target));
+    }
+    command
+}
+
+fn add_configured(control_port: &str, data_dir: &str, spec: &Spec) -> io::Result<String> {
+    let mut name = [0u8; 8];
+    SystemRandom::new()
+        .fill(&mut name)
+        .map_err(|_| io::Error::other("No secure random source"))?;
+    let parent = Path::new(data_dir).join(SERVICES_DIR);
+    let dir = parent.join(hex::encode(name));
+    create_private_dir(&parent)?;
+
+    if let Some(key) = &spec.key {
+        create_private_dir(&dir)?;
+        let mut contents = SECRET_KEY_HEADER.to_vec();
+        contents.extend_from_slice(key);
+        fs::write(dir.join("hs_ed25519_secret_key"), contents)?;
+    }
+
+    let configured = Configured {
+        dir,
+        options: configured_options(spec),
+    };
+
+    // Tor creates the keys and the hostname file while applying the config.
+    let mut services = owned().lock().unwrap();
+    let applied = apply_configured(control_port, &services, Some(&configured))
+        .and_then(|()| fs::read_to_string(configured.dir.join("hostname")));
+    let hostname = match applied {
+        Ok(hostname) => hostname,
+        Err(e) => {
+            let _ = fs::remove_dir_all(&configured.dir);
+            return Err(e);
+        }
+    };
+
+    let service_id = hostname.trim().trim_end_matches(".onion").to_string();
+    services.push(Owned {
+        control_port: control_port.to_string(),
+        service_id: service_id.clone(),
+        configured: Some(configured),
+    });
+    Ok(service_id)
+}
+
+/// The options that follow the `HiddenServiceDir` of a configured service.
+fn configured_options(spec: &Spec) -> Vec<String> {
+    let mut options: Vec<String> = spec
+        .ports
+        .iter()
+        .map(|(virtual_port, target)| {
+            format!(
+                "HiddenServicePort={}",
+                quote(&format!("{} {}", virtual_port, target))
+            )
+        })
+        .collect();
+    options.extend(spec.defenses.options());
+    options
+}
+
+/// Sets the configured services of `control_port`, plus `extra`, in one
+/// `SETCONF`.
+fn apply_configured(
+    control_port: &str,
+    services: &[Owned],
+    extra: Option<&Configured>,
+) -> io::Result<()> {
+    let command = setconf_command(control_port, services, extra);
+    control::with_controller(control_port, |c| c.command(&command)).map(|_| ())
+}
+
+fn setconf_command(control_port: &str, services: &[Owned], extra: Option<&Configured>) -> String {
+    let mut command = "SETCONF".to_string();
+    let configured = services
+        .iter()
+        .filter(|owned| owned.control_port == control_port)
+        .filter_map(|owned| owned.configured.as_ref())
+        .chain(extra);
+    for service in configured {
+        command.push_str(&format!(
+            " HiddenServiceDir={}",
+            quote(&service.dir.to_string_lossy())
+        ));
+        for option in &service.options {
+            command.push(' ');
+            command.push_str(option);
+        }
+    }
+    if command == "SETCONF" {
+        // No value clears the whole group of HiddenService options.
+        command.push_str(" HiddenServiceDir");
+    }
+    command
+}
+
+#[cfg(unix)]
+fn create_private_dir(dir: &Path) -> io::Result<()> {
+    use std::os::unix::fs::PermissionsExt;
+
+    fs::create_dir_all(dir)?;
+    // Tor refuses service directories others can read.
+    fs::set_permissions(dir, fs::Permissions::from_mode(0o700))
+}
+
+#[cfg(not(unix))]
+fn create_private_dir(dir: &Path) -> io::Result<()> {
+    fs::create_dir_all(dir)
+}
+
+fn quote(value: &str) -> String {
+    format!("\"{}\"", value.replace('\\', "\\\\").replace('"', "\\\""))
+}
+
+/// Whether `address` was added through [`add`] on `control_port`.
+pub fn is_owned(control_port: &str, address: &str) -> bool {
+    let service_id = service_id(address);
+    owned()
+        .lock()
+        .unwrap()
+        .iter()
+        .any(|owned| owned.control_port == control_port && owned.service_id == service_id)
+}
+
+/// Removes an onion service added by [`add`].
+pub fn delete(control_port: &str, address: &str) -> io::Result<()> {
+    let service_id = service_id(address);
+    let mut services = owned().lock().unwrap();
+    let Some(index) = services
+        .iter()
+        .position(|owned| owned.control_port == control_port && owned.service_id == service_id)
+    else {
+        return Err(io::Error::new(
+            io::ErrorKind::NotFound,
+            "Unknown onion service",
+        ));
+    };
+
+    let removed = services.remove(index);
+    let result = match &removed.configured {
+        Some(configured) => {
+            let result = apply_configured(control_port, &services, None);
+            if result.is_ok() {
+                let _ = fs::remove_dir_all(&configured.dir);
+            }
+            result
+        }
+        None => control::with_controller(control_port, |c| {
+            c.command(&format!("DEL_ONION {}", service_id))
+        })
+        .map(|_| ()),
+    };
+    if result.is_err() {
+        services.insert(index, removed);
+    }
+    result
+}
+
+/// Forgets the services of a Tor instance that stopped and removes the
+/// directories of its configured ones, keys included.
+pub fn forget_instance(control_port: &str) {
+    owned().lock().unwrap().retain(|owned| {
+        if owned.control_port != control_port {
+            return true;
+        }
+        if let Some(configured) = &owned.configured {
+            let _ = fs::remove_dir_all(&configured.dir);
+        }
+        false
+    });
+}
+
+fn service_id(address: &str) -> &str {
+    address.trim().trim_end_matches(".onion")
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn spec(ports: &[(u16, &str)], defenses: Defenses) -> Spec {
+        Spec {
+            key: None,
+            ports: ports
+                .iter()
+                .map(|(port, target)| (*port, target.to_string()))
+                .collect(),
+            defenses,
+        }
+    }
+
+    #[test]
+    fn adds_every_port_in_one_add_onion() {
+        let spec = spec(
+            &[
+                (80, "127.0.0.1:8080"),
+                (443, "127.0.0.1:8443"),
+                (22, "unix:/tmp/ssh"),
+            ],
+            Defenses::default(),
+        );
+        assert_eq!(
+            add_onion_command(&spec),
+            "ADD_ONION NEW:ED25519-V3 Flags=Detach,DiscardPK \
+             Port=80,127.0.0.1:8080 Port=443,127.0.0.1:8443 Port=22,unix:/tmp/ssh"
+        );
+    }
+
+    #[test]
+    fn add_onion_carries_the_key_and_stream_limits() {
+        let mut spec = spec(
+            &[(80, "127.0.0.1:8080")],
+            Defenses {
+                max_streams: Some(10),
+                max_streams_close_circuit: Some(true),
+                ..Defenses::default()
+            },
+        );
+        spec.key = Some([7; 64]);
+        assert!(!spec.defenses.needs_config());
+        assert_eq!(
+            add_onion_command(&spec),
+            format!(
+                "ADD_ONION ED25519-V3:{} Flags=Detach,DiscardPK,MaxStreamsCloseCircuit \
+                 MaxStreams=10 Port=80,127.0.0.1:8080",
+                STANDARD.encode([7; 64])
+            )
+        );
+    }
+
+    #[test]
+    fn configures_ports_and_defenses() {
+        let spec = spec(
+            &[(80, "127.0.0.1:8080"), (8333, "unix:/data/node sock")],
+            Defenses {
+                pow_enabled: Some(true),
+                pow_queue_rate: Some(50),
+                intro_burst_per_sec: Some(200),
+                max_streams: Some(10),
+                ..Defenses::default()
+            },
+        );
+        assert!(spec.defenses.needs_config());
+        assert_eq!(
+            configured_options(&spec),
+            [
+                r#"HiddenServicePort="80 127.0.0.1:8080""#,
+                r#"HiddenServicePort="8333 unix:/data/node sock""#,
+                "HiddenServicePoWDefensesEnabled=1",
+                "HiddenServicePoWQueueRate=50",
+                "HiddenServiceEnableIntroDoSDefense=1",
+                "HiddenServiceEnableIntroDoSBurstPerSec=200",
+                "HiddenServiceMaxStreams=10",
+            ]
+        );
+    }
+
+    #[test]
+    fn setconf_lists_every_configured_service_of_the_instance() {
+        let configured = |dir: &str, port: u16| Configured {
+            dir: PathBuf::from(dir),
+            options: vec![format!("HiddenServicePort=\"{} 127.0.0.1:{}\"", port, port)],
+        };
+        let owned = |control_port: &str, configured| Owned {
+            control_port: control_port.to_string(),
+            service_id: String::new(),
+            configured,
+        };
+        let services = [
+            owned("9051", Some(configured("/a", 80))),
+            owned("9051", None),
+            owned("9151", Some(configured("/other", 81))),
+        ];
+
+        assert_eq!(
+            setconf_command("9051", &services, Some(&configured("/b", 82))),
+            concat!(
+                r#"SETCONF HiddenServiceDir="/a" HiddenServicePort="80 127.0.0.1:80""#,
+                r#" HiddenServiceDir="/b" HiddenServicePort="82 127.0.0.1:82""#
+            )
+        );
+        assert_eq!(
+            setconf_command("9052", &services, None),
+            "SETCONF HiddenServiceDir"
+        );
+    }
+}
@@ -0,0 +1,286 @@
+use std::{
+    collections::HashMap,
+    sync::Mutex,
+    thread,
+    time::{Duration, Instant},
+};
+
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use serde::Serialize;
+use url::Url;
+
+use crate::{dormant, hsdesc, isolation, socks, tor};
+
+/// How long to keep circuits warm when the caller gives no budget.
+pub const DEFAULT_KEEPALIVE: Duration = Duration::from_secs(10 * 60);
+
+/// Interval between keep-alive streams. Well below Tor's default
+/// `MaxCircuitDirtiness` so a replacement circuit is built before the warm
+/// one stops accepting streams.
+const REFRESH_INTERVAL: Duration = Duration::from_secs(60);
+const BOOTSTRAP_POLL: Duration = Duration::from_millis(250);
+const CONNECT_TIMEOUT: Duration = Duration::from_secs(60);
+
+static TARGETS: OnceCell<Mutex<HashMap<String, TargetStatus>>> = OnceCell::new();
+
+#[derive(Clone, Serialize)]
+pub struct TargetStatus {
+    pub target: String,
+    /// "waiting" for bootstrap, "warming", "hot", "failed" or "expired".
+    pub state: &'static str,
+    /// Time from the start of warming until the circuit was first usable.
+    pub ready_ms: u64,
+    pub error: String,
+    #[serde(skip)]
+    generation: u64,
+}
+
+fn targets() -> &'static Mutex<HashMap<String, TargetStatus>> {
+    TARGETS.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+/// Starts keeping circuits to `targets` warm in the background.
+///
+/// Each target is a hostname, `host:port` or URL. Tor builds (and for onion
+/// services, fetches the descriptor and completes the rendezvous for) a
+/// circuit when a stream is opened, so warming opens a stream once Tor has
+/// bootstrapped and then again every [`REFRESH_INTERVAL`] until `keepalive`
+/// runs out. Streams use the same SOCKS credentials as requests with
+/// `isolation`, so those requests find the circuit ready.
+pub fn start(
+    targets_list: Vec<String>,
+    keepalive: Duration,
+    isolation_key: String,
+) -> Result<(), String> {
+    let parsed: Vec<(String, u16)> = targets_list
+        .iter()
+        .map(|target| {
+            parse_target(target).ok_or_else(|| format!("Invalid prewarm target: {}", target))
+        })
+        .collect::<Result<_, _>>()?;
+
+    for (host, port) in parsed {
+        let key = format!("{}:{}", host, port);
+        hsdesc::remember(&host);
+
+        let generation = {
+            let mut targets = targets().lock().unwrap();
+            let generation = targets.get(&key).map(|t| t.generation + 1).unwrap_or(0);
+            targets.insert(
+                key.clone(),
+                TargetStatus {
+                    target: key.clone(),
+                    state: "waiting",
+                    ready_ms: 0,
+                    error: String::new(),
+                    generation,
+                },
+            );
+            generation
+        };
+
+        let isolation_key = isolation_key.clone();
+        thread::spawn(move || keep_warm(key, host, port, generation, keepalive, isolation_key));
+    }
+
+    Ok(())
+}
+
+/// Current state of every target passed to [`start`], as JSON.
+pub fn status_json() -> String {
+    let targets = targets().lock().unwrap();
+    let mut list: Vec<&TargetStatus> = targets.values().collect();
+    list.sort_by(|a, b| a.target.cmp(&b.target));
+    serde_json::to_string(&list).unwrap_or_else(|_| "[]".to_string())
+}
+
+fn keep_warm(
+    key: String,
+    host: String,
+    port: u16,
+    generation: u64,
+    keepalive: Duration,
+    isolation_key: String,
+) {
+    let started = Instant::now();
+    let deadline = started + keepalive;
+
+    let proxy = loop {
+        if !is_current(&key, generation) {
+            return;
+        }
+        if Instant::now() >= deadline {
+            update(&key, generation, |t| t.state = "expired");
+            return;
+        }
+        if let Some(proxy) = tor::bootstrapped_socks_proxy() {
+            break proxy;
+        }
+        thread::sleep(BOOTSTRAP_POLL);
+    };
+
+    update(&key, generation, |t| t.state = "warming");
+    let auth = isolation::socks_auth(&isolation_key, false);
+
+    while is_current(&key, generation) && Instant::now() < deadline {
+        // A keep-alive stream would wake a suspended Tor; wait for resume().
+        if dormant::is_suspended() {
+            thread::sleep(BOOTSTRAP_POLL);
+            continue;
+        }
+
+        match socks::connect(&proxy, &host, port, CONNECT_TIMEOUT, auth.as_ref()) {
+            Ok(stream) => {
+                // Closing the stream leaves the circuit open for later requests.
+                drop(stream);
+                update(&key, generation, |t| {
+                    if t.state != "hot" {
+                        t.ready_ms = started.elapsed().as_millis() as u64;
+                        debug!("Rust FFI: Prewarmed {} in {} ms", t.target, t.ready_ms);
+                    }
+                    t.state = "hot";
+                    t.error.clear();
+                });
+            }
+            Err(e) => {
+                debug!("Rust FFI: Prewarming {} failed {:?}", key, e);
+                update(&key, generation, |t| {
+                    t.state = "failed";
+                    t.error = e.to_string();
+                });
+            }
+        }
+
+        let next = Instant::now() + REFRESH_INTERVAL;
+        while Instant::now() < next.min(deadline) {
+            if !is_current(&key, generation) {
+                return;
+            }
+            thread::sleep(BOOTSTRAP_POLL);
+        }
+    }
+
+    update(&key, generation, |t| t.state = "expired");
+}
+
+fn is_current(key: &str, generation: u64) -> bool {
+    targets()
+        .lock()
+        .unwrap()
+        .get(key)
+        .map(|t| t.generation == generation)
+        .unwrap_or(false)
+}
+
+fn update(key: &str, generation: u64, f: impl FnOnce(&mut TargetStatus)) {
+    if let Some(target) = targets().lock().unwrap().get_mut(key) {
+        if target.generation == generation {
+            f(target);
+        }
+    }
+}
+
+fn parse_target(target: &str) -> Option<(String, u16)> {
+    let target = target.trim();
+
+    if target.contains("://") {
+        let url = Url::parse(target).ok()?;
+        return Some((url.host_str()?.to_string(), url.port_or_known_default()?));
+    }
+
+    let (host, port) = match target.rsplit_once(':') {
+        Some((host, port)) => (host, Some(port.parse::<u16>().ok()?)),
+        None => (target, None),
+    };
+    if host.is_empty() {
+        return None;
+    }
+
+    // Onion services are usually plain HTTP, clearnet hosts HTTPS.
+    let default_port = if host.ends_with(".onion") { 80 } else { 443 };
+    Some((host.to_ascii_lowercase(), port.unwrap_or(default_port)))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn state(key: &str) -> Option<&'static str> {
+        targets().lock().unwrap().get(key).map(|t| t.state)
+    }
+
+    #[test]
+    fn parses_hosts_addresses_and_urls() {
+        let parse = |target| parse_target(target);
+        assert_eq!(parse("Example.com"), Some(("example.com".into(), 443)));
+        assert_eq!(parse(" abc.onion "), Some(("abc.onion".into(), 80)));
+        assert_eq!(parse("abc.onion:8333"), Some(("abc.onion".into(), 8333)));
+        assert_eq!(
+            parse("http://example.com/a"),
+            Some(("example.com".into(), 80))
+        );
+        assert_eq!(
+            parse("wss://example.com:8443/"),
+            Some(("example.com".into(), 8443))
+        );
+
+        for invalid in [
+            "",
+            ":80",
+            "example.com:http",
+            "example.com:70000",
+            "http://",
+        ] {
+            assert_eq!(parse(invalid), None, "{}", invalid);
+        }
+    }
+
+    #[test]
+    fn rejects_the_whole_list_on_an_invalid_target() {
+        let error = start(
+            vec!["valid.example".into(), "bad:port".into()],
+            Duration::ZERO,
+            String::new(),
+        )
+        .unwrap_err();
+        assert!(error.contains("bad:port"));
+        assert_eq!(state("valid.example:443"), None);
+    }
+
+    #[test]
+    fn targets_expire_when_tor_is_not_ready_in_time() {
+        start(vec!["expire.example".into()], Duration::ZERO, String::new()).unwrap();
+        let key = "expire.example:443";
+
+        let deadline = Instant::now() + Duration::from_secs(5);
+        while state(key) != Some("expired") && Instant::now() < deadline {
+            thread::sleep(Duration::from_millis(10));
+        }
+        assert_eq!(state(key), Some("expired"));
+        assert!(status_json().contains(r#""target":"expire.example:443","state":"expired""#));
+    }
+
+    #[test]
+    fn only_the_latest_start_updates_a_target() {
+        let key = "generation.example:443";
+        targets().lock().unwrap().insert(
+            key.to_string(),
+            TargetStatus {
+                target: key.to_string(),
+                state: "waiting",
+                ready_ms: 0,
+                error: String::new(),
+                generation: 3,
+            },
+        );
+
+        assert!(!is_current(key, 2));
+        update(key, 2, |t| t.state = "hot");
+        assert_eq!(state(key), Some("waiting"));
+
+        assert!(is_current(key, 3));
+        update(key, 3, |t| t.state = "hot");
+        assert_eq!(state(key), Some("hot"));
+    }
+}
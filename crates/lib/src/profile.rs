@@ -0,0 +1,177 @@
+use std::collections::HashMap;
+
+use logger::log::debug;
+use serde_json::Value;
+
+use crate::control;
+
+/// torrc settings of each named performance profile.
+///
+/// - `low-latency`: multipath (Conflux) circuits and longer circuit reuse so
+///   fewer requests wait for a circuit build.
+/// - `bulk`: Conflux, all cores for crypto and larger queues for throughput.
+/// - `battery-saver`: reduced padding, fewer disk writes and a single worker
+///   thread to keep the radio and CPU idle.
+const PROFILES: [(&str, &[(&str, &str)]); 3] = [
+    (
+        "low-latency",
+        &[
+            ("ConfluxEnabled", "1"),
+            ("LearnCircuitBuildTimeout", "1"),
+            ("MaxCircuitDirtiness", "1200"),
+            ("NumCPUs", "0"),
+        ],
+    ),
+    (
+        "bulk",
+        &[
+            ("ConfluxEnabled", "1"),
+            ("LearnCircuitBuildTimeout", "0"),
+            ("CircuitBuildTimeout", "60"),
+            ("NumCPUs", "0"),
+            ("MaxMemInQueues", "1 GB"),
+        ],
+    ),
+    (
+        "battery-saver",
+        &[
+            ("ConfluxEnabled", "0"),
+            ("ReducedConnectionPadding", "1"),
+            ("AvoidDiskWrites", "1"),
+            ("MaxCircuitDirtiness", "1800"),
+            ("NumEntryGuards", "1"),
+            ("NumCPUs", "1"),
+            ("MaxMemInQueues", "256 MB"),
+        ],
+    ),
+];
+
+/// Resolves `profile` and the raw `overrides_json` object into torrc
+/// settings. Overrides win over the profile's value for the same key.
+pub fn settings(profile: &str, overrides_json: &str) -> Result<Vec<(String, String)>, String> {
+    let mut settings: Vec<(String, String)> = match profile {
+        "" | "default" => Vec::new(),
+        name => PROFILES
+            .iter()
+            .find(|(profile, _)| *profile == name)
+            .ok_or_else(|| format!("Unknown Tor profile: {}", name))?
+            .1
+            .iter()
+            .map(|(key, value)| (key.to_string(), value.to_string()))
+            .collect(),
+    };
+
+    if overrides_json.is_empty() {
+        return Ok(settings);
+    }
+
+    let overrides: HashMap<String, Value> = serde_json::from_str(overrides_json)
+        .map_err(|e| format!("Invalid torrc overrides JSON: {}", e))?;
+    for (key, value) in overrides {
+        if key.is_empty() || !key.chars().all(|c| c.is_ascii_alphanumeric()) {
+            return Err(format!("Invalid torrc option name: {}", key));
+        }
+        let value = match value {
+            Value::String(value) => value,
+            Value::Bool(value) => (value as u8).to_string(),
+            Value::Number(value) => value.to_string(),
+            _ => return Err(format!("Unsupported value for torrc option {}", key)),
+        };
+
+        settings.retain(|(existing, _)| !existing.eq_ignore_ascii_case(&key));
+        settings.push((key, value));
+    }
+
+    Ok(settings)
+}
+
+/// Applies `settings` with SETCONF, one option at a time so that an option
+/// Tor refuses to change while running does not block the others.
+///
+/// Returns the options that were rejected, with Tor's reason.
+pub fn apply(control_port: &str, settings: &[(String, String)]) -> Vec<String> {
+    let mut errors = Vec::new();
+
+    for (key, value) in settings {
+        let result = control::with_controller(control_port.trim(), |c| {
+            c.command(&format!("SETCONF {}={}", key, quote(value)))
+        });
+        match result {
+            Ok(_) => debug!("Rust FFI: Set {} to {}", key, value),
+            Err(e) => {
+                debug!("Rust FFI: Failed to set {} {:?}", key, e);
+                errors.push(format!("{}: {}", key, e));
+            }
+        }
+    }
+
+    errors
+}
+
+fn quote(value: &str) -> String {
+    format!("\"{}\"", value.replace('\\', "\\\\").replace('"', "\\\""))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn value<'a>(settings: &'a [(String, String)], key: &str) -> Option<&'a str> {
+        settings
+            .iter()
+            .find(|(name, _)| name == key)
+            .map(|(_, value)| value.as_str())
+    }
+
+    #[test]
+    fn maps_profiles_to_torrc_settings() {
+        assert!(settings("", "").unwrap().is_empty());
+        assert!(settings("default", "").unwrap().is_empty());
+
+        let low_latency = settings("low-latency", "").unwrap();
+        assert_eq!(value(&low_latency, "ConfluxEnabled"), Some("1"));
+        assert_eq!(value(&low_latency, "MaxCircuitDirtiness"), Some("1200"));
+
+        let bulk = settings("bulk", "").unwrap();
+        assert_eq!(value(&bulk, "MaxMemInQueues"), Some("1 GB"));
+        assert_eq!(value(&bulk, "LearnCircuitBuildTimeout"), Some("0"));
+
+        let battery = settings("battery-saver", "").unwrap();
+        assert_eq!(value(&battery, "ConfluxEnabled"), Some("0"));
+        assert_eq!(value(&battery, "NumCPUs"), Some("1"));
+        assert_eq!(value(&battery, "ReducedConnectionPadding"), Some("1"));
+
+        assert!(settings("turbo", "").unwrap_err().contains("turbo"));
+    }
+
+    #[test]
+    fn overrides_win_over_the_profile() {
+        let settings = settings(
+            "battery-saver",
+            r#"{"numcpus": 2, "SafeLogging": true, "ExitNodes": "{de}"}"#,
+        )
+        .unwrap();
+
+        // Option names are case-insensitive in Tor.
+        assert_eq!(value(&settings, "NumCPUs"), None);
+        assert_eq!(value(&settings, "numcpus"), Some("2"));
+        assert_eq!(value(&settings, "SafeLogging"), Some("1"));
+        assert_eq!(value(&settings, "ExitNodes"), Some("{de}"));
+        assert_eq!(value(&settings, "AvoidDiskWrites"), Some("1"));
+    }
+
+    #[test]
+    fn rejects_invalid_overrides() {
+        assert!(settings("", "not json").is_err());
+        assert!(settings("", r#"{"Bad Name": "1"}"#).is_err());
+        assert!(settings("", r#"{"": "1"}"#).is_err());
+        assert!(settings("", r#"{"Log\nSocksPort": "1"}"#).is_err());
+        assert!(settings("", r#"{"ExitNodes": ["de"]}"#).is_err());
+    }
+
+    #[test]
+    fn quotes_values_for_setconf() {
+        assert_eq!(quote("1 GB"), "\"1 GB\"");
+        assert_eq!(quote(r#"a "b" \c"#), r#""a \"b\" \\c""#);
+    }
+}
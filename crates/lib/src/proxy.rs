@@ -0,0 +1,704 @@
+use std::{
+    io::{self, BufRead, BufReader, Read, Write},
+    net::Shutdown,
+    sync::{
+        atomic::{AtomicBool, AtomicUsize, Ordering},
+        Arc, Mutex,
+    },
+    thread,
+    time::Duration,
+};
+
+use base64::{engine::general_purpose::STANDARD, Engine};
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use ring::rand::{SecureRandom, SystemRandom};
+use url::{Host, Url};
+
+use crate::http;
+use crate::listener;
+use crate::socks::{self, Stream};
+use crate::{dormant, isolation, tor};
+
+/// Address used when the caller does not choose one.
+const DEFAULT_LISTEN: &str = "127.0.0.1:0";
+const CONNECT_TIMEOUT: Duration = Duration::from_secs(60);
+/// Connections idle for this long, waiting on the client or on Tor, are
+/// dropped. Tunnels have no idle limit.
+const IDLE_TIMEOUT: Duration = Duration::from_secs(5 * 60);
+/// Connections a proxy serves at once, each on its own thread.
+const MAX_CONNECTIONS: usize = 128;
+/// User name of the generated proxy credentials; only the password matters.
+const PROXY_USER: &str = "tor";
+
+static PROXIES: OnceCell<Mutex<Vec<Proxy>>> = OnceCell::new();
+
+struct Proxy {
+    address: String,
+    stopped: Arc<AtomicBool>,
+}
+
+fn proxies() -> &'static Mutex<Vec<Proxy>> {
+    PROXIES.get_or_init(|| Mutex::new(Vec::new()))
+}
+
+/// Starts an HTTP proxy that sends everything through Tor, so code that only knows how to use an HTTP proxy (`fetch`,
+/// image loaders, native SDKs) can reach the Tor network.
+///
+/// `listen` is a loopback `host:port` (port 0 picks a free one) or
+/// `unix:/path`. `CONNECT` requests become raw tunnels; requests with an
+/// absolute URL are forwarded, reusing the connection to the same origin
+/// across keep-alive requests. Bodies are streamed in both directions.
+///
+/// Any app on the device can connect to a loopback port, so TCP proxies
+/// require Basic `Proxy-Authorization` with generated credentials. Unix
+/// socket proxies rely on the permissions of the socket file instead.
+///
+/// Returns the address the proxy listens on and the `user:password` clients
+/// must send, empty for a Unix socket.
+pub fn start(listen: &str, isolation_key: &str) -> io::Result<(String, String)> {
+    let listen = if listen.is_empty() {
+        DEFAULT_LISTEN
+    } else {
+        listen
+    };
+    let (listener, address) = listener::bind(listen)?;
+    let credentials = match &listener {
+        listener::Listener::Tcp(_) => generate_credentials()?,
+        #[cfg(unix)]
+        listener::Listener::Unix(_) => String::new(),
+    };
+
+    let stopped = Arc::new(AtomicBool::new(false));
+    proxies().lock().unwrap().push(Proxy {
+        address: address.clone(),
+        stopped: stopped.clone(),
+    });
+
+    let auth = isolation::socks_auth(isolation_key, false);
+    let required = Arc::new(credentials.clone());
+    let connections = Arc::new(AtomicUsize::new(0));
+    thread::spawn(move || {
+        listener::accept_loop(listener, &stopped, "Proxy", |mut client| {
+            // Tunnels hold two threads each; past the limit clients are
+            // turned away instead of exhausting the process.
+            let Some(permit) = listener::Permit::acquire(&connections, MAX_CONNECTIONS) else {
+                debug!("Rust FFI: Proxy is at its connection limit");
+                let _ = respond_error(&mut client, 503, "Too many connections");
+                return;
+            };
+            let auth = auth.clone();
+            let required = required.clone();
+            thread::spawn(move || {
+                if let Err(e) = serve(client, auth.as_ref(), &required) {
+                    debug!("Rust FFI: Proxy connection ended {:?}", e);
+                }
+                drop(permit);
+            });
+        });
+    });
+
+    debug!("Rust FFI: Proxy listening on {}", address);
+    Ok((address, credentials))
+}
+
+/// Stops accepting connections on `address`; open connections finish on
+/// their own.
+pub fn stop(address: &str) -> bool {
+    let proxy = {
+        let mut proxies = proxies().lock().unwrap();
+        match proxies.iter().position(|proxy| proxy.address == address) {
+            Some(index) => proxies.remove(index),
+            None => return false,
+        }
+    };
+
+    proxy.stopped.store(true, Ordering::Relaxed);
+    listener::wake(&proxy.address);
+    true
+}
+
+/// Stops every proxy, e.g. when the service shuts down.
+pub fn stop_all() {
+    let addresses: Vec<String> = proxies()
+        .lock()
+        .unwrap()
+        .iter()
+        .map(|proxy| proxy.address.clone())
+        .collect();
+
+    for address in addresses {
+        stop(&address);
+    }
+}
+
+/// Connection to an origin, kept across the client's keep-alive requests.
+struct Upstream {
+    origin: String,
+    reader: BufReader<Stream>,
+    writer: Stream,
+}
+
+/// How the end of a message body is found.
+enum Framing {
+    None,
+    Length(u64),
+    Chunked,
+    UntilClose,
+}
+
+/// Serves one client connection. `credentials` is empty when the proxy does
+/// not require authentication.
+fn serve(client: Stream, auth: Option<&socks::Auth>, credentials: &str) -> io::Result<()> {
+    client.set_read_timeout(Some(IDLE_TIMEOUT))?;
+    let mut reader = BufReader::new(client.try_clone()?);
+    let mut writer = client;
+    let mut upstream: Option<Upstream> = None;
+
+    loop {
+        let request = match http::read_request_head(&mut reader) {
+            Ok(request) => request,
+            // The client closed an idle keep-alive connection.
+            Err(e) if e.kind() == io::ErrorKind::UnexpectedEof => return Ok(()),
+            Err(e) => {
+                let _ = respond_error(&mut writer, 400, &e.to_string());
+                return Err(e);
+            }
+        };
+        if !credentials.is_empty() && !authorized(&request.headers, credentials) {
+            return respond_error(&mut writer, 407, "Proxy authentication required");
+        }
+
+        if request.method.eq_ignore_ascii_case("CONNECT") {
+            let stream = match open_upstream(&request.target, auth) {
+                Ok(stream) => stream,
+                Err(e) => return respond_error(&mut writer, gateway_status(&e), &e.to_string()),
+            };
+            writer.write_all(b"HTTP/1.1 200 Connection Established\r\n\r\n")?;
+            return tunnel(reader, writer, BufReader::new(stream.try_clone()?), stream);
+        }
+
+        let url = match Url::parse(&request.target) {
+            Ok(url) if url.scheme() == "http" => url,
+            _ => {
+                return respond_error(
+                    &mut writer,
+                    400,
+                    "Only absolute http:// URLs and CONNECT are supported",
+                )
+            }
+        };
+        let origin = origin(&url)?;
+
+        // The origin may have closed a kept-alive connection while it sat
+        // idle. A request it never answered is sent again on a new one if
+        // repeating it is safe and its body was not already consumed.
+        let retryable = is_idempotent(&request.method)
+            && matches!(framing(&request.headers, Framing::None), Framing::None);
+        let mut reused = upstream.take().filter(|up| up.origin == origin);
+        let mut up = loop {
+            let is_reused = reused.is_some();
+            let mut up = match reused.take() {
+                Some(up) => up,
+                None => match open_upstream(&origin, auth) {
+                    Ok(stream) => Upstream {
+                        origin: origin.clone(),
+                        reader: BufReader::new(stream.try_clone()?),
+                        writer: stream,
+                    },
+                    Err(e) => {
+                        return respond_error(&mut writer, gateway_status(&e), &e.to_string())
+                    }
+                },
+            };
+
+            let answered = forward_request(&mut reader, &mut up.writer, &request, &url)
+                .and_then(|()| up.reader.fill_buf().map(|buf| !buf.is_empty()));
+            match answered {
+                Ok(true) => break up,
+                Ok(false) | Err(_) if is_reused && retryable => {
+                    debug!("Rust FFI: Proxy upstream to {} went away, retrying", origin);
+                }
+                Ok(false) => {
+                    return Err(io::Error::new(
+                        io::ErrorKind::UnexpectedEof,
+                        "Upstream closed without a response",
+                    ))
+                }
+                Err(e) => return Err(e),
+            }
+        };
+
+        let (status_line, headers) = loop {
+            let mut line = String::new();
+            let total = http::read_line(&mut up.reader, &mut line)?;
+            let headers = http::read_headers(&mut up.reader, total)?;
+            let status = status_code(&line)?;
+            write_head(&mut writer, line.trim_end(), &headers)?;
+            // Interim responses are passed on and followed by the real one.
+            if (100..200).contains(&status) && status != 101 {
+                continue;
+            }
+            break (line, headers);
+        };
+        let status = status_code(&status_line)?;
+
+        if status == 101 {
+            // Protocol upgrade, e.g. a WebSocket through the forward proxy.
+            return tunnel(reader, writer, up.reader, up.writer);
+        }
+
+        let framing = if request.method.eq_ignore_ascii_case("HEAD") || matches!(status, 204 | 304)
+        {
+            Framing::None
+        } else {
+            framing(&headers, Framing::UntilClose)
+        };
+        let close_delimited = matches!(framing, Framing::UntilClose);
+        copy_body(&mut up.reader, &mut writer, &framing)?;
+        writer.flush()?;
+
+        let version = status_line.split_whitespace().next().unwrap_or_default();
+        if !close_delimited && !http::wants_close(&headers, version) {
+            upstream = Some(up);
+        }
+        if close_delimited || http::wants_close(&request.headers, &request.version) {
+            let _ = writer.shutdown(Shutdown::Write);
+            return Ok(());
+        }
+    }
+}
+
+/// Methods RFC 9110 allows repeating without changing the outcome.
+fn is_idempotent(method: &str) -> bool {
+    ["GET", "HEAD", "OPTIONS", "TRACE", "PUT", "DELETE"]
+        .iter()
+        .any(|idempotent| method.eq_ignore_ascii_case(idempotent))
+}
+
+fn status_code(status_line: &str) -> io::Result<u16> {
+    status_line
+        .split_whitespace()
+        .nth(1)
+        .and_then(|code| code.parse::<u16>().ok())
+        .ok_or_else(|| io::Error::new(io::ErrorKind::InvalidData, "Invalid HTTP status line"))
+}
+
+/// `host:port` of an `http://` URL.
+fn origin(url: &Url) -> io::Result<String> {
+    let host = match url.host() {
+        Some(Host::Domain(domain)) => domain.to_string(),
+        Some(Host::Ipv4(addr)) => addr.to_string(),
+        Some(Host::Ipv6(addr)) => format!("[{}]", addr),
+        None => {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidInput,
+                "URL has no host",
+            ))
+        }
+    };
+    Ok(format!(
+        "{}:{}",
+        host,
+        url.port_or_known_default().unwrap_or(80)
+    ))
+}
+
+/// Host and port of a `host:port` target; IPv6 hosts lose their brackets.
+fn split_target(target: &str) -> io::Result<(&str, u16)> {
+    let (host, port) = target
+        .rsplit_once(':')
+        .and_then(|(host, port)| Some((host, port.parse::<u16>().ok()?)))
+        .filter(|(host, _)| !host.is_empty())
+        .ok_or_else(|| io::Error::new(io::ErrorKind::InvalidInput, "Invalid target address"))?;
+    Ok((host.trim_start_matches('[').trim_end_matches(']'), port))
+}
+
+fn open_upstream(origin: &str, auth: Option<&socks::Auth>) -> io::Result<Stream> {
+    let (host, port) = split_target(origin)?;
+
+    let Some(proxy) = tor::bootstrapped_socks_proxy() else {
+        return Err(io::Error::new(
+            io::ErrorKind::NotConnected,
+            "Tor is not ready",
+        ));
+    };
+    // Opening a stream wakes a dormant Tor.
+    dormant::note_activity();
+
+    let stream = socks::connect(&proxy, host, port, CONNECT_TIMEOUT, auth)?;
+    stream.set_read_timeout(Some(IDLE_TIMEOUT))?;
+    Ok(stream)
+}
+
+fn gateway_status(error: &io::Error) -> u16 {
+    match error.kind() {
+        io::ErrorKind::TimedOut | io::ErrorKind::WouldBlock => 504,
+        io::ErrorKind::NotConnected => 503,
+        _ => 502,
+    }
+}
+
+fn respond_error(out: &mut Stream, status: u16, message: &str) -> io::Result<()> {
+    let reason = match status {
+        400 => "Bad Request",
+        407 => "Proxy Authentication Required",
+        503 => "Service Unavailable",
+        504 => "Gateway Timeout",
+        _ => "Bad Gateway",
+    };
+    let challenge = if status == 407 {
+        "Proxy-Authenticate: Basic realm=\"Tor\"\r\n"
+    } else {
+        ""
+    };
+    write!(
+        out,
+        "HTTP/1.1 {} {}\r\n{}Content-Type: text/plain\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}",
+        status,
+        reason,
+        challenge,
+        message.len(),
+        message
+    )?;
+    out.flush()
+}
+
+/// A random `user:password` for a new proxy.
+fn generate_credentials() -> io::Result<String> {
+    let mut password = [0u8; 16];
+    SystemRandom::new()
+        .fill(&mut password)
+        .map_err(|_| io::Error::other("No randomness for the proxy credentials"))?;
+    Ok(format!("{}:{}", PROXY_USER, hex::encode(password)))
+}
+
+/// Whether the request carries `credentials` as Basic `Proxy-Authorization`.
+fn authorized(headers: &[(String, String)], credentials: &str) -> bool {
+    let Some((scheme, encoded)) = http::find_header(headers, "proxy-authorization")
+        .and_then(|value| value.trim().split_once(' '))
+    else {
+        return false;
+    };
+    let Ok(sent) = STANDARD.decode(encoded.trim()) else {
+        return false;
+    };
+
+    // Compared in constant time so the password can not be found byte by
+    // byte from response times.
+    scheme.eq_ignore_ascii_case("basic")
+        && sent.len() == credentials.len()
+        && sent
+            .iter()
+            .zip(credentials.as_bytes())
+            .fold(0, |diff, (a, b)| diff | (a ^ b))
+            == 0
+}
+
+/// Sends the request head in origin form, without the proxy's hop-by-hop
+/// headers, followed by the body as it arrives.
+fn forward_request<R: BufRead>(
+    client: &mut R,
+    upstream: &mut Stream,
+    request: &http::RequestHead,
+    url: &Url,
+) -> io::Result<()> {
+    let mut target = url.path().to_string();
+    if let Some(query) = url.query() {
+        target.push('?');
+        target.push_str(query);
+    }
+
+    let mut headers: Vec<(String, String)> = request
+        .headers
+        .iter()
+        .filter(|(key, _)| {
+            !key.eq_ignore_ascii_case("proxy-connection")
+                && !key.eq_ignore_ascii_case("proxy-authorization")
+        })
+        .cloned()
+        .collect();
+    if http::find_header(&headers, "host").is_none() {
+        let host = url.host_str().unwrap_or_default();
+        let host = match url.port() {
+            Some(port) => format!("{}:{}", host, port),
+            None => host.to_string(),
+        };
+        headers.insert(0, ("Host".to_string(), host));
+    }
+
+    let request_line = format!("{} {} {}", request.method, target, request.version);
+    write_head(upstream, &request_line, &headers)?;
+    copy_body(client, upstream, &framing(&request.headers, Framing::None))?;
+    upstream.flush()
+}
+
+fn write_head<W: Write>(
+    out: &mut W,
+    start_line: &str,
+    headers: &[(String, String)],
+) -> io::Result<()> {
+    let mut head = String::with_capacity(256);
+    head.push_str(start_line);
+    head.push_str("\r\n");
+    for (key, value) in headers {
+        head.push_str(key);
+        head.push_str(": ");
+        head.push_str(value);
+        head.push_str("\r\n");
+    }
+    head.push_str("\r\n");
+    out.write_all(head.as_bytes())
+}
+
+/// Body framing from the message headers; `fallback` applies when there is
+/// neither `Transfer-Encoding` nor `Content-Length`.
+fn framing(headers: &[(String, String)], fallback: Framing) -> Framing {
+    let chunked = http::find_header(headers, "transfer-encoding")
+        .map(|te| te.to_ascii_lowercase().contains("chunked"))
+        .unwrap_or(false);
+    if chunked {
+        return Framing::Chunked;
+    }
+
+    match http::find_header(headers, "content-length").and_then(|len| len.trim().parse().ok()) {
+        Some(0) => Framing::None,
+        Some(len) => Framing::Length(len),
+        None => fallback,
+    }
+}
+
+/// Copies one message body without decoding it, so chunked bodies keep
+/// their framing and each side sees the bytes as soon as they arrive.
+fn copy_body<R: BufRead, W: Write>(from: &mut R, to: &mut W, framing: &Framing) -> io::Result<()> {
+    match framing {
+        Framing::None => Ok(()),
+        Framing::Length(len) => copy_exact(from, to, *len),
+        Framing::UntilClose => io::copy(from, to).map(|_| ()),
+        Framing::Chunked => {
+            let mut line = String::new();
+            loop {
+                line.clear();
+                http::read_line(from, &mut line)?;
+                to.write_all(line.as_bytes())?;
+                let size = line
+                    .trim()
+                    .split(';')
+                    .next()
+                    .and_then(|size| u64::from_str_radix(size.trim(), 16).ok())
+                    .ok_or_else(|| {
+                        io::Error::new(io::ErrorKind::InvalidData, "Invalid chunk size")
+                    })?;
+
+                if size == 0 {
+                    // Trailers, up to the blank line.
+                    loop {
+                        line.clear();
+                        http::read_line(from, &mut line)?;
+                        to.write_all(line.as_bytes())?;
+                        if line.trim().is_empty() {
+                            return Ok(());
+                        }
+                    }
+                }
+                // The chunk and its CRLF.
+                copy_exact(from, to, size + 2)?;
+                to.flush()?;
+            }
+        }
+    }
+}
+
+fn copy_exact<R: Read, W: Write>(from: &mut R, to: &mut W, len: u64) -> io::Result<()> {
+    let copied = io::copy(&mut from.take(len), to)?;
+    if copied < len {
+        return Err(io::Error::new(
+            io::ErrorKind::UnexpectedEof,
+            "Connection closed in the middle of a body",
+        ));
+    }
+    Ok(())
+}
+
+/// Relays bytes both ways until each side has finished sending.
+fn tunnel(
+    client_reader: BufReader<Stream>,
+    mut client: Stream,
+    upstream_reader: BufReader<Stream>,
+    mut upstream: Stream,
+) -> io::Result<()> {
+    // Bytes that arrived together with the last head.
+    client.write_all(upstream_reader.buffer())?;
+    upstream.write_all(client_reader.buffer())?;
+
+    let mut client_in = client_reader.into_inner();
+    let mut upstream_in = upstream_reader.into_inner();
+    // Long-lived tunnels may be quiet in one direction for any length of time.
+    client_in.set_read_timeout(None)?;
+    upstream_in.set_read_timeout(None)?;
+
+    let outbound = thread::spawn(move || {
+        let _ = io::copy(&mut client_in, &mut upstream);
+        let _ = upstream.shutdown(Shutdown::Write);
+    });
+    let _ = io::copy(&mut upstream_in, &mut client);
+    let _ = client.shutdown(Shutdown::Write);
+    let _ = outbound.join();
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn headers(pairs: &[(&str, &str)]) -> Vec<(String, String)> {
+        pairs
+            .iter()
+            .map(|(name, value)| (name.to_string(), value.to_string()))
+            .collect()
+    }
+
+    #[test]
+    fn framing_follows_the_headers() {
+        let chunked = headers(&[
+            ("Transfer-Encoding", "gzip, Chunked"),
+            ("Content-Length", "5"),
+        ]);
+        assert!(matches!(framing(&chunked, Framing::None), Framing::Chunked));
+
+        let length = headers(&[("Content-Length", " 42 ")]);
+        assert!(matches!(
+            framing(&length, Framing::None),
+            Framing::Length(42)
+        ));
+
+        let empty = headers(&[("Content-Length", "0")]);
+        assert!(matches!(
+            framing(&empty, Framing::UntilClose),
+            Framing::None
+        ));
+
+        let invalid = headers(&[("Content-Length", "many")]);
+        assert!(matches!(
+            framing(&invalid, Framing::UntilClose),
+            Framing::UntilClose
+        ));
+        assert!(matches!(framing(&[], Framing::None), Framing::None));
+    }
+
+    #[test]
+    fn copies_chunked_bodies_as_sent() {
+        let body = b"4;ext=1\r\nWiki\r\n5\r\npedia\r\n0\r\nExpires: never\r\n\r\nnext request";
+        let mut from = &body[..];
+        let mut to = Vec::new();
+        copy_body(&mut from, &mut to, &Framing::Chunked).unwrap();
+
+        assert_eq!(to, &body[..body.len() - b"next request".len()]);
+        assert_eq!(from, b"next request");
+    }
+
+    /// Fails reads past the first `limit` bytes, like a connection that
+    /// has not sent the rest yet.
+    struct Partial<'a> {
+        data: &'a [u8],
+        limit: usize,
+    }
+
+    impl Read for Partial<'_> {
+        fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+            if self.limit == 0 {
+                return Err(io::Error::new(
+                    io::ErrorKind::WouldBlock,
+                    "no more data yet",
+                ));
+            }
+            let len = buf.len().min(self.limit).min(self.data.len());
+            buf[..len].copy_from_slice(&self.data[..len]);
+            self.data = &self.data[len..];
+            self.limit -= len;
+            Ok(len)
+        }
+    }
+
+    #[test]
+    fn passes_each_chunk_on_as_it_arrives() {
+        let first = b"4\r\nWiki\r\n";
+        let body = [&first[..], b"5\r\npedia\r\n0\r\n\r\n"].concat();
+        let mut from = io::BufReader::with_capacity(
+            4,
+            Partial {
+                data: &body,
+                limit: first.len(),
+            },
+        );
+        let mut to = Vec::new();
+
+        assert!(copy_body(&mut from, &mut to, &Framing::Chunked).is_err());
+        assert_eq!(to, first);
+    }
+
+    #[test]
+    fn truncated_bodies_fail() {
+        let mut to = Vec::new();
+        let error = copy_body(&mut &b"abc"[..], &mut to, &Framing::Length(5)).unwrap_err();
+        assert_eq!(error.kind(), io::ErrorKind::UnexpectedEof);
+
+        let error = copy_body(&mut &b"zz\r\n"[..], &mut to, &Framing::Chunked).unwrap_err();
+        assert_eq!(error.kind(), io::ErrorKind::InvalidData);
+    }
+
+    #[test]
+    fn origins_have_a_host_and_port() {
+        let origin_of = |url: &str| origin(&Url::parse(url).unwrap()).unwrap();
+        assert_eq!(origin_of("http://example.com/path"), "example.com:80");
+        assert_eq!(
+            origin_of("http://example.onion:8080/"),
+            "example.onion:8080"
+        );
+        assert_eq!(origin_of("http://10.0.0.1/"), "10.0.0.1:80");
+        assert_eq!(origin_of("http://[::1]:81/"), "[::1]:81");
+    }
+
+    #[test]
+    fn splits_targets() {
+        assert_eq!(
+            split_target("example.com:443").unwrap(),
+            ("example.com", 443)
+        );
+        assert_eq!(
+            split_target("[2001:db8::1]:80").unwrap(),
+            ("2001:db8::1", 80)
+        );
+        for invalid in [
+            "example.com",
+            "example.com:",
+            "example.com:99999",
+            ":80",
+            "host:port",
+        ] {
+            assert!(split_target(invalid).is_err(), "{}", invalid);
+        }
+    }
+
+    #[test]
+    fn checks_basic_proxy_authorization() {
+        let credentials = generate_credentials().unwrap();
+        assert!(credentials.starts_with("tor:"));
+        assert_ne!(credentials, generate_credentials().unwrap());
+
+        let basic = |value: &str| format!("Basic {}", STANDARD.encode(value));
+        let with = |value: &str| headers(&[("Proxy-Authorization", value)]);
+        assert!(authorized(&with(&basic(&credentials)), &credentials));
+        assert!(authorized(
+            &with(&basic(&credentials).replace("Basic", "basic")),
+            &credentials
+        ));
+
+        assert!(!authorized(&[], &credentials));
+        assert!(!authorized(&with(&basic("tor:wrong")), &credentials));
+        assert!(!authorized(&with(&basic(&credentials[..10])), &credentials));
+        assert!(!authorized(&with("Basic not-base64!"), &credentials));
+        let bearer = format!("Bearer {}", STANDARD.encode(&credentials));
+        assert!(!authorized(&with(&bearer), &credentials));
+    }
+}
@@ -0,0 +1,397 @@
+use std::{
+    collections::HashMap,
+    io, mem,
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        Condvar, Mutex,
+    },
+    thread,
+    time::{Duration, Instant},
+};
+
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use serde::Serialize;
+
+use crate::control::Controller;
+use crate::events;
+
+/// Events kept for JS; Tor keeps republishing, so older ones are dropped
+/// when nothing polls.
+const MAX_EVENTS: usize = 256;
+
+/// Descriptor upload progress of the onion services Tor publishes, by
+/// service id, with the condvar [`wait`] sleeps on.
+static PROGRESS: OnceCell<(Mutex<HashMap<String, Progress>>, Condvar)> = OnceCell::new();
+/// Events not yet taken by [`take`].
+static EVENTS: OnceCell<Mutex<Vec<Event>>> = OnceCell::new();
+/// Control ports with a watcher thread, and the id of that thread.
+static WATCHED: OnceCell<Mutex<Vec<(String, u64)>>> = OnceCell::new();
+static NEXT_WATCHER: AtomicU64 = AtomicU64::new(1);
+
+struct Progress {
+    control_port: String,
+    /// Upload rounds by descriptor id. Tor publishes the descriptors of the
+    /// current and the next time period separately, and uploads each one
+    /// again whenever it changes.
+    rounds: HashMap<String, Round>,
+}
+
+/// The latest round of uploads of one descriptor.
+#[derive(Default)]
+struct Round {
+    /// HSDirs the descriptor was sent to.
+    sent: Vec<String>,
+    /// HSDirs that accepted it.
+    accepted: Vec<String>,
+}
+
+impl Progress {
+    /// HSDirs that accepted the latest revision of a descriptor, counting
+    /// the descriptor with the most.
+    fn accepted(&self) -> usize {
+        self.rounds
+            .values()
+            .map(|round| round.accepted.len())
+            .max()
+            .unwrap_or(0)
+    }
+}
+
+/// An `HS_DESC` event about one of our services, as delivered to JS.
+#[derive(Serialize)]
+pub struct Event {
+    onion_address: String,
+    /// `UPLOAD` when Tor sends a descriptor, `UPLOADED` when the HSDir
+    /// accepted it and `FAILED` when it did not.
+    action: String,
+    hsdir: String,
+    /// Tor's reason for a failure, empty otherwise.
+    reason: String,
+}
+
+fn progress() -> &'static (Mutex<HashMap<String, Progress>>, Condvar) {
+    PROGRESS.get_or_init(|| (Mutex::new(HashMap::new()), Condvar::new()))
+}
+
+fn pending() -> &'static Mutex<Vec<Event>> {
+    EVENTS.get_or_init(|| Mutex::new(Vec::new()))
+}
+
+fn watched() -> &'static Mutex<Vec<(String, u64)>> {
+    WATCHED.get_or_init(|| Mutex::new(Vec::new()))
+}
+
+/// Follows the descriptor uploads of the Tor instance behind `control_port`.
+///
+/// Runs on a control connection of its own subscribed to `HS_DESC`, since
+/// the shared one is for commands. Start it before adding services so no
+/// upload is missed; the thread ends when Tor closes the connection.
+pub fn watch(control_port: &str) -> io::Result<()> {
+    let control_port = control_port.trim().to_string();
+    if watched()
+        .lock()
+        .unwrap()
+        .iter()
+        .any(|(port, _)| *port == control_port)
+    {
+        return Ok(());
+    }
+
+    let mut controller = Controller::connect(&control_port)?;
+    controller.command("SETEVENTS HS_DESC")?;
+    controller.set_read_timeout(None)?;
+    let id = NEXT_WATCHER.fetch_add(1, Ordering::Relaxed);
+    let watcher = (control_port.clone(), id);
+    watched().lock().unwrap().push(watcher.clone());
+
+    thread::spawn(move || {
+        // Forgetting the instance unregisters the watcher; a later instance
+        // on the same control port gets its own.
+        let registered = || watched().lock().unwrap().contains(&watcher);
+        loop {
+            match controller.read_event() {
+                Ok(lines) if registered() => {
+                    for line in lines {
+                        record(&control_port, &line.text);
+                    }
+                }
+                Ok(_) => break,
+                Err(e) => {
+                    debug!("Rust FFI: HS_DESC events ended {:?}", e);
+                    break;
+                }
+            }
+        }
+        watched().lock().unwrap().retain(|entry| *entry != watcher);
+    });
+    Ok(())
+}
+
+/// Records an `HS_DESC` event line:
+/// `HS_DESC Action HSAddress AuthType HsDir [DescriptorID] [REASON=...]`.
+///
+/// Client-side fetches report `REQUESTED`, `RECEIVED` and also `FAILED`, so
+/// a failure only counts for an address Tor has uploaded before.
+fn record(control_port: &str, text: &str) {
+    let mut fields = text.split_whitespace();
+    if fields.next() != Some("HS_DESC") {
+        return;
+    }
+    let (Some(action), Some(service_id), Some(_), Some(hsdir)) =
+        (fields.next(), fields.next(), fields.next(), fields.next())
+    else {
+        return;
+    };
+    let rest: Vec<&str> = fields.collect();
+    let descriptor_id = rest
+        .first()
+        .filter(|field| !field.contains('='))
+        .copied()
+        .unwrap_or("");
+    let reason = rest
+        .iter()
+        .find_map(|field| field.strip_prefix("REASON="))
+        .unwrap_or("");
+    // `$fingerprint~nickname`; the fingerprint identifies the HSDir.
+    let hsdir = hsdir.split('~').next().unwrap_or(hsdir);
+
+    {
+        let (services, changed) = progress();
+        let mut services = services.lock().unwrap();
+        match action {
+            "UPLOAD" => {
+                let service = services
+                    .entry(service_id.to_string())
+                    .or_insert_with(|| Progress {
+                        control_port: control_port.to_string(),
+                        rounds: HashMap::new(),
+                    });
+                let round = service.rounds.entry(descriptor_id.to_string()).or_default();
+                // Each round sends the descriptor to every HSDir once, so a
+                // repeat starts the next one. What the HSDirs accepted
+                // before was an older revision.
+                if round.sent.iter().any(|dir| dir == hsdir) {
+                    *round = Round::default();
+                }
+                round.sent.push(hsdir.to_string());
+            }
+            "UPLOADED" | "FAILED" => {
+                let Some(service) = services.get_mut(service_id) else {
+                    return;
+                };
+                if action == "UPLOADED" {
+                    // UPLOADED carries no descriptor id, so it counts for
+                    // each round that sent a descriptor to that HSDir.
+                    for round in service.rounds.values_mut() {
+                        if round.sent.iter().any(|dir| dir == hsdir)
+                            && !round.accepted.iter().any(|dir| dir == hsdir)
+                        {
+                            round.accepted.push(hsdir.to_string());
+                            changed.notify_all();
+                        }
+                    }
+                }
+            }
+            _ => return,
+        }
+    }
+
+    debug!(
+        "Rust FFI: HS_DESC {} {} {} {}",
+        action, service_id, hsdir, reason
+    );
+    let mut queue = pending().lock().unwrap();
+    if queue.len() >= MAX_EVENTS {
+        queue.remove(0);
+    }
+    queue.push(Event {
+        onion_address: format!("{}.onion", service_id),
+        action: action.to_string(),
+        hsdir: hsdir.to_string(),
+        reason: reason.to_string(),
+    });
+    drop(queue);
+    events::notify();
+}
+
+/// Waits until `min_hsdirs` HSDirs accepted the latest revision of a
+/// descriptor of `address`, or `timeout` passed. Returns how many had.
+///
+/// Tor uploads every descriptor to several HSDirs, and a service becomes
+/// reachable once the ones clients ask have it.
+pub fn wait(control_port: &str, address: &str, min_hsdirs: usize, timeout: Duration) -> usize {
+    let service_id = address.trim().trim_end_matches(".onion");
+    let control_port = control_port.trim();
+    let (services, changed) = progress();
+    let deadline = Instant::now() + timeout;
+    let mut services = services.lock().unwrap();
+
+    loop {
+        let accepted = services
+            .get(service_id)
+            .filter(|service| service.control_port == control_port)
+            .map(Progress::accepted)
+            .unwrap_or(0);
+        let now = Instant::now();
+        if accepted >= min_hsdirs || now >= deadline {
+            return accepted;
+        }
+        services = changed.wait_timeout(services, deadline - now).unwrap().0;
+    }
+}
+
+/// Takes the events since the previous call.
+pub fn take() -> Vec<Event> {
+    mem::take(&mut *pending().lock().unwrap())
+}
+
+/// Forgets the progress of `address`, e.g. once the service is deleted.
+pub fn forget(address: &str) {
+    let service_id = address.trim().trim_end_matches(".onion");
+    progress().0.lock().unwrap().remove(service_id);
+}
+
+/// Forgets the services of a Tor instance that stopped.
+pub fn forget_instance(control_port: &str) {
+    let control_port = control_port.trim();
+    progress()
+        .0
+        .lock()
+        .unwrap()
+        .retain(|_, service| service.control_port != control_port);
+    watched()
+        .lock()
+        .unwrap()
+        .retain(|(port, _)| port != control_port);
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const PORT: &str = "127.0.0.1:9051";
+
+    /// Takes the queued events of `service_id` as `(action, hsdir, reason)`.
+    fn events_of(service_id: &str) -> Vec<(String, String, String)> {
+        let address = format!("{}.onion", service_id);
+        let mut queue = pending().lock().unwrap();
+        let (mine, others): (Vec<Event>, Vec<Event>) = mem::take(&mut *queue)
+            .into_iter()
+            .partition(|event| event.onion_address == address);
+        *queue = others;
+        mine.into_iter()
+            .map(|event| (event.action, event.hsdir, event.reason))
+            .collect()
+    }
+
+    fn accepted(service_id: &str) -> usize {
+        wait(
+            PORT,
+            &format!("{}.onion", service_id),
+            usize::MAX,
+            Duration::ZERO,
+        )
+    }
+
+    #[test]
+    fn counts_hsdirs_that_accepted_an_upload() {
+        let id = "countsaccepted";
+        record(
+            PORT,
+            &format!(
+                "HS_DESC UPLOAD {} UNKNOWN $AAAA~alpha desc1 HSDIR_INDEX=01",
+                id
+            ),
+        );
+        record(
+            PORT,
+            &format!(
+                "HS_DESC UPLOAD {} UNKNOWN $BBBB~beta desc1 HSDIR_INDEX=02",
+                id
+            ),
+        );
+        record(
+            PORT,
+            &format!("HS_DESC UPLOAD {} UNKNOWN $CCCC desc1 HSDIR_INDEX=03", id),
+        );
+        assert_eq!(accepted(id), 0);
+
+        record(
+            PORT,
+            &format!("HS_DESC UPLOADED {} UNKNOWN $AAAA~alpha", id),
+        );
+        record(
+            PORT,
+            &format!("HS_DESC UPLOADED {} UNKNOWN $AAAA~alpha", id),
+        );
+        record(PORT, &format!("HS_DESC UPLOADED {} UNKNOWN $BBBB", id));
+        record(
+            PORT,
+            &format!("HS_DESC FAILED {} UNKNOWN $CCCC REASON=UPLOAD_REJECTED", id),
+        );
+        assert_eq!(accepted(id), 2);
+        assert_eq!(wait("127.0.0.1:9151", id, 1, Duration::ZERO), 0);
+
+        let events = events_of(id);
+        assert_eq!(events.len(), 7);
+        assert_eq!(events[0], ("UPLOAD".into(), "$AAAA".into(), "".into()));
+        assert_eq!(events[5], ("UPLOADED".into(), "$BBBB".into(), "".into()));
+        assert_eq!(
+            events[6],
+            ("FAILED".into(), "$CCCC".into(), "UPLOAD_REJECTED".into())
+        );
+        forget(id);
+    }
+
+    #[test]
+    fn ignores_other_services_and_events() {
+        let id = "ignoresothers";
+        // Client-side fetches of services we never uploaded.
+        record(
+            PORT,
+            &format!("HS_DESC REQUESTED {} NO_AUTH $AAAA desc1", id),
+        );
+        record(
+            PORT,
+            &format!("HS_DESC FAILED {} NO_AUTH $AAAA REASON=NOT_FOUND", id),
+        );
+        record(PORT, &format!("HS_DESC UPLOADED {} UNKNOWN $AAAA", id));
+        // Malformed or unrelated lines.
+        record(PORT, &format!("HS_DESC UPLOAD {} UNKNOWN", id));
+        record(PORT, &format!("CIRC 1 BUILT {} UNKNOWN $AAAA", id));
+        record(PORT, "");
+
+        assert_eq!(accepted(id), 0);
+        assert!(progress().0.lock().unwrap().get(id).is_none());
+        assert!(events_of(id).is_empty());
+    }
+
+    #[test]
+    fn a_new_upload_round_resets_what_was_accepted() {
+        let id = "newround";
+        for hsdir in ["$AAAA", "$BBBB"] {
+            record(
+                PORT,
+                &format!("HS_DESC UPLOAD {} UNKNOWN {} desc1", id, hsdir),
+            );
+            record(PORT, &format!("HS_DESC UPLOADED {} UNKNOWN {}", id, hsdir));
+        }
+        assert_eq!(accepted(id), 2);
+
+        // The descriptor of the next time period does not reset it.
+        record(PORT, &format!("HS_DESC UPLOAD {} UNKNOWN $CCCC desc2", id));
+        assert_eq!(accepted(id), 2);
+
+        // Uploading the first descriptor again starts a new round.
+        record(PORT, &format!("HS_DESC UPLOAD {} UNKNOWN $AAAA desc1", id));
+        record(PORT, &format!("HS_DESC UPLOADED {} UNKNOWN $CCCC", id));
+        assert_eq!(accepted(id), 1);
+        record(PORT, &format!("HS_DESC UPLOADED {} UNKNOWN $AAAA", id));
+        record(PORT, &format!("HS_DESC UPLOADED {} UNKNOWN $BBBB", id));
+        assert_eq!(accepted(id), 1);
+
+        events_of(id);
+        forget(id);
+    }
+}
@@ -1,20 +1,42 @@
+use std::path::{Path, PathBuf};
+
 use craby::{prelude::*, throw};
 
 use crate::ffi::bridging::*;
 use crate::generated::*;
-use crate::tor;
+use crate::tor::{self, RequestOptions, ServiceOptions};
 
 pub struct ReactNativeNitroTor {
     ctx: Context,
 }
 
+impl ReactNativeNitroTor {
+    fn http_cache_root(&self) -> PathBuf {
+        Path::new(&self.ctx.data_path).join("http-cache")
+    }
+}
+
 #[craby_module]
 impl ReactNativeNitroTorSpec for ReactNativeNitroTor {
+    fn attach_http_server(&mut self, server_id: Number) -> Promise<Boolean> {
+        Ok(tor::attach_http_server(server_id))
+    }
+
+    fn clear_http_cache(&mut self) -> Promise<Boolean> {
+        Ok(tor::clear_http_cache(self.http_cache_root()))
+    }
+
     fn create_hidden_service(
         &mut self,
         params: HiddenServiceParams,
     ) -> Promise<HiddenServiceResponse> {
-        Ok(tor::create_hidden_service(params.port, params.target_port))
+        Ok(tor::create_hidden_service(
+            params.port,
+            params.target_port,
+            params.ports_json,
+            params.accept_streams,
+            params.defenses_json,
+        ))
     }
 
     fn delete_hidden_service(&mut self, onion_address: &str) -> Promise<Boolean> {
@@ -22,6 +44,32 @@ impl ReactNativeNitroTorSpec for ReactNativeNitroTor {
         Ok(tor::delete_hidden_service(address))
     }
 
+    fn export_directory_snapshot(
+        &mut self,
+        params: DirectorySnapshotParams,
+    ) -> Promise<DirectorySnapshotResponse> {
+        Ok(tor::export_directory_snapshot(
+            params.data_dir,
+            params.snapshot_dir,
+        ))
+    }
+
+    fn get_circuit_stats(&mut self) -> Promise<String> {
+        Ok(tor::get_circuit_stats())
+    }
+
+    fn get_listeners(&mut self) -> Promise<TorListeners> {
+        Ok(tor::get_listeners())
+    }
+
+    fn get_onion_service_metrics(&mut self, onion_address: &str) -> Promise<String> {
+        Ok(tor::get_onion_service_metrics(onion_address))
+    }
+
+    fn get_startup_report(&mut self) -> Promise<String> {
+        Ok(tor::get_startup_report())
+    }
+
     fn get_service_status(&mut self) -> Promise<Number> {
         Ok(tor::get_service_status())
     }
@@ -31,11 +79,35 @@ impl ReactNativeNitroTorSpec for ReactNativeNitroTor {
             params.url,
             params.headers,
             params.timeout_ms,
+            RequestOptions {
+                accept_encoding: params.accept_encoding,
+                isolation: params.isolation,
+                fresh_circuit: params.fresh_circuit,
+                ..Default::default()
+            },
         ))
     }
 
     fn http_get(&mut self, params: HttpGetParams) -> Promise<HttpResponse> {
-        Ok(tor::http_get(params.url, params.headers, params.timeout_ms))
+        let cache_root = if params.cache {
+            Some(self.http_cache_root())
+        } else {
+            None
+        };
+
+        Ok(tor::http_get(
+            params.url,
+            params.headers,
+            params.timeout_ms,
+            RequestOptions {
+                accept_encoding: params.accept_encoding,
+                cache_root,
+                // Only idempotent GETs are hedged; 0 disables hedging.
+                hedge_percentile: Some(params.hedge_percentile).filter(|p| *p > 0.0),
+                isolation: params.isolation,
+                fresh_circuit: params.fresh_circuit,
+            },
+        ))
     }
 
     fn http_post(&mut self, params: HttpPostParams) -> Promise<HttpResponse> {
@@ -44,6 +116,12 @@ impl ReactNativeNitroTorSpec for ReactNativeNitroTor {
             params.body,
             params.headers,
             params.timeout_ms,
+            RequestOptions {
+                accept_encoding: params.accept_encoding,
+                isolation: params.isolation,
+                fresh_circuit: params.fresh_circuit,
+                ..Default::default()
+            },
         ))
     }
 
@@ -53,6 +131,12 @@ impl ReactNativeNitroTorSpec for ReactNativeNitroTor {
             params.body,
             params.headers,
             params.timeout_ms,
+            RequestOptions {
+                accept_encoding: params.accept_encoding,
+                isolation: params.isolation,
+                fresh_circuit: params.fresh_circuit,
+                ..Default::default()
+            },
         ))
     }
 
@@ -61,6 +145,53 @@ impl ReactNativeNitroTorSpec for ReactNativeNitroTor {
             config.socks_port,
             config.data_dir,
             config.timeout_ms,
+            ServiceOptions {
+                profile: config.profile,
+                torrc_overrides_json: config.torrc_overrides_json,
+            },
+        ))
+    }
+
+    fn get_prewarm_status(&mut self) -> Promise<String> {
+        Ok(tor::get_prewarm_status())
+    }
+
+    fn open_stream(&mut self, params: OpenStreamParams) -> Promise<StreamResponse> {
+        Ok(tor::open_stream(
+            params.host,
+            params.port,
+            params.timeout_ms,
+            params.isolation,
+        ))
+    }
+
+    fn poll_events(&mut self, wait_ms: Number) -> Promise<String> {
+        Ok(tor::poll_events(wait_ms))
+    }
+
+    fn prewarm(&mut self, params: PrewarmParams) -> Promise<Boolean> {
+        Ok(tor::prewarm(
+            params.targets_json,
+            params.keepalive_ms,
+            params.isolation,
+        ))
+    }
+
+    fn respond_http_requests(&mut self, replies_json: &str) -> Promise<Boolean> {
+        Ok(tor::respond_http_requests(replies_json))
+    }
+
+    fn resume(&mut self, timeout_ms: Number) -> Promise<ResumeResponse> {
+        Ok(tor::resume_service(timeout_ms))
+    }
+
+    fn seed_directory_snapshot(
+        &mut self,
+        params: DirectorySnapshotParams,
+    ) -> Promise<DirectorySnapshotResponse> {
+        Ok(tor::seed_directory_snapshot(
+            params.snapshot_dir,
+            params.data_dir,
         ))
     }
 
@@ -68,6 +199,21 @@ impl ReactNativeNitroTorSpec for ReactNativeNitroTor {
         Ok(tor::shutdown_service())
     }
 
+    fn start_http_server(&mut self, params: HttpServerParams) -> Promise<HttpServerResponse> {
+        Ok(tor::start_http_server(
+            params.listen,
+            Path::new(&self.ctx.data_path),
+            params.static_dir,
+            params.routes_json,
+            params.dispatch,
+            params.handler_timeout_ms as u64,
+        ))
+    }
+
+    fn start_proxy(&mut self, params: ProxyParams) -> Promise<ProxyResponse> {
+        Ok(tor::start_proxy(params.listen, params.isolation))
+    }
+
     fn start_tor_if_not_running(&mut self, params: StartTorParams) -> Promise<StartTorResponse> {
         Ok(tor::start_tor_if_not_running(
             params.data_dir,
@@ -75,6 +221,83 @@ impl ReactNativeNitroTorSpec for ReactNativeNitroTor {
             params.target_port,
             params.timeout_ms,
             params.keys_json,
+            ServiceOptions {
+                profile: params.profile,
+                torrc_overrides_json: params.torrc_overrides_json,
+            },
         ))
     }
+
+    fn stop_http_server(&mut self, server_id: Number) -> Promise<Boolean> {
+        Ok(tor::stop_http_server(server_id))
+    }
+
+    fn stop_proxy(&mut self, address: &str) -> Promise<Boolean> {
+        Ok(tor::stop_proxy(address))
+    }
+
+    fn stream_close(&mut self, stream_id: Number) -> Promise<Boolean> {
+        Ok(tor::stream_close(stream_id))
+    }
+
+    fn stream_read(&mut self, stream_id: Number, max_bytes: Number) -> Promise<StreamReadResponse> {
+        Ok(tor::stream_read(stream_id, max_bytes))
+    }
+
+    fn stream_shutdown_write(&mut self, stream_id: Number) -> Promise<StreamResponse> {
+        Ok(tor::stream_shutdown_write(stream_id))
+    }
+
+    fn stream_write(&mut self, stream_id: Number, data_base64: &str) -> Promise<StreamResponse> {
+        Ok(tor::stream_write(stream_id, data_base64))
+    }
+
+    fn suspend(&mut self) -> Promise<Boolean> {
+        Ok(tor::suspend_service())
+    }
+
+    fn wait_onion_published(
+        &mut self,
+        params: OnionPublishParams,
+    ) -> Promise<OnionPublishResponse> {
+        Ok(tor::wait_onion_published(
+            &params.onion_address,
+            params.min_hsdirs,
+            params.timeout_ms,
+        ))
+    }
+
+    fn web_socket_attach(&mut self, socket_id: Number) -> Promise<Boolean> {
+        Ok(tor::websocket_attach(socket_id))
+    }
+
+    fn web_socket_close(
+        &mut self,
+        socket_id: Number,
+        code: Number,
+        reason: &str,
+    ) -> Promise<Boolean> {
+        Ok(tor::websocket_close(socket_id, code, reason))
+    }
+
+    fn web_socket_connect(&mut self, params: WebSocketParams) -> Promise<WebSocketResponse> {
+        Ok(tor::websocket_connect(
+            params.url,
+            params.headers,
+            params.protocols,
+            params.timeout_ms,
+            params.ping_interval_ms,
+            params.deflate,
+            params.isolation,
+        ))
+    }
+
+    fn web_socket_send(
+        &mut self,
+        socket_id: Number,
+        data: &str,
+        binary: Boolean,
+    ) -> Promise<Boolean> {
+        Ok(tor::websocket_send(socket_id, data, binary))
+    }
 }
@@ -0,0 +1,505 @@
+use std::{
+    collections::HashMap,
+    io::{self, BufRead, BufReader, Read, Write},
+    mem,
+    sync::{
+        atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering},
+        Arc, Condvar, Mutex,
+    },
+    thread,
+    time::{Duration, Instant},
+};
+
+use base64::{engine::general_purpose::STANDARD, Engine};
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use serde::{Deserialize, Serialize};
+
+use crate::events;
+use crate::files;
+use crate::http;
+use crate::listener;
+use crate::socks::Stream;
+
+/// Keep-alive connections idle for this long are closed.
+const IDLE_TIMEOUT: Duration = Duration::from_secs(60);
+/// Largest request body handed to JS; bigger requests get a 413.
+const MAX_BODY: u64 = 4 * 1024 * 1024;
+/// Connections a server serves at once, each on its own thread.
+const MAX_CONNECTIONS: usize = 128;
+
+static NEXT_SERVER: AtomicU64 = AtomicU64::new(1);
+static NEXT_REQUEST: AtomicU64 = AtomicU64::new(1);
+static SERVERS: OnceCell<Mutex<HashMap<u64, Server>>> = OnceCell::new();
+/// Requests waiting to be taken by [`take`], from every server.
+static INBOX: OnceCell<Mutex<Vec<Incoming>>> = OnceCell::new();
+/// Requests handed to JS that have not been answered yet.
+static PENDING: OnceCell<Mutex<HashMap<u64, Arc<Slot>>>> = OnceCell::new();
+
+pub struct Options {
+    /// Directories files are served from, before requests reach JS.
+    pub routes: Vec<files::Route>,
+    /// Whether requests that are not static files go to JS. Without it they
+    /// get a 404.
+    pub dispatch: bool,
+    /// How long JS has to answer a request before the client gets a 504.
+    pub handler_timeout: Duration,
+}
+
+struct Server {
+    address: String,
+    stopped: Arc<AtomicBool>,
+    /// Whether JS has registered the server's handler, see [`attach`].
+    attached: bool,
+}
+
+/// A request delivered to JS by [`take`].
+#[derive(Serialize)]
+pub struct Incoming {
+    id: u64,
+    server_id: u64,
+    method: String,
+    target: String,
+    /// Lowercase names; repeated headers are joined with `, `.
+    headers: HashMap<String, String>,
+    body: String,
+    /// Set instead of `body` when the body is not valid UTF-8.
+    #[serde(skip_serializing_if = "Option::is_none")]
+    body_base64: Option<String>,
+}
+
+/// The answer of JS to one request, as passed to [`respond_json`].
+#[derive(Deserialize)]
+struct Reply {
+    id: u64,
+    status: u16,
+    #[serde(default)]
+    headers: HashMap<String, String>,
+    #[serde(default)]
+    body: String,
+    /// `body` is base64.
+    #[serde(default)]
+    base64: bool,
+}
+
+#[derive(Default)]
+struct Slot {
+    reply: Mutex<Option<Reply>>,
+    ready: Condvar,
+}
+
+fn servers() -> &'static Mutex<HashMap<u64, Server>> {
+    SERVERS.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+fn inbox() -> &'static Mutex<Vec<Incoming>> {
+    INBOX.get_or_init(|| Mutex::new(Vec::new()))
+}
+
+fn pending() -> &'static Mutex<HashMap<u64, Arc<Slot>>> {
+    PENDING.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+/// Starts an HTTP/1.1 server on `listen`, a loopback `host:port` or
+/// `unix:/path`, typically the target of an onion service.
+///
+/// Files under the static routes are sent straight from disk; every other request
+/// is queued for JS, which takes them in batches through [`events`] and
+/// answers with [`respond_json`]. Connections are kept alive between
+/// requests.
+///
+/// Returns the server id and the address it listens on.
+pub fn start(listen: &str, mut options: Options) -> io::Result<(u64, String)> {
+    let (listener, address) = listener::bind(listen)?;
+    let id = NEXT_SERVER.fetch_add(1, Ordering::Relaxed);
+
+    let stopped = Arc::new(AtomicBool::new(false));
+    servers().lock().unwrap().insert(
+        id,
+        Server {
+            address: address.clone(),
+            stopped: stopped.clone(),
+            attached: false,
+        },
+    );
+
+    files::sort_routes(&mut options.routes);
+    let options = Arc::new(options);
+    let connections = Arc::new(AtomicUsize::new(0));
+    thread::spawn(move || {
+        let name = format!("Server {}", id);
+        listener::accept_loop(listener, &stopped, &name, |mut client| {
+            // Each connection holds a thread; past the limit clients are
+            // turned away instead of exhausting the process.
+            let Some(permit) = listener::Permit::acquire(&connections, MAX_CONNECTIONS) else {
+                debug!("Rust FFI: Server {} is at its connection limit", id);
+                let _ = write_response(&mut client, 503, &[], b"Too many connections", false, true);
+                return;
+            };
+            let options = options.clone();
+            let stopped = stopped.clone();
+            thread::spawn(move || {
+                if let Err(e) = serve(client, id, &options, &stopped) {
+                    debug!("Rust FFI: Server connection ended {:?}", e);
+                }
+                drop(permit);
+            });
+        });
+    });
+
+    debug!("Rust FFI: Server {} listening on {}", id, address);
+    Ok((id, address))
+}
+
+/// Stops the server `id`. Open connections end after their current request.
+pub fn stop(id: u64) -> bool {
+    let Some(server) = servers().lock().unwrap().remove(&id) else {
+        return false;
+    };
+
+    server.stopped.store(true, Ordering::Relaxed);
+    listener::wake(&server.address);
+    true
+}
+
+/// Starts handing the requests of server `id` to JS.
+///
+/// The server accepts connections as soon as [`start`] returns, before JS
+/// knows its id and has registered a handler for it, so [`take`] holds its
+/// requests back until this is called.
+pub fn attach(id: u64) -> bool {
+    match servers().lock().unwrap().get_mut(&id) {
+        Some(server) => server.attached = true,
+        None => return false,
+    }
+    events::notify();
+    true
+}
+
+/// Takes the requests waiting for JS.
+///
+/// Requests from every server and connection queue up in one place, so a
+/// single call picks up everything that arrived since the previous one.
+/// Requests of servers that are not attached yet stay queued; those of
+/// stopped servers are dropped and time out.
+pub fn take() -> Vec<Incoming> {
+    let servers = servers().lock().unwrap();
+    let mut inbox = inbox().lock().unwrap();
+    let (taken, held) = mem::take(&mut *inbox)
+        .into_iter()
+        .filter(|request| servers.contains_key(&request.server_id))
+        .partition(|request| servers[&request.server_id].attached);
+    *inbox = held;
+    taken
+}
+
+/// Delivers a JSON array of replies to the connections waiting for them.
+///
+/// Returns how many were still waiting; replies to requests that already
+/// timed out are dropped.
+pub fn respond_json(replies_json: &str) -> io::Result<usize> {
+    let replies: Vec<Reply> = serde_json::from_str(replies_json)
+        .map_err(|e| io::Error::new(io::ErrorKind::InvalidInput, e.to_string()))?;
+
+    let mut delivered = 0;
+    for reply in replies {
+        let Some(slot) = pending().lock().unwrap().remove(&reply.id) else {
+            continue;
+        };
+        *slot.reply.lock().unwrap() = Some(reply);
+        slot.ready.notify_one();
+        delivered += 1;
+    }
+    Ok(delivered)
+}
+
+fn serve(
+    client: Stream,
+    server_id: u64,
+    options: &Options,
+    stopped: &AtomicBool,
+) -> io::Result<()> {
+    client.set_read_timeout(Some(IDLE_TIMEOUT))?;
+    let mut reader = BufReader::new(client.try_clone()?);
+    let mut out = client;
+
+    while !stopped.load(Ordering::Relaxed) {
+        let request = match http::read_request_head(&mut reader) {
+            Ok(request) => request,
+            // The client closed or went idle between requests.
+            Err(e)
+                if matches!(
+                    e.kind(),
+                    io::ErrorKind::UnexpectedEof
+                        | io::ErrorKind::TimedOut
+                        | io::ErrorKind::WouldBlock
+                ) =>
+            {
+                return Ok(());
+            }
+            Err(e) => {
+                write_response(&mut out, 400, &[], e.to_string().as_bytes(), false, true)?;
+                return Err(e);
+            }
+        };
+
+        let close = http::wants_close(&request.headers, &request.version);
+        let head_only = request.method == "HEAD";
+
+        let body = match read_body(&mut reader, &mut out, &request) {
+            Ok(body) => body,
+            Err(e) if e.kind() == io::ErrorKind::InvalidInput => {
+                write_response(&mut out, 413, &[], e.to_string().as_bytes(), false, true)?;
+                return Ok(());
+            }
+            Err(e) => {
+                write_response(&mut out, 400, &[], e.to_string().as_bytes(), false, true)?;
+                return Err(e);
+            }
+        };
+
+        let file = match request.method.as_str() {
+            "GET" | "HEAD" => files::resolve(&options.routes, &request.target),
+            _ => None,
+        };
+
+        if let Some(path) = file {
+            files::send(&mut out, &request, &path, close)?;
+        } else if options.dispatch {
+            match dispatch(server_id, request, body, options.handler_timeout) {
+                Some(reply) => {
+                    let body = if reply.base64 {
+                        STANDARD.decode(&reply.body)
+                    } else {
+                        Ok(reply.body.as_bytes().to_vec())
+                    };
+                    match body {
+                        Ok(body) => {
+                            let headers: Vec<(&str, &str)> = reply
+                                .headers
+                                .iter()
+                                .map(|(name, value)| (name.as_str(), value.as_str()))
+                                .collect();
+                            write_response(
+                                &mut out,
+                                reply.status,
+                                &headers,
+                                &body,
+                                head_only,
+                                close,
+                            )?;
+                        }
+                        Err(e) => {
+                            debug!(
+                                "Rust FFI: Reply {} has an invalid base64 body {:?}",
+                                reply.id, e
+                            );
+                            let message = b"Request handler sent an invalid body";
+                            write_response(&mut out, 500, &[], message, head_only, close)?;
+                        }
+                    }
+                }
+                None => {
+                    let message = b"Request handler timed out";
+                    write_response(&mut out, 504, &[], message, head_only, close)?;
+                }
+            }
+        } else {
+            write_response(&mut out, 404, &[], b"Not Found", head_only, close)?;
+        }
+
+        if close {
+            break;
+        }
+    }
+
+    Ok(())
+}
+
+/// Reads the request body, answering `Expect: 100-continue` first.
+///
+/// Fails with `InvalidInput` when the body is larger than [`MAX_BODY`].
+fn read_body<R: BufRead>(
+    reader: &mut R,
+    out: &mut Stream,
+    request: &http::RequestHead,
+) -> io::Result<Vec<u8>> {
+    let chunked = http::find_header(&request.headers, "transfer-encoding")
+        .is_some_and(|value| value.to_ascii_lowercase().contains("chunked"));
+    let length = match http::find_header(&request.headers, "content-length") {
+        Some(value) if !chunked => value
+            .trim()
+            .parse::<u64>()
+            .map_err(|_| io::Error::new(io::ErrorKind::InvalidData, "Invalid Content-Length"))?,
+        _ => 0,
+    };
+    if !chunked && length == 0 {
+        return Ok(Vec::new());
+    }
+    if length > MAX_BODY {
+        return Err(too_large());
+    }
+
+    let expects_continue = http::find_header(&request.headers, "expect")
+        .is_some_and(|value| value.eq_ignore_ascii_case("100-continue"));
+    if expects_continue && request.version != "HTTP/1.0" {
+        out.write_all(b"HTTP/1.1 100 Continue\r\n\r\n")?;
+        out.flush()?;
+    }
+
+    let mut body = Vec::new();
+    if chunked {
+        http::ChunkedReader::new(reader)
+            .take(MAX_BODY + 1)
+            .read_to_end(&mut body)?;
+        if body.len() as u64 > MAX_BODY {
+            return Err(too_large());
+        }
+    } else {
+        body.reserve(length as usize);
+        reader.take(length).read_to_end(&mut body)?;
+        if (body.len() as u64) < length {
+            return Err(io::Error::new(
+                io::ErrorKind::UnexpectedEof,
+                "Connection closed inside the request body",
+            ));
+        }
+    }
+    Ok(body)
+}
+
+fn too_large() -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidInput, "Request body too large")
+}
+
+/// Queues the request for JS and waits for its reply.
+fn dispatch(
+    server_id: u64,
+    request: http::RequestHead,
+    body: Vec<u8>,
+    timeout: Duration,
+) -> Option<Reply> {
+    let id = NEXT_REQUEST.fetch_add(1, Ordering::Relaxed);
+    let slot = Arc::new(Slot::default());
+    pending().lock().unwrap().insert(id, slot.clone());
+
+    let mut headers: HashMap<String, String> = HashMap::new();
+    for (name, value) in request.headers {
+        headers
+            .entry(name.to_ascii_lowercase())
+            .and_modify(|joined| {
+                joined.push_str(", ");
+                joined.push_str(&value);
+            })
+            .or_insert(value);
+    }
+    let (body, body_base64) = match String::from_utf8(body) {
+        Ok(text) => (text, None),
+        Err(e) => (String::new(), Some(STANDARD.encode(e.into_bytes()))),
+    };
+
+    inbox().lock().unwrap().push(Incoming {
+        id,
+        server_id,
+        method: request.method,
+        target: request.target,
+        headers,
+        body,
+        body_base64,
+    });
+    events::notify();
+
+    let deadline = Instant::now() + timeout;
+    let mut reply = slot.reply.lock().unwrap();
+    while reply.is_none() {
+        let now = Instant::now();
+        if now >= deadline {
+            break;
+        }
+        reply = slot.ready.wait_timeout(reply, deadline - now).unwrap().0;
+    }
+    let reply = reply.take();
+    if reply.is_none() {
+        pending().lock().unwrap().remove(&id);
+        debug!("Rust FFI: Request {} timed out waiting for JS", id);
+    }
+    reply
+}
+
+fn write_response(
+    out: &mut Stream,
+    status: u16,
+    headers: &[(&str, &str)],
+    body: &[u8],
+    head_only: bool,
+    close: bool,
+) -> io::Result<()> {
+    let mut headers = headers.to_vec();
+    if !headers
+        .iter()
+        .any(|(name, _)| name.eq_ignore_ascii_case("content-type"))
+    {
+        headers.push(("Content-Type", "text/plain; charset=utf-8"));
+    }
+
+    // One write for head and body keeps small responses in one packet.
+    let mut response = http::response_head(status, &headers, body.len() as u64, close).into_bytes();
+    if !head_only {
+        response.extend_from_slice(body);
+    }
+    out.write_all(&response)?;
+    out.flush()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn queue(server_id: u64) -> u64 {
+        let id = NEXT_REQUEST.fetch_add(1, Ordering::Relaxed);
+        inbox().lock().unwrap().push(Incoming {
+            id,
+            server_id,
+            method: "GET".to_string(),
+            target: "/".to_string(),
+            headers: HashMap::new(),
+            body: String::new(),
+            body_base64: None,
+        });
+        id
+    }
+
+    #[test]
+    fn holds_requests_until_the_server_is_attached() {
+        let server_id = NEXT_SERVER.fetch_add(1, Ordering::Relaxed);
+        servers().lock().unwrap().insert(
+            server_id,
+            Server {
+                address: String::new(),
+                stopped: Arc::new(AtomicBool::new(false)),
+                attached: false,
+            },
+        );
+        let early = queue(server_id);
+
+        assert!(take().iter().all(|request| request.id != early));
+        assert!(attach(server_id));
+        let later = queue(server_id);
+        let taken: Vec<u64> = take()
+            .iter()
+            .filter(|request| request.server_id == server_id)
+            .map(|request| request.id)
+            .collect();
+        assert_eq!(taken, [early, later]);
+
+        let stopped = queue(server_id);
+        servers().lock().unwrap().remove(&server_id);
+        assert!(take().iter().all(|request| request.id != stopped));
+        assert!(inbox()
+            .lock()
+            .unwrap()
+            .iter()
+            .all(|request| request.id != stopped));
+        assert!(!attach(server_id));
+    }
+}
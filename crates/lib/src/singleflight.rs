@@ -0,0 +1,223 @@
+use std::{
+    collections::HashMap,
+    hash::Hash,
+    sync::{Arc, Condvar, Mutex},
+};
+
+/// Deduplicates concurrent calls that share a key.
+///
+/// The first caller for a key runs the work, callers arriving while it is in
+/// flight block until it finishes and receive a clone of its result. Results
+/// should be cheap to clone (e.g. wrapped in an `Arc`) since every waiter gets
+/// its own copy.
+pub struct Group<K, V> {
+    calls: Mutex<HashMap<K, Arc<Call<V>>>>,
+}
+
+struct Call<V> {
+    state: Mutex<CallState<V>>,
+    done: Condvar,
+}
+
+struct CallState<V> {
+    result: Option<V>,
+    finished: bool,
+    waiters: usize,
+}
+
+impl<K: Eq + Hash + Clone, V: Clone> Group<K, V> {
+    pub fn new() -> Self {
+        Group {
+            calls: Mutex::new(HashMap::new()),
+        }
+    }
+
+    /// Runs `work` unless an identical call is already in flight.
+    ///
+    /// Returns the result and whether it was shared with another caller.
+    pub fn run<F: FnOnce() -> V>(&self, key: K, work: F) -> (V, bool) {
+        let (call, leader) = {
+            let mut calls = self.calls.lock().unwrap();
+            match calls.get(&key) {
+                Some(call) => {
+                    call.state.lock().unwrap().waiters += 1;
+                    (call.clone(), false)
+                }
+                None => {
+                    let call = Arc::new(Call {
+                        state: Mutex::new(CallState {
+                            result: None,
+                            finished: false,
+                            waiters: 0,
+                        }),
+                        done: Condvar::new(),
+                    });
+                    calls.insert(key.clone(), call.clone());
+                    (call, true)
+                }
+            }
+        };
+
+        if !leader {
+            let mut state = call.state.lock().unwrap();
+            while !state.finished {
+                state = call.done.wait(state).unwrap();
+            }
+            if let Some(result) = state.result.clone() {
+                return (result, true);
+            }
+            // The leader panicked; do the work ourselves rather than fail.
+            drop(state);
+            return (work(), false);
+        }
+
+        let guard = LeaderGuard {
+            group: self,
+            key,
+            call: &call,
+        };
+        let result = work();
+        call.state.lock().unwrap().result = Some(result.clone());
+        drop(guard);
+
+        let shared = call.state.lock().unwrap().waiters > 0;
+        (result, shared)
+    }
+}
+
+/// Unregisters the call and wakes waiters, also when the leader unwinds.
+struct LeaderGuard<'a, K: Eq + Hash, V> {
+    group: &'a Group<K, V>,
+    key: K,
+    call: &'a Arc<Call<V>>,
+}
+
+impl<K: Eq + Hash, V> Drop for LeaderGuard<'_, K, V> {
+    fn drop(&mut self) {
+        self.group.calls.lock().unwrap().remove(&self.key);
+        self.call.state.lock().unwrap().finished = true;
+        self.call.done.notify_all();
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::{
+        sync::{
+            atomic::{AtomicUsize, Ordering},
+            mpsc,
+        },
+        thread,
+        time::Duration,
+    };
+
+    /// Waits until `waiters` callers are blocked on the call for `key`.
+    fn wait_for_waiters(group: &Group<&str, usize>, key: &str, waiters: usize) {
+        loop {
+            let count = group
+                .calls
+                .lock()
+                .unwrap()
+                .get(key)
+                .map_or(0, |call| call.state.lock().unwrap().waiters);
+            if count == waiters {
+                return;
+            }
+            thread::sleep(Duration::from_millis(1));
+        }
+    }
+
+    #[test]
+    fn concurrent_callers_share_one_run() {
+        let group = Arc::new(Group::new());
+        let runs = Arc::new(AtomicUsize::new(0));
+        let (release, released) = mpsc::channel::<()>();
+
+        let leader = {
+            let (group, runs) = (group.clone(), runs.clone());
+            thread::spawn(move || {
+                group.run("key", || {
+                    released.recv().unwrap();
+                    runs.fetch_add(1, Ordering::SeqCst) + 41
+                })
+            })
+        };
+        while !group.calls.lock().unwrap().contains_key("key") {
+            thread::sleep(Duration::from_millis(1));
+        }
+
+        let waiters: Vec<_> = (0..4)
+            .map(|_| {
+                let (group, runs) = (group.clone(), runs.clone());
+                thread::spawn(move || group.run("key", || runs.fetch_add(1, Ordering::SeqCst)))
+            })
+            .collect();
+        wait_for_waiters(&group, "key", 4);
+        release.send(()).unwrap();
+
+        assert_eq!(leader.join().unwrap(), (41, true));
+        for waiter in waiters {
+            assert_eq!(waiter.join().unwrap(), (41, true));
+        }
+        assert_eq!(runs.load(Ordering::SeqCst), 1);
+        assert!(group.calls.lock().unwrap().is_empty());
+
+        // Once finished, the next call runs again.
+        assert_eq!(group.run("key", || 7), (7, false));
+    }
+
+    #[test]
+    fn keys_do_not_share() {
+        let group = Arc::new(Group::new());
+        let (release, released) = mpsc::channel::<()>();
+
+        let first = {
+            let group = group.clone();
+            thread::spawn(move || {
+                group.run("first", || {
+                    released.recv().unwrap();
+                    1
+                })
+            })
+        };
+        while !group.calls.lock().unwrap().contains_key("first") {
+            thread::sleep(Duration::from_millis(1));
+        }
+
+        // Runs while "first" is still in flight.
+        assert_eq!(group.run("second", || 2), (2, false));
+        release.send(()).unwrap();
+        assert_eq!(first.join().unwrap(), (1, false));
+    }
+
+    #[test]
+    fn waiters_run_the_work_when_the_leader_panics() {
+        let group = Arc::new(Group::new());
+        let (release, released) = mpsc::channel::<()>();
+
+        let leader = {
+            let group = group.clone();
+            thread::spawn(move || {
+                group.run("key", || -> usize {
+                    released.recv().unwrap();
+                    panic!("leader failed");
+                })
+            })
+        };
+        while !group.calls.lock().unwrap().contains_key("key") {
+            thread::sleep(Duration::from_millis(1));
+        }
+
+        let waiter = {
+            let group = group.clone();
+            thread::spawn(move || group.run("key", || 5))
+        };
+        wait_for_waiters(&group, "key", 1);
+        release.send(()).unwrap();
+
+        assert!(leader.join().is_err());
+        assert_eq!(waiter.join().unwrap(), (5, false));
+        assert!(group.calls.lock().unwrap().is_empty());
+    }
+}
@@ -0,0 +1,239 @@
+use std::{
+    fs, io,
+    path::{Path, PathBuf},
+};
+
+use logger::log::debug;
+
+use crate::datetime::{self, now_secs};
+
+/// Directory documents Tor needs to build circuits without downloading them.
+const SNAPSHOT_FILES: [&str; 5] = [
+    "cached-microdesc-consensus",
+    "cached-microdescs",
+    "cached-microdescs.new",
+    "cached-certs",
+    "cached-consensus",
+];
+const CONSENSUS_FILE: &str = "cached-microdesc-consensus";
+
+/// Tor still bootstraps from a consensus up to a day past its `valid-until`
+/// ("reasonably live"), fetching a fresh one in the background.
+const REASONABLY_LIVE_SECS: u64 = 24 * 60 * 60;
+
+/// Copies the directory cache from `snapshot_dir` into `data_dir`.
+///
+/// Nothing is copied when the snapshot's consensus is no longer usable or
+/// when `data_dir` already holds a newer one. Returns the snapshot
+/// consensus' `valid-until` as Unix seconds.
+pub fn seed(snapshot_dir: &Path, data_dir: &Path) -> io::Result<u64> {
+    let snapshot_valid_until = consensus_valid_until(snapshot_dir)?;
+    if !is_usable(snapshot_valid_until) {
+        return Err(io::Error::other("Snapshot consensus has expired"));
+    }
+
+    if let Ok(current) = consensus_valid_until(data_dir) {
+        if current >= snapshot_valid_until {
+            return Err(io::Error::new(
+                io::ErrorKind::AlreadyExists,
+                "Data directory already has a newer consensus",
+            ));
+        }
+    }
+
+    fs::create_dir_all(data_dir)?;
+    copy_files(snapshot_dir, data_dir)?;
+    debug!(
+        "Rust FFI: Seeded directory cache from {:?}, valid until {}",
+        snapshot_dir, snapshot_valid_until
+    );
+    Ok(snapshot_valid_until)
+}
+
+/// Copies the directory cache of `data_dir` to `snapshot_dir`.
+pub fn export(data_dir: &Path, snapshot_dir: &Path) -> io::Result<u64> {
+    let valid_until = consensus_valid_until(data_dir)?;
+
+    fs::create_dir_all(snapshot_dir)?;
+    copy_files(data_dir, snapshot_dir)?;
+    Ok(valid_until)
+}
+
+/// Whether `data_dir` holds a consensus Tor can bootstrap from right away.
+pub fn has_usable_consensus(data_dir: &Path) -> bool {
+    consensus_valid_until(data_dir)
+        .map(is_usable)
+        .unwrap_or(false)
+}
+
+fn is_usable(valid_until: u64) -> bool {
+    now_secs() < valid_until + REASONABLY_LIVE_SECS
+}
+
+fn copy_files(from: &Path, to: &Path) -> io::Result<()> {
+    for name in SNAPSHOT_FILES {
+        let source = from.join(name);
+        if !source.exists() {
+            continue;
+        }
+
+        // Copy then rename so Tor never sees a half-written file.
+        let target = to.join(name);
+        let tmp: PathBuf = to.join(format!("{}.tmp", name));
+        fs::copy(&source, &tmp)?;
+        fs::rename(&tmp, &target)?;
+    }
+    Ok(())
+}
+
+/// Reads `valid-until` from the header of the cached consensus.
+fn consensus_valid_until(dir: &Path) -> io::Result<u64> {
+    let consensus = fs::read(dir.join(CONSENSUS_FILE))?;
+
+    // The header is at the top; avoid scanning the whole router list.
+    let head = String::from_utf8_lossy(&consensus[..consensus.len().min(4096)]);
+    head.lines()
+        .find_map(|line| line.strip_prefix("valid-until "))
+        .and_then(parse_dir_time)
+        .ok_or_else(|| io::Error::new(io::ErrorKind::InvalidData, "Consensus has no valid-until"))
+}
+
+/// Parses directory timestamps (`2024-05-01 12:00:00`, always UTC).
+fn parse_dir_time(value: &str) -> Option<u64> {
+    let (date, time) = value.trim().split_once(' ')?;
+
+    let date: Vec<u64> = date.split('-').filter_map(|p| p.parse().ok()).collect();
+    let time: Vec<u64> = time.split(':').filter_map(|p| p.parse().ok()).collect();
+    if date.len() != 3 || time.len() != 3 {
+        return None;
+    }
+
+    datetime::unix_time(date[0] as i64, date[1], date[2], time[0], time[1], time[2])
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const PAST: &str = "2020-01-01 00:00:00";
+    const FUTURE: &str = "2999-01-01 00:00:00";
+    const LATER_FUTURE: &str = "2999-06-01 00:00:00";
+
+    /// A directory with a consensus valid until `valid_until` and one other
+    /// cache file holding `marker`.
+    fn cache_dir(name: &str, valid_until: &str, marker: &str) -> PathBuf {
+        let dir = temp_dir(name);
+        fs::create_dir_all(&dir).unwrap();
+        fs::write(
+            dir.join(CONSENSUS_FILE),
+            format!(
+                "network-status-version 3 microdesc\nvalid-until {}\n",
+                valid_until
+            ),
+        )
+        .unwrap();
+        fs::write(dir.join("cached-certs"), marker).unwrap();
+        dir
+    }
+
+    fn temp_dir(name: &str) -> PathBuf {
+        let dir =
+            std::env::temp_dir().join(format!("rnt-snapshot-{}-{}", name, std::process::id()));
+        let _ = fs::remove_dir_all(&dir);
+        dir
+    }
+
+    #[test]
+    fn parses_directory_times() {
+        assert_eq!(parse_dir_time("2024-05-01 12:00:00"), Some(1_714_564_800));
+        assert_eq!(parse_dir_time("2024-05-01T12:00:00"), None);
+        assert_eq!(parse_dir_time("2024-05 12:00:00"), None);
+        assert_eq!(parse_dir_time(""), None);
+    }
+
+    #[test]
+    fn consensus_stays_usable_for_a_day_past_valid_until() {
+        let now = now_secs();
+        assert!(is_usable(now + 3600));
+        assert!(is_usable(now - REASONABLY_LIVE_SECS + 600));
+        assert!(!is_usable(now - REASONABLY_LIVE_SECS - 600));
+    }
+
+    #[test]
+    fn seeds_an_empty_data_directory() {
+        let snapshot = cache_dir("seed-from", FUTURE, "snapshot");
+        let data = temp_dir("seed-to");
+
+        assert!(!has_usable_consensus(&data));
+        assert_eq!(
+            seed(&snapshot, &data).unwrap(),
+            parse_dir_time(FUTURE).unwrap()
+        );
+        assert!(has_usable_consensus(&data));
+        assert_eq!(
+            fs::read_to_string(data.join("cached-certs")).unwrap(),
+            "snapshot"
+        );
+        assert!(!data.join("cached-microdescs").exists());
+        assert!(!data.join("cached-certs.tmp").exists());
+
+        for dir in [snapshot, data] {
+            fs::remove_dir_all(dir).unwrap();
+        }
+    }
+
+    #[test]
+    fn keeps_a_newer_consensus() {
+        let snapshot = cache_dir("older", FUTURE, "snapshot");
+        let data = cache_dir("newer", LATER_FUTURE, "data");
+
+        let error = seed(&snapshot, &data).unwrap_err();
+        assert_eq!(error.kind(), io::ErrorKind::AlreadyExists);
+        assert_eq!(
+            fs::read_to_string(data.join("cached-certs")).unwrap(),
+            "data"
+        );
+
+        // The other way round the target is older and gets replaced.
+        seed(&data, &snapshot).unwrap();
+        assert_eq!(
+            fs::read_to_string(snapshot.join("cached-certs")).unwrap(),
+            "data"
+        );
+
+        for dir in [snapshot, data] {
+            fs::remove_dir_all(dir).unwrap();
+        }
+    }
+
+    #[test]
+    fn refuses_an_expired_snapshot() {
+        let expired = cache_dir("expired", PAST, "");
+        let data = temp_dir("unused");
+
+        assert!(!has_usable_consensus(&expired));
+        assert!(seed(&expired, &data).is_err());
+        assert!(!data.exists());
+
+        fs::remove_dir_all(expired).unwrap();
+    }
+
+    #[test]
+    fn exports_the_directory_cache() {
+        let data = cache_dir("export-from", FUTURE, "data");
+        let snapshot = temp_dir("export-to");
+
+        assert_eq!(
+            export(&data, &snapshot).unwrap(),
+            parse_dir_time(FUTURE).unwrap()
+        );
+        assert_eq!(
+            fs::read_to_string(snapshot.join("cached-certs")).unwrap(),
+            "data"
+        );
+
+        for dir in [snapshot, data] {
+            fs::remove_dir_all(dir).unwrap();
+        }
+    }
+}
@@ -0,0 +1,297 @@
+#[cfg(unix)]
+use std::os::unix::net::UnixStream;
+use std::{
+    io::{self, Read, Write},
+    net::{Shutdown, SocketAddr, TcpStream},
+    time::Duration,
+};
+
+const SOCKS_VERSION: u8 = 0x05;
+const AUTH_NONE: u8 = 0x00;
+const AUTH_USERPASS: u8 = 0x02;
+const USERPASS_VERSION: u8 = 0x01;
+const CMD_CONNECT: u8 = 0x01;
+const ATYP_IPV4: u8 = 0x01;
+const ATYP_DOMAIN: u8 = 0x03;
+const ATYP_IPV6: u8 = 0x04;
+
+/// Prefix of proxy addresses naming a Unix domain socket, as in Tor's
+/// `SocksPort unix:/path` syntax.
+pub const UNIX_PREFIX: &str = "unix:";
+
+/// SOCKS5 username/password credentials (RFC 1929).
+///
+/// Tor does not check them, but with `IsolateSOCKSAuth` (on by default) streams
+/// with different credentials never share a circuit.
+#[derive(Debug, Clone, PartialEq, Eq, Hash)]
+pub struct Auth {
+    pub username: String,
+    pub password: String,
+}
+
+/// Connection to the SOCKS proxy, over TCP or a Unix domain socket.
+pub enum Stream {
+    Tcp(TcpStream),
+    #[cfg(unix)]
+    Unix(UnixStream),
+}
+
+impl Stream {
+    pub fn try_clone(&self) -> io::Result<Stream> {
+        match self {
+            Stream::Tcp(stream) => stream.try_clone().map(Stream::Tcp),
+            #[cfg(unix)]
+            Stream::Unix(stream) => stream.try_clone().map(Stream::Unix),
+        }
+    }
+
+    pub fn shutdown(&self, how: Shutdown) -> io::Result<()> {
+        match self {
+            Stream::Tcp(stream) => stream.shutdown(how),
+            #[cfg(unix)]
+            Stream::Unix(stream) => stream.shutdown(how),
+        }
+    }
+
+    pub fn set_read_timeout(&self, timeout: Option<Duration>) -> io::Result<()> {
+        match self {
+            Stream::Tcp(stream) => stream.set_read_timeout(timeout),
+            #[cfg(unix)]
+            Stream::Unix(stream) => stream.set_read_timeout(timeout),
+        }
+    }
+
+    pub fn set_write_timeout(&self, timeout: Option<Duration>) -> io::Result<()> {
+        match self {
+            Stream::Tcp(stream) => stream.set_write_timeout(timeout),
+            #[cfg(unix)]
+            Stream::Unix(stream) => stream.set_write_timeout(timeout),
+        }
+    }
+}
+
+impl Read for Stream {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        match self {
+            Stream::Tcp(stream) => stream.read(buf),
+            #[cfg(unix)]
+            Stream::Unix(stream) => stream.read(buf),
+        }
+    }
+}
+
+impl Write for Stream {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        match self {
+            Stream::Tcp(stream) => stream.write(buf),
+            #[cfg(unix)]
+            Stream::Unix(stream) => stream.write(buf),
+        }
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        match self {
+            Stream::Tcp(stream) => stream.flush(),
+            #[cfg(unix)]
+            Stream::Unix(stream) => stream.flush(),
+        }
+    }
+}
+
+/// Opens a stream to `host:port` through the SOCKS5 proxy at `proxy`.
+pub fn connect(
+    proxy: &str,
+    host: &str,
+    port: u16,
+    timeout: Duration,
+    auth: Option<&Auth>,
+) -> io::Result<Stream> {
+    let stream = open(proxy, timeout)?;
+    negotiate(stream, host, port, auth)
+}
+
+/// Connects to the SOCKS5 proxy at `proxy`, without starting the handshake.
+///
+/// `proxy` is either `host:port` or `unix:/path/to/socket`. Split from
+/// [`negotiate`] so callers can keep a handle on the socket while Tor is
+/// still building the circuit.
+pub fn open(proxy: &str, timeout: Duration) -> io::Result<Stream> {
+    if let Some(path) = proxy.strip_prefix(UNIX_PREFIX) {
+        return open_unix(path, timeout);
+    }
+
+    let proxy_addr: SocketAddr = proxy
+        .parse()
+        .map_err(|_| io::Error::new(io::ErrorKind::InvalidInput, "Invalid SOCKS proxy address"))?;
+
+    let stream = TcpStream::connect_timeout(&proxy_addr, timeout)?;
+    stream.set_read_timeout(Some(timeout))?;
+    stream.set_write_timeout(Some(timeout))?;
+    stream.set_nodelay(true)?;
+    Ok(Stream::Tcp(stream))
+}
+
+#[cfg(unix)]
+fn open_unix(path: &str, timeout: Duration) -> io::Result<Stream> {
+    // Connecting to a local socket either succeeds or fails immediately, so
+    // only reads and writes need a timeout.
+    let stream = UnixStream::connect(path)?;
+    stream.set_read_timeout(Some(timeout))?;
+    stream.set_write_timeout(Some(timeout))?;
+    Ok(Stream::Unix(stream))
+}
+
+#[cfg(not(unix))]
+fn open_unix(_path: &str, _timeout: Duration) -> io::Result<Stream> {
+    Err(io::Error::new(
+        io::ErrorKind::Unsupported,
+        "Unix domain sockets are not supported on this platform",
+    ))
+}
+
+/// Runs the SOCKS5 handshake on a stream returned by [`open`], asking the
+/// proxy to connect to `host:port`.
+///
+/// The hostname is always sent to the proxy unresolved (ATYP domain) so that
+/// DNS resolution happens inside Tor and `.onion` addresses work.
+pub fn negotiate(
+    mut stream: Stream,
+    host: &str,
+    port: u16,
+    auth: Option<&Auth>,
+) -> io::Result<Stream> {
+    handshake(&mut stream, host, port, auth)?;
+    Ok(stream)
+}
+
+fn handshake<S: Read + Write>(
+    stream: &mut S,
+    host: &str,
+    port: u16,
+    auth: Option<&Auth>,
+) -> io::Result<()> {
+    if host.len() > 255 {
+        return Err(io::Error::new(
+            io::ErrorKind::InvalidInput,
+            "Hostname too long for SOCKS5",
+        ));
+    }
+
+    // Greeting, offering exactly the method we intend to use.
+    let method = if auth.is_some() {
+        AUTH_USERPASS
+    } else {
+        AUTH_NONE
+    };
+    stream.write_all(&[SOCKS_VERSION, 1, method])?;
+
+    let mut choice = [0u8; 2];
+    stream.read_exact(&mut choice)?;
+    if choice[0] != SOCKS_VERSION || choice[1] != method {
+        return Err(io::Error::other(
+            "SOCKS proxy rejected authentication method",
+        ));
+    }
+
+    if let Some(auth) = auth {
+        authenticate(stream, auth)?;
+    }
+
+    // CONNECT request with the hostname left for Tor to resolve.
+    let mut request = Vec::with_capacity(7 + host.len());
+    request.extend_from_slice(&[
+        SOCKS_VERSION,
+        CMD_CONNECT,
+        0x00,
+        ATYP_DOMAIN,
+        host.len() as u8,
+    ]);
+    request.extend_from_slice(host.as_bytes());
+    request.extend_from_slice(&port.to_be_bytes());
+    stream.write_all(&request)?;
+
+    let mut reply = [0u8; 4];
+    stream.read_exact(&mut reply)?;
+    if reply[0] != SOCKS_VERSION {
+        return Err(io::Error::other("Invalid SOCKS reply"));
+    }
+    if reply[1] != 0x00 {
+        return Err(io::Error::new(
+            io::ErrorKind::ConnectionRefused,
+            reply_message(reply[1]),
+        ));
+    }
+
+    // Drain the bound address; Tor always reports 0.0.0.0:0 but the length
+    // still depends on the address type.
+    let addr_len = match reply[3] {
+        ATYP_IPV4 => 4,
+        ATYP_IPV6 => 16,
+        ATYP_DOMAIN => {
+            let mut len = [0u8; 1];
+            stream.read_exact(&mut len)?;
+            len[0] as usize
+        }
+        _ => return Err(io::Error::other("Invalid SOCKS reply address type")),
+    };
+    let mut bound = vec![0u8; addr_len + 2];
+    stream.read_exact(&mut bound)?;
+
+    Ok(())
+}
+
+fn authenticate<S: Read + Write>(stream: &mut S, auth: &Auth) -> io::Result<()> {
+    if auth.username.is_empty()
+        || auth.username.len() > 255
+        || auth.password.is_empty()
+        || auth.password.len() > 255
+    {
+        return Err(io::Error::new(
+            io::ErrorKind::InvalidInput,
+            "SOCKS5 username and password must be 1-255 bytes",
+        ));
+    }
+
+    let mut request = Vec::with_capacity(3 + auth.username.len() + auth.password.len());
+    request.push(USERPASS_VERSION);
+    request.push(auth.username.len() as u8);
+    request.extend_from_slice(auth.username.as_bytes());
+    request.push(auth.password.len() as u8);
+    request.extend_from_slice(auth.password.as_bytes());
+    stream.write_all(&request)?;
+
+    let mut reply = [0u8; 2];
+    stream.read_exact(&mut reply)?;
+    if reply[1] != 0x00 {
+        return Err(io::Error::new(
+            io::ErrorKind::PermissionDenied,
+            "SOCKS proxy rejected credentials",
+        ));
+    }
+    Ok(())
+}
+
+/// Maps SOCKS5 reply codes, including Tor's onion-service extensions
+/// (`ExtendedErrors`), to readable messages.
+fn reply_message(code: u8) -> String {
+    let reason = match code {
+        0x01 => "general SOCKS server failure",
+        0x02 => "connection not allowed by ruleset",
+        0x03 => "network unreachable",
+        0x04 => "host unreachable",
+        0x05 => "connection refused",
+        0x06 => "TTL expired",
+        0x07 => "command not supported",
+        0x08 => "address type not supported",
+        0xF0 => "onion service descriptor can not be found",
+        0xF1 => "onion service descriptor is invalid",
+        0xF2 => "onion service introduction failed",
+        0xF3 => "onion service rendezvous failed",
+        0xF4 => "onion service missing client authorization",
+        0xF5 => "onion service wrong client authorization",
+        0xF6 => "onion service invalid address",
+        0xF7 => "onion service introduction timed out",
+        _ => "unknown error",
+    };
+    format!("SOCKS connect failed: {} (0x{:02x})", reason, code)
+}
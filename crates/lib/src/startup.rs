@@ -0,0 +1,251 @@
+use std::{
+    sync::Mutex,
+    thread,
+    time::{Duration, Instant},
+};
+
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use serde::Serialize;
+
+use crate::tor;
+
+const BOOTSTRAP_POLL: Duration = Duration::from_millis(50);
+const BOOTSTRAP_WAIT: Duration = Duration::from_secs(300);
+
+static REPORT: OnceCell<Mutex<StartupReport>> = OnceCell::new();
+static SEEDED_DIR: OnceCell<Mutex<Option<String>>> = OnceCell::new();
+
+/// Timing of library setup and of the most recent service start.
+#[derive(Clone, Default, Serialize)]
+pub struct StartupReport {
+    pub library: LibraryTiming,
+    /// "cold" (no usable directory cache), "snapshot" (seeded from a
+    /// snapshot) or "warm" (cache left by a previous run).
+    pub start_kind: String,
+    /// Time spent in `OwnedTorService::new`.
+    pub service_init_ms: u64,
+    /// Time from the start of `init_tor_service` until bootstrap was Done,
+    /// 0 while still bootstrapping.
+    pub time_to_done_ms: u64,
+    /// Bootstrap phases in the order they were observed.
+    pub phases: Vec<PhaseMark>,
+    /// torrc options from the profile or overrides that Tor rejected.
+    pub config_errors: Vec<String>,
+    pub error: String,
+}
+
+/// Cost of `initialize_tor_library`, measured once per process.
+#[derive(Clone, Default, Serialize)]
+pub struct LibraryTiming {
+    pub logger_ms: f64,
+    pub runtime_ms: f64,
+    pub total_ms: f64,
+}
+
+#[derive(Clone, Serialize)]
+pub struct PhaseMark {
+    /// Tor's bootstrap tag, e.g. `conn_dir`, `handshake`, `requesting_status`,
+    /// `loading_descriptors`, `circuit_create` or `done`.
+    pub phase: String,
+    /// Bootstrap progress in percent, when Tor reports it.
+    pub progress: u32,
+    pub summary: String,
+    /// Milliseconds since `init_tor_service` started.
+    pub at_ms: u64,
+}
+
+/// A bootstrap phase as read from Tor.
+pub struct Phase {
+    pub tag: String,
+    pub progress: u32,
+    pub summary: String,
+}
+
+fn report() -> &'static Mutex<StartupReport> {
+    REPORT.get_or_init(|| Mutex::new(StartupReport::default()))
+}
+
+fn seeded_dir() -> &'static Mutex<Option<String>> {
+    SEEDED_DIR.get_or_init(|| Mutex::new(None))
+}
+
+pub fn set_library_timing(timing: LibraryTiming) {
+    debug!(
+        "Rust FFI: Library initialized in {:.1} ms (logger {:.1} ms, runtime {:.1} ms)",
+        timing.total_ms, timing.logger_ms, timing.runtime_ms
+    );
+    report().lock().unwrap().library = timing;
+}
+
+/// Remembers that `data_dir` was seeded from a snapshot for this start.
+pub fn note_seeded(data_dir: &str) {
+    *seeded_dir().lock().unwrap() = Some(data_dir.to_string());
+}
+
+/// Resets the service part of the report for a start in `data_dir`.
+pub fn begin(data_dir: &str, has_usable_consensus: bool) -> Instant {
+    let seeded = seeded_dir().lock().unwrap().take().as_deref() == Some(data_dir);
+    let start_kind = if seeded {
+        "snapshot"
+    } else if has_usable_consensus {
+        "warm"
+    } else {
+        "cold"
+    };
+
+    let mut report = report().lock().unwrap();
+    *report = StartupReport {
+        library: report.library.clone(),
+        start_kind: start_kind.to_string(),
+        ..Default::default()
+    };
+    Instant::now()
+}
+
+pub fn failed(error: String) {
+    report().lock().unwrap().error = error;
+}
+
+/// Why the last start failed, empty if it did not.
+pub fn error() -> String {
+    report().lock().unwrap().error.clone()
+}
+
+pub fn config_rejected(errors: Vec<String>) {
+    report().lock().unwrap().config_errors = errors;
+}
+
+/// Records the service creation and follows bootstrap in the background.
+///
+/// Phases are sampled from the moment `OwnedTorService::new` returns; if it
+/// only returns once bootstrap is complete, earlier phases collapse into
+/// `service_init_ms`.
+pub fn service_created(started: Instant) {
+    let service_init_ms = started.elapsed().as_millis() as u64;
+    report().lock().unwrap().service_init_ms = service_init_ms;
+
+    thread::spawn(move || {
+        while started.elapsed() < BOOTSTRAP_WAIT {
+            let Some(phase) = tor::bootstrap_phase() else {
+                // The service was shut down.
+                return;
+            };
+            let at_ms = started.elapsed().as_millis() as u64;
+            if observe(&mut report().lock().unwrap(), phase, at_ms) {
+                return;
+            }
+            thread::sleep(BOOTSTRAP_POLL);
+        }
+    });
+}
+
+/// Adds `phase` to the report unless it is the one seen last. Returns
+/// whether bootstrap is done.
+fn observe(report: &mut StartupReport, phase: Phase, at_ms: u64) -> bool {
+    let done = phase.tag == "done";
+    if report
+        .phases
+        .last()
+        .map(|last| last.phase != phase.tag)
+        .unwrap_or(true)
+    {
+        debug!(
+            "Rust FFI: Bootstrap {}% {} at {} ms",
+            phase.progress, phase.tag, at_ms
+        );
+        report.phases.push(PhaseMark {
+            phase: phase.tag,
+            progress: phase.progress,
+            summary: phase.summary,
+            at_ms,
+        });
+    }
+
+    if done {
+        report.time_to_done_ms = at_ms;
+        debug!(
+            "Rust FFI: Bootstrap ({}) done in {} ms",
+            report.start_kind, at_ms
+        );
+    }
+    done
+}
+
+pub fn report_json() -> String {
+    let report = report().lock().unwrap().clone();
+    serde_json::to_string(&report).unwrap_or_else(|_| "{}".to_string())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn phase(tag: &str, progress: u32) -> Phase {
+        Phase {
+            tag: tag.to_string(),
+            progress,
+            summary: format!("{} summary", tag),
+        }
+    }
+
+    #[test]
+    fn records_each_phase_once_until_done() {
+        let mut report = StartupReport::default();
+        assert!(!observe(&mut report, phase("conn_dir", 5), 40));
+        assert!(!observe(&mut report, phase("conn_dir", 5), 90));
+        assert!(!observe(&mut report, phase("loading_descriptors", 45), 700));
+        assert_eq!(report.time_to_done_ms, 0);
+        assert!(observe(&mut report, phase("done", 100), 2100));
+
+        let phases: Vec<(&str, u32, u64)> = report
+            .phases
+            .iter()
+            .map(|mark| (mark.phase.as_str(), mark.progress, mark.at_ms))
+            .collect();
+        assert_eq!(
+            phases,
+            [
+                ("conn_dir", 5, 40),
+                ("loading_descriptors", 45, 700),
+                ("done", 100, 2100)
+            ]
+        );
+        assert_eq!(report.phases[0].summary, "conn_dir summary");
+        assert_eq!(report.time_to_done_ms, 2100);
+    }
+
+    #[test]
+    fn each_start_resets_the_report_and_names_its_kind() {
+        set_library_timing(LibraryTiming {
+            logger_ms: 1.0,
+            runtime_ms: 2.0,
+            total_ms: 3.0,
+        });
+
+        begin("/data/a", false);
+        assert_eq!(report().lock().unwrap().start_kind, "cold");
+        failed("refused".to_string());
+        config_rejected(vec!["NumCPUs: invalid".to_string()]);
+
+        begin("/data/a", true);
+        {
+            let report = report().lock().unwrap();
+            assert_eq!(report.start_kind, "warm");
+            assert!(report.error.is_empty() && report.config_errors.is_empty());
+            assert_eq!(report.library.total_ms, 3.0);
+        }
+
+        // A snapshot only counts for the data directory it was seeded into,
+        // and only for the next start.
+        note_seeded("/data/b");
+        begin("/data/a", true);
+        assert_eq!(report().lock().unwrap().start_kind, "warm");
+        note_seeded("/data/a");
+        begin("/data/a", true);
+        assert_eq!(report().lock().unwrap().start_kind, "snapshot");
+        begin("/data/a", true);
+        assert_eq!(report().lock().unwrap().start_kind, "warm");
+        assert!(report_json().contains(r#""start_kind":"warm""#));
+    }
+}
@@ -0,0 +1,332 @@
+use std::{
+    collections::{HashMap, VecDeque},
+    io::{self, Read, Write},
+    net::Shutdown,
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        Arc, Condvar, Mutex,
+    },
+    thread,
+};
+
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+
+use crate::events;
+use crate::socks;
+
+/// Bytes the pump buffers before it stops reading, which makes Tor apply
+/// flow control on the circuit until JS catches up.
+const MAX_BUFFERED: usize = 1024 * 1024;
+const READ_CHUNK: usize = 16 * 1024;
+
+static NEXT_ID: AtomicU64 = AtomicU64::new(1);
+static STREAMS: OnceCell<Mutex<HashMap<u64, Arc<Entry>>>> = OnceCell::new();
+/// Streams that became readable, waiting to be reported by [`take_ready`].
+static READY: OnceCell<Mutex<Vec<u64>>> = OnceCell::new();
+
+struct Entry {
+    socket: Mutex<socks::Stream>,
+    inbox: Mutex<Inbox>,
+    /// Signalled when the inbox gains data, reaches the end or frees space.
+    changed: Condvar,
+}
+
+#[derive(Default)]
+struct Inbox {
+    data: VecDeque<u8>,
+    eof: bool,
+    error: Option<String>,
+    closed: bool,
+    /// Reported readable and not yet read empty; set, the stream is not
+    /// reported again.
+    announced: bool,
+}
+
+/// Bytes taken from a stream by [`read`].
+pub struct Chunk {
+    pub data: Vec<u8>,
+    /// The peer closed its side and every byte has been read.
+    pub eof: bool,
+}
+
+fn streams() -> &'static Mutex<HashMap<u64, Arc<Entry>>> {
+    STREAMS.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+fn ready() -> &'static Mutex<Vec<u64>> {
+    READY.get_or_init(|| Mutex::new(Vec::new()))
+}
+
+fn entry(id: u64) -> io::Result<Arc<Entry>> {
+    streams()
+        .lock()
+        .unwrap()
+        .get(&id)
+        .cloned()
+        .ok_or_else(|| io::Error::new(io::ErrorKind::NotFound, "Unknown stream"))
+}
+
+/// Registers a connected SOCKS stream and starts reading from it.
+///
+/// A single thread per stream moves incoming bytes into a bounded buffer, so
+/// reads and writes from JS never wait on each other or on the network.
+pub fn open(socket: socks::Stream) -> io::Result<u64> {
+    // Writes keep the connect timeout; reads block in the pump until data
+    // arrives or the stream is closed.
+    socket.set_read_timeout(None)?;
+    let reader = socket.try_clone()?;
+
+    let id = NEXT_ID.fetch_add(1, Ordering::Relaxed);
+    let entry = Arc::new(Entry {
+        socket: Mutex::new(socket),
+        inbox: Mutex::new(Inbox::default()),
+        changed: Condvar::new(),
+    });
+    streams().lock().unwrap().insert(id, entry.clone());
+
+    thread::spawn(move || pump(id, reader, entry));
+    debug!("Rust FFI: Opened stream {}", id);
+    Ok(id)
+}
+
+fn pump(id: u64, mut reader: socks::Stream, entry: Arc<Entry>) {
+    let mut buf = vec![0u8; READ_CHUNK];
+
+    loop {
+        {
+            let mut inbox = entry.inbox.lock().unwrap();
+            while inbox.data.len() >= MAX_BUFFERED && !inbox.closed {
+                inbox = entry.changed.wait(inbox).unwrap();
+            }
+            if inbox.closed {
+                return;
+            }
+        }
+
+        let result = reader.read(&mut buf);
+        let mut inbox = entry.inbox.lock().unwrap();
+        match result {
+            Ok(0) => inbox.eof = true,
+            Ok(n) => inbox.data.extend(&buf[..n]),
+            Err(e) if e.kind() == io::ErrorKind::Interrupted => continue,
+            Err(e) => {
+                if !inbox.closed {
+                    debug!("Rust FFI: Stream {} read failed {:?}", id, e);
+                    inbox.error = Some(e.to_string());
+                }
+            }
+        }
+        let done = inbox.eof || inbox.error.is_some();
+        entry.changed.notify_all();
+        if !inbox.announced && !inbox.closed {
+            inbox.announced = true;
+            ready().lock().unwrap().push(id);
+            events::notify();
+        }
+        if done {
+            return;
+        }
+    }
+}
+
+/// Writes all of `data` to the stream.
+pub fn write(id: u64, data: &[u8]) -> io::Result<()> {
+    let entry = entry(id)?;
+    let mut socket = entry.socket.lock().unwrap();
+    socket.write_all(data)?;
+    socket.flush()
+}
+
+/// Takes up to `max_bytes` of buffered data without waiting.
+///
+/// Returns an empty chunk when nothing is buffered; the stream is then
+/// reported by [`take_ready`] once something arrives. Errors are reported
+/// once the data received before them has been read.
+pub fn read(id: u64, max_bytes: usize) -> io::Result<Chunk> {
+    let entry = entry(id)?;
+    let mut inbox = entry.inbox.lock().unwrap();
+
+    if inbox.data.is_empty() {
+        if let Some(error) = &inbox.error {
+            return Err(io::Error::new(io::ErrorKind::Other, error.clone()));
+        }
+    }
+
+    let n = inbox.data.len().min(max_bytes.max(1));
+    let data: Vec<u8> = inbox.data.drain(..n).collect();
+    let eof = inbox.data.is_empty() && (inbox.eof || inbox.closed);
+    if inbox.data.is_empty() && !eof {
+        inbox.announced = false;
+    }
+    entry.changed.notify_all();
+    Ok(Chunk { data, eof })
+}
+
+/// Takes the streams that became readable since the previous call.
+pub fn take_ready() -> Vec<u64> {
+    std::mem::take(&mut *ready().lock().unwrap())
+}
+
+/// Half-closes the stream: the peer sees the end of our data while reads
+/// keep working until it closes its side.
+pub fn shutdown_write(id: u64) -> io::Result<()> {
+    entry(id)?.socket.lock().unwrap().shutdown(Shutdown::Write)
+}
+
+/// Closes the stream and drops any unread data.
+pub fn close(id: u64) -> bool {
+    let Some(entry) = streams().lock().unwrap().remove(&id) else {
+        return false;
+    };
+
+    entry.inbox.lock().unwrap().closed = true;
+    entry.changed.notify_all();
+    // Unblocks the pump if it is waiting in read().
+    let _ = entry.socket.lock().unwrap().shutdown(Shutdown::Both);
+    debug!("Rust FFI: Closed stream {}", id);
+    true
+}
+
+/// Closes every stream, e.g. when the service shuts down.
+pub fn close_all() {
+    let ids: Vec<u64> = streams().lock().unwrap().keys().copied().collect();
+
+    for id in ids {
+        close(id);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::{
+        net::{TcpListener, TcpStream},
+        time::{Duration, Instant},
+    };
+
+    /// Opens a stream over loopback and returns its id with the peer's end.
+    fn connected() -> (u64, TcpStream) {
+        let listener = TcpListener::bind("127.0.0.1:0").unwrap();
+        let socket = TcpStream::connect(listener.local_addr().unwrap()).unwrap();
+        let (peer, _) = listener.accept().unwrap();
+        (open(socks::Stream::Tcp(socket)).unwrap(), peer)
+    }
+
+    fn buffered(id: u64) -> usize {
+        entry(id).unwrap().inbox.lock().unwrap().data.len()
+    }
+
+    fn wait_until(mut done: impl FnMut() -> bool) {
+        let deadline = Instant::now() + Duration::from_secs(5);
+        while !done() {
+            assert!(Instant::now() < deadline, "timed out");
+            thread::sleep(Duration::from_millis(5));
+        }
+    }
+
+    #[test]
+    fn reports_readable_streams_once_until_drained() {
+        let (id, mut peer) = connected();
+        assert!(read(id, 64).unwrap().data.is_empty());
+
+        let mut announced = Vec::new();
+        peer.write_all(b"hello").unwrap();
+        wait_until(|| {
+            announced.extend(take_ready());
+            announced.contains(&id)
+        });
+        peer.write_all(b" world").unwrap();
+        wait_until(|| buffered(id) == 11);
+        assert!(!take_ready().contains(&id));
+
+        let chunk = read(id, 5).unwrap();
+        assert_eq!(chunk.data, b"hello");
+        assert!(!chunk.eof);
+        assert_eq!(read(id, 64).unwrap().data, b" world");
+
+        // Drained, so the next arrival is reported again.
+        peer.write_all(b"!").unwrap();
+        let mut announced = Vec::new();
+        wait_until(|| {
+            announced.extend(take_ready());
+            announced.contains(&id)
+        });
+        assert!(close(id));
+    }
+
+    #[test]
+    fn reports_eof_after_the_last_byte() {
+        let (id, mut peer) = connected();
+        peer.write_all(b"bye").unwrap();
+        drop(peer);
+
+        wait_until(|| entry(id).unwrap().inbox.lock().unwrap().eof);
+        let chunk = read(id, 2).unwrap();
+        assert_eq!(chunk.data, b"by");
+        assert!(!chunk.eof);
+        let chunk = read(id, 2).unwrap();
+        assert_eq!(chunk.data, b"e");
+        assert!(chunk.eof);
+        close(id);
+    }
+
+    #[test]
+    fn stops_reading_while_the_buffer_is_full() {
+        let (id, mut peer) = connected();
+        let total = MAX_BUFFERED * 3;
+        let writer = thread::spawn(move || {
+            peer.write_all(&vec![7u8; total]).unwrap();
+        });
+
+        wait_until(|| buffered(id) >= MAX_BUFFERED);
+        thread::sleep(Duration::from_millis(50));
+        assert!(buffered(id) < MAX_BUFFERED + READ_CHUNK);
+
+        // Reading frees space and lets the rest through.
+        let mut received = 0;
+        let mut eof = false;
+        while !eof {
+            let chunk = read(id, 64 * 1024).unwrap();
+            received += chunk.data.len();
+            assert!(chunk.data.iter().all(|&b| b == 7));
+            eof = chunk.eof;
+            if chunk.data.is_empty() {
+                thread::sleep(Duration::from_millis(1));
+            }
+        }
+        writer.join().unwrap();
+        assert_eq!(received, total);
+        close(id);
+    }
+
+    #[test]
+    fn writes_and_half_closes() {
+        let (id, mut peer) = connected();
+        write(id, b"ping").unwrap();
+        shutdown_write(id).unwrap();
+
+        let mut received = Vec::new();
+        peer.read_to_end(&mut received).unwrap();
+        assert_eq!(received, b"ping");
+
+        // Reads keep working after our side is closed.
+        peer.write_all(b"pong").unwrap();
+        wait_until(|| buffered(id) == 4);
+        assert_eq!(read(id, 64).unwrap().data, b"pong");
+        close(id);
+    }
+
+    #[test]
+    fn closed_streams_are_forgotten() {
+        let (id, mut peer) = connected();
+        assert!(close(id));
+        assert!(!close(id));
+        assert_eq!(read(id, 1).err().unwrap().kind(), io::ErrorKind::NotFound);
+        assert!(write(id, b"x").is_err());
+
+        let mut rest = Vec::new();
+        peer.read_to_end(&mut rest).unwrap();
+        assert!(rest.is_empty());
+    }
+}
@@ -1,43 +1,169 @@
-use std::{collections::HashMap, sync::Mutex};
+use std::{
+    collections::HashMap,
+    mem,
+    net::TcpListener,
+    path::{Path, PathBuf},
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        Arc, Mutex,
+    },
+    time::{Duration, Instant},
+};
 
 use logger::{log::debug, Logger};
 use once_cell::sync::OnceCell;
 use tor::{
-    ensure_runtime,
-    http_client::{make_http_request, HttpMethod, HttpRequestParams},
-    OwnedTorService, OwnedTorServiceBootstrapPhase, TorHiddenServiceParam, TorServiceParam,
+    ensure_runtime, OwnedTorService, OwnedTorServiceBootstrapPhase, TorHiddenServiceParam, TorServiceParam,
 };
 
-use crate::ffi::bridging::{HiddenServiceResponse, HttpResponse, StartTorResponse};
+use crate::ffi::bridging::{
+    DirectorySnapshotResponse, HiddenServiceResponse, HttpResponse, HttpServerResponse,
+    OnionPublishResponse, ProxyResponse, ResumeResponse, StartTorResponse, StreamReadResponse, StreamResponse, TorListeners, WebSocketResponse,
+};
+use crate::cache;
+use crate::control;
+use crate::dormant;
+use crate::events;
+use crate::files;
+use crate::hedge;
+use crate::hsdesc;
+use crate::inbound;
+use crate::http::{self, Method};
+use crate::isolation;
+use crate::metrics;
+use crate::onion;
+use crate::prewarm;
+use crate::profile;
+use crate::proxy;
+use crate::publish;
+use crate::server;
+use crate::snapshot;
+use crate::startup;
+use crate::singleflight::Group;
+use crate::socks;
+use crate::streams;
+use crate::websocket;
 
+use base64::{engine::general_purpose::STANDARD, Engine};
 use hex;
 use sha2::{Digest, Sha512};
 use serde::Deserialize;
 
 static INITIALIZED: OnceCell<bool> = OnceCell::new();
-static TOR_SERVICE: OnceCell<Mutex<Option<OwnedTorService>>> = OnceCell::new();
+static TOR_SERVICE: OnceCell<Mutex<Option<Arc<Instance>>>> = OnceCell::new();
+static GET_FLIGHTS: OnceCell<Group<FlightKey, FetchResult>> = OnceCell::new();
+static NEXT_ONION_SOCKET: AtomicU64 = AtomicU64::new(1);
 
-fn ensure_tor_service() -> &'static Mutex<Option<OwnedTorService>> {
+const SOCKS_SOCKET_FILE: &str = "socks.sock";
+// sun_path is 104 bytes on iOS and 108 on Android, including the NUL.
+const MAX_SOCKET_PATH: usize = 103;
+/// Starts tried with a newly picked SOCKS port when another process took the
+/// previous one before Tor bound it.
+const SOCKS_PORT_ATTEMPTS: usize = 3;
+
+/// The Tor client of this process, with its data directory, SOCKS endpoint
+/// and service lock.
+///
+/// libtor keeps its configuration, event loop and networking in process-wide
+/// globals, so a second Tor in the same process would share and corrupt
+/// them. There is at most one instance; see [`instance_for_data_dir`].
+struct Instance {
+    data_dir: String,
+    service: Mutex<Option<OwnedTorService>>,
+    socks: Mutex<Option<SocksListeners>>,
+}
+
+fn ensure_tor_service() -> &'static Mutex<Option<Arc<Instance>>> {
     TOR_SERVICE.get_or_init(|| Mutex::new(None))
 }
 
+/// The registered instance, running or still bootstrapping.
+fn instance() -> Option<Arc<Instance>> {
+    ensure_tor_service().lock().unwrap().clone()
+}
+
+fn already_running(data_dir: &str) -> String {
+    format!(
+        "Tor is already running for {}; only one Tor instance can run per process, \
+         shut it down first",
+        data_dir
+    )
+}
+
+/// Registers the instance for `data_dir`, or returns the registered one.
+///
+/// Starting another data directory while one is registered, running or
+/// still bootstrapping, is refused.
+fn instance_for_data_dir(data_dir: &str) -> Result<Arc<Instance>, String> {
+    let mut registered = ensure_tor_service().lock().unwrap();
+    match &*registered {
+        Some(instance) if instance.data_dir == data_dir => Ok(instance.clone()),
+        Some(running) => Err(already_running(&running.data_dir)),
+        None => {
+            let instance = Arc::new(Instance {
+                data_dir: data_dir.to_string(),
+                service: Mutex::new(None),
+                socks: Mutex::new(None),
+            });
+            *registered = Some(instance.clone());
+            Ok(instance)
+        }
+    }
+}
+
+fn remove_instance() {
+    *ensure_tor_service().lock().unwrap() = None;
+}
+
+/// Where the running service accepts SOCKS connections, as bound by Tor.
+#[derive(Clone)]
+struct SocksListeners {
+    port: u16,
+    /// `unix:<path>` listener added next to the TCP port, when available.
+    unix: Option<String>,
+}
+
 pub fn initialize_tor_library() -> bool {
     if INITIALIZED.get().is_some() {
         return true;
     }
 
+    let started = Instant::now();
     let _logger = Logger::new();
+    let logger_ms = elapsed_ms(started);
 
+    let runtime_started = Instant::now();
     let _ = ensure_runtime();
+    let runtime_ms = elapsed_ms(runtime_started);
     let _ = ensure_tor_service();
 
+    startup::set_library_timing(startup::LibraryTiming {
+        logger_ms,
+        runtime_ms,
+        total_ms: elapsed_ms(started),
+    });
+
     match INITIALIZED.set(true) {
         Ok(_) => true,
         Err(_) => false,
     }
 }
 
-pub fn init_tor_service(socks_port: f64, data_dir: String, timeout_ms: f64) -> bool {
+/// Service options beyond the SDK's `TorServiceParam`.
+#[derive(Default)]
+pub struct ServiceOptions {
+    /// Named performance profile, see [`profile::settings`]; empty for Tor's defaults.
+    pub profile: String,
+    /// JSON object of raw torrc options applied after the profile.
+    pub torrc_overrides_json: String,
+}
+
+pub fn init_tor_service(
+    socks_port: f64,
+    data_dir: String,
+    timeout_ms: f64,
+    options: ServiceOptions,
+) -> bool {
     if INITIALIZED.get().is_none() {
         return false;
     }
@@ -47,40 +173,371 @@ pub fn init_tor_service(socks_port: f64, data_dir: String, timeout_ms: f64) -> b
         socks_port, data_dir, timeout_ms
     );
 
-    let param = TorServiceParam {
-        socks_port: Some(socks_port as u16),
-        data_dir: data_dir,
-        bootstrap_timeout_ms: Some(timeout_ms as u64),
+    // Registered first, so a refused start leaves the running instance's
+    // startup report alone. The instance lock is not held while Tor
+    // bootstraps, so status calls stay responsive.
+    let instance = match instance_for_data_dir(&data_dir) {
+        Ok(instance) => instance,
+        Err(e) => {
+            debug!("Rust FFI: {}", e);
+            return false;
+        }
+    };
+    let fail = |e: String| {
+        if instance.service.lock().unwrap().is_none() {
+            remove_instance();
+        }
+        startup::failed(e);
+        false
     };
 
-    debug!(
-        "Rust FFI: Initializing Tor service with parameters: {:?}",
-        param
-    );
+    let started = startup::begin(&data_dir, snapshot::has_usable_consensus(Path::new(&data_dir)));
 
-    match OwnedTorService::new(param) {
+    let settings = match profile::settings(&options.profile, &options.torrc_overrides_json) {
+        Ok(settings) => settings,
+        Err(e) => {
+            debug!("Rust FFI: {}", e);
+            return fail(e);
+        }
+    };
+
+    match start_service(socks_port as u16, &data_dir, timeout_ms) {
         Ok(service) => {
-            *ensure_tor_service().lock().unwrap() = Some(service);
+            // The SDK cannot pass torrc options, so they are set once Tor runs.
+            startup::config_rejected(profile::apply(&service.control_port, &settings));
+            // Before any service exists, so none of their uploads are missed.
+            if let Err(e) = publish::watch(&service.control_port) {
+                debug!("Rust FFI: Cannot follow descriptor uploads {:?}", e);
+            }
+            if let Err(e) = isolation::watch(&service.control_port) {
+                debug!("Rust FFI: Cannot follow circuits {:?}", e);
+            }
+            let port = bound_socks_port(&service.control_port).unwrap_or(service.socks_port);
+            *instance.socks.lock().unwrap() = Some(SocksListeners {
+                port,
+                unix: enable_unix_socks(&service.control_port, port, &data_dir),
+            });
+            *instance.service.lock().unwrap() = Some(service);
+            startup::service_created(started);
+            hsdesc::restore(&data_dir);
             debug!("Rust FFI: Tor service initialized!");
             true
         }
         Err(e) => {
-            debug!("Rust FFI: Error initializing Tor service! {:?}", e);
-            false
+            debug!("Rust FFI: Error initializing Tor service! {}", e);
+            fail(e)
+        }
+    }
+}
+
+/// Creates the SDK service, on any free SOCKS port when `socks_port` is 0.
+///
+/// The SDK takes a fixed port rather than `auto`, so a free one is picked
+/// here and the port Tor actually bound is read back later. Another process
+/// can take it between the pick and Tor's bind; Tor then fails to start, and
+/// the start is retried with a new port.
+fn start_service(
+    socks_port: u16,
+    data_dir: &str,
+    timeout_ms: f64,
+) -> Result<OwnedTorService, String> {
+    let attempts = if socks_port == 0 { SOCKS_PORT_ATTEMPTS } else { 1 };
+    let mut attempt = 1;
+
+    loop {
+        let port = match socks_port {
+            0 => free_port().map_err(|e| format!("No free SOCKS port: {}", e))?,
+            port => port,
+        };
+        let param = TorServiceParam {
+            socks_port: Some(port),
+            data_dir: data_dir.to_string(),
+            bootstrap_timeout_ms: Some(timeout_ms as u64),
+        };
+        debug!(
+            "Rust FFI: Initializing Tor service with parameters: {:?}",
+            param
+        );
+
+        match OwnedTorService::new(param) {
+            Ok(service) => return Ok(service),
+            // A port we can no longer bind ourselves was taken in between.
+            Err(e) if attempt < attempts && port_is_taken(port) => {
+                debug!(
+                    "Rust FFI: SOCKS port {} was taken before Tor bound it {:?}",
+                    port, e
+                );
+                attempt += 1;
+            }
+            Err(e) => return Err(format!("{:?}", e)),
+        }
+    }
+}
+
+fn free_port() -> std::io::Result<u16> {
+    let listener = TcpListener::bind(("127.0.0.1", 0))?;
+    Ok(listener.local_addr()?.port())
+}
+
+/// Whether something else listens on `port` now that Tor has given up.
+fn port_is_taken(port: u16) -> bool {
+    TcpListener::bind(("127.0.0.1", port)).is_err()
+}
+
+/// Reads the TCP SOCKS port Tor bound from `net/listeners/socks`.
+fn bound_socks_port(control_port: &str) -> Option<u16> {
+    let listeners =
+        control::with_controller(control_port.trim(), |c| c.get_info("net/listeners/socks")).ok()?;
+
+    listeners
+        .split_whitespace()
+        .map(|listener| listener.trim_matches('"'))
+        .filter(|listener| !listener.starts_with(socks::UNIX_PREFIX))
+        .find_map(|listener| listener.rsplit_once(':')?.1.parse().ok())
+}
+
+/// Adds a `SocksPort unix:<data_dir>/socks.sock` listener next to the TCP one.
+///
+/// Requests then skip the loopback TCP stack. Returns the proxy address to
+/// use, or `None` to stay on TCP when the platform, the path or Tor does not
+/// allow a Unix socket.
+#[cfg(unix)]
+fn enable_unix_socks(control_port: &str, socks_port: u16, data_dir: &str) -> Option<String> {
+    let path = Path::new(data_dir).join(SOCKS_SOCKET_FILE);
+    let path = path.to_str()?.to_string();
+    if path.len() > MAX_SOCKET_PATH || path.contains(char::is_whitespace) || path.contains('"') {
+        debug!("Rust FFI: Unusable SOCKS socket path {}, staying on TCP", path);
+        return None;
+    }
+
+    // A socket left by a previous run would make the bind fail.
+    let _ = std::fs::remove_file(&path);
+
+    // SETCONF replaces the whole SocksPort list, so the TCP port is repeated;
+    // Tor keeps its existing listener for it.
+    let result = control::with_controller(control_port.trim(), |c| {
+        c.command(&format!(
+            "SETCONF SocksPort={} SocksPort=\"{}{}\"",
+            socks_port,
+            socks::UNIX_PREFIX,
+            path
+        ))?;
+        c.get_info("net/listeners/socks")
+    });
+
+    match result {
+        Ok(listeners) if listeners.contains(&path) => {
+            debug!("Rust FFI: SOCKS listening on {}", path);
+            Some(format!("{}{}", socks::UNIX_PREFIX, path))
+        }
+        Ok(listeners) => {
+            debug!("Rust FFI: SOCKS socket not listed in {}, staying on TCP", listeners);
+            None
+        }
+        Err(e) => {
+            debug!("Rust FFI: Failed to add SOCKS socket {:?}, staying on TCP", e);
+            None
         }
     }
 }
 
-pub fn create_hidden_service(port: f64, target_port: f64) -> HiddenServiceResponse {
+#[cfg(not(unix))]
+fn enable_unix_socks(_control_port: &str, _socks_port: u16, _data_dir: &str) -> Option<String> {
+    None
+}
+
+/// Address requests should use to reach the SOCKS proxy of `service`.
+fn socks_proxy(instance: &Instance, service: &OwnedTorService) -> String {
+    match &*instance.socks.lock().unwrap() {
+        Some(SocksListeners { unix: Some(unix), .. }) => unix.clone(),
+        Some(listeners) => format!("127.0.0.1:{}", listeners.port),
+        None => format!("127.0.0.1:{}", service.socks_port),
+    }
+}
+
+/// TCP port of the SOCKS listener, 0 when not running.
+pub fn current_socks_port() -> u16 {
+    instance()
+        .and_then(|instance| instance.socks.lock().unwrap().as_ref().map(|l| l.port))
+        .unwrap_or(0)
+}
+
+pub fn get_listeners() -> TorListeners {
+    let control = control_port().unwrap_or_default();
+    let listeners = instance().and_then(|instance| instance.socks.lock().unwrap().clone());
+
+    TorListeners {
+        socks_port: listeners.as_ref().map(|l| l.port).unwrap_or(0) as f64,
+        socks_socket: listeners
+            .and_then(|l| l.unix)
+            .and_then(|unix| unix.strip_prefix(socks::UNIX_PREFIX).map(str::to_string))
+            .unwrap_or_default(),
+        control,
+    }
+}
+
+fn elapsed_ms(started: Instant) -> f64 {
+    started.elapsed().as_secs_f64() * 1000.0
+}
+
+/// A further virtual port of an onion service, from `ports_json`.
+#[derive(Deserialize)]
+struct PortMapping {
+    port: u16,
+    target_port: u16,
+}
+
+pub fn create_hidden_service(
+    port: f64,
+    target_port: f64,
+    ports_json: String,
+    accept_streams: bool,
+    defenses_json: String,
+) -> HiddenServiceResponse {
+    let mut mappings = vec![(port as u16, target_port as u16)];
+    if !ports_json.is_empty() {
+        match serde_json::from_str::<Vec<PortMapping>>(&ports_json) {
+            Ok(ports) => mappings.extend(ports.iter().map(|p| (p.port, p.target_port))),
+            Err(e) => return hidden_service_failed(format!("Invalid ports JSON: {}", e)),
+        }
+    }
+
+    let defenses = if defenses_json.is_empty() {
+        None
+    } else {
+        match serde_json::from_str::<onion::Defenses>(&defenses_json) {
+            Ok(defenses) => Some(defenses),
+            Err(e) => return hidden_service_failed(format!("Invalid defenses JSON: {}", e)),
+        }
+    };
+
+    // The SDK takes a single port.
+    if mappings.len() > 1 || accept_streams || defenses.is_some() {
+        let spec = onion::Spec {
+            key: None,
+            ports: Vec::new(),
+            defenses: defenses.unwrap_or_default(),
+        };
+        return create_onion_service(spec, &mappings, accept_streams);
+    }
     internal_create_hidden_service(port, target_port, None)
 }
 
+fn hidden_service_failed(error: String) -> HiddenServiceResponse {
+    debug!("Rust FFI: No service created {}", error);
+    HiddenServiceResponse {
+        is_success: false,
+        onion_address: "".to_string(),
+        control: "".to_string(),
+        error,
+    }
+}
+
+/// Creates an onion service through the control port, for options the SDK's
+/// `TorHiddenServiceParam` cannot carry.
+///
+/// Every `(port, target_port)` in `mappings` is served by the same service,
+/// so they share one descriptor and one set of introduction points. With
+/// `accept_streams`, inbound streams arrive on sockets owned by this library,
+/// one per virtual port, and reach JS as stream handles through the event
+/// poll instead of going to `target_port`. The targets in
+/// `spec.ports` are filled in here.
+fn create_onion_service(
+    mut spec: onion::Spec,
+    mappings: &[(u16, u16)],
+    accept_streams: bool,
+) -> HiddenServiceResponse {
+    let (Some(instance), Some(control_port)) = (instance(), control_port()) else {
+        return hidden_service_failed("Tor service not running".to_string());
+    };
+
+    // A Unix socket target skips the loopback TCP stack; Tor versions that
+    // refuse one in ADD_ONION get loopback ports instead.
+    let attempts: &[bool] = if accept_streams { &[true, false] } else { &[false] };
+    let mut error = String::new();
+    'attempts: for &unix in attempts {
+        let mut listening: Vec<String> = Vec::new();
+        spec.ports.clear();
+        for &(port, target_port) in mappings {
+            if !accept_streams {
+                spec.ports.push((port, format!("127.0.0.1:{}", target_port)));
+                continue;
+            }
+
+            let listen = if unix {
+                onion_socket_path(&instance.data_dir)
+                    .map(|path| format!("{}{}", socks::UNIX_PREFIX, path))
+                    .ok_or_else(|| std::io::Error::other("No usable socket path"))
+            } else {
+                Ok("127.0.0.1:0".to_string())
+            };
+            match listen.and_then(|listen| inbound::start(port, &listen)) {
+                Ok(target) => {
+                    listening.push(target.clone());
+                    spec.ports.push((port, target));
+                }
+                Err(e) => {
+                    debug!("Rust FFI: Cannot listen for port {} {:?}", port, e);
+                    error = e.to_string();
+                    for target in &listening {
+                        inbound::stop(target);
+                    }
+                    continue 'attempts;
+                }
+            }
+        }
+
+        match onion::add(&control_port, &instance.data_dir, &spec) {
+            Ok(onion_address) => {
+                for target in &listening {
+                    inbound::set_onion(target, &onion_address);
+                }
+                return HiddenServiceResponse {
+                    is_success: true,
+                    onion_address,
+                    control: control_port,
+                    error: String::new(),
+                };
+            }
+            Err(e) => {
+                debug!("Rust FFI: Adding onion service failed {:?}", e);
+                error = e.to_string();
+                for target in &listening {
+                    inbound::stop(target);
+                }
+            }
+        }
+    }
+    hidden_service_failed(error)
+}
+
+/// Path for a new onion target socket in `data_dir`, `None` when it would not
+/// fit in `sun_path` or could not be quoted in a Port= argument.
+#[cfg(unix)]
+fn onion_socket_path(data_dir: &str) -> Option<String> {
+    let id = NEXT_ONION_SOCKET.fetch_add(1, Ordering::Relaxed);
+    let path = Path::new(data_dir).join(format!("onion-{}.sock", id));
+    let path = path.to_str()?.to_string();
+    if path.len() > MAX_SOCKET_PATH || path.contains([' ', '\t', '"', ',']) {
+        return None;
+    }
+    Some(path)
+}
+
+#[cfg(not(unix))]
+fn onion_socket_path(_data_dir: &str) -> Option<String> {
+    None
+}
+
 fn internal_create_hidden_service(
     port: f64,
     target_port: f64,
     key_data: Option<[u8; 64]>,
 ) -> HiddenServiceResponse {
-    let mut service_guard = ensure_tor_service().lock().unwrap();
+    let Some(instance) = instance() else {
+        return hidden_service_failed("Tor service not running".to_string());
+    };
+    let mut service_guard = instance.service.lock().unwrap();
 
     debug!(
         "Rust FFI: Creating hidden service with parameters: port={}, target_port={}",
@@ -108,24 +565,16 @@ fn internal_create_hidden_service(
                     is_success: true,
                     onion_address: result.onion_url.to_string(),
                     control: service.control_port.trim().into(),
+                    error: String::new(),
                 }
             }
             Err(e) => {
                 debug!("Rust FFI: Error creating hidden service {:?}", e);
-                HiddenServiceResponse {
-                    is_success: false,
-                    onion_address: "".to_string(),
-                    control: "".to_string(),
-                }
+                hidden_service_failed(format!("{:?}", e))
             }
         }
     } else {
-        debug!("Rust FFI: No service created");
-        HiddenServiceResponse {
-            is_success: false,
-            onion_address: "".to_string(),
-            control: "".to_string(),
-        }
+        hidden_service_failed("Tor service not running".to_string())
     }
 }
 
@@ -163,17 +612,31 @@ pub fn start_tor_if_not_running(
     target_port: f64,
     timeout_ms: f64,
     keys_json: String,
+    options: ServiceOptions,
 ) -> StartTorResponse {
     if !initialize_tor_library() {
         return StartTorResponse {
             is_success: false,
             onion_address: String::new(),
             control: String::new(),
+            socks_port: 0.0,
             error_message: "Failed to initialize Tor library".to_string(),
             onion_addresses_json: String::new(),
         };
     }
 
+    // Only one data directory can run per process, see [`instance_for_data_dir`].
+    if let Some(running) = instance().filter(|instance| instance.data_dir != data_dir) {
+        return StartTorResponse {
+            is_success: false,
+            onion_address: String::new(),
+            control: String::new(),
+            socks_port: 0.0,
+            error_message: already_running(&running.data_dir),
+            onion_addresses_json: String::new(),
+        };
+    }
+
     let status = get_service_status();
 
     if status == 2.0 {
@@ -182,12 +645,18 @@ pub fn start_tor_if_not_running(
             status
         );
 
-        if !init_tor_service(socks_port, data_dir, timeout_ms) {
+        if !init_tor_service(socks_port, data_dir, timeout_ms, options) {
+            let error = startup::error();
             return StartTorResponse {
                 is_success: false,
                 onion_address: String::new(),
                 control: String::new(),
-                error_message: "Failed to initialize Tor service".to_string(),
+                socks_port: 0.0,
+                error_message: if error.is_empty() {
+                    "Failed to initialize Tor service".to_string()
+                } else {
+                    error
+                },
                 onion_addresses_json: String::new(),
             };
         }
@@ -198,6 +667,14 @@ pub fn start_tor_if_not_running(
         );
     }
 
+    // Hidden services use the SOCKS port as their virtual port; with port 0
+    // that is the one Tor picked.
+    let socks_port = if socks_port == 0.0 {
+        current_socks_port() as f64
+    } else {
+        socks_port
+    };
+
     let mut onion_addresses: Vec<String> = Vec::new();
     let mut control_port: String = String::new();
 
@@ -263,6 +740,7 @@ pub fn start_tor_if_not_running(
             is_success,
             onion_address,
             control,
+            socks_port,
             error_message: if is_success {
                 String::new()
             } else {
@@ -279,13 +757,17 @@ pub fn start_tor_if_not_running(
         is_success: true,
         onion_address,
         control: control_port,
+        socks_port,
         error_message: String::new(),
         onion_addresses_json,
     }
 }
 
 pub fn get_service_status() -> f64 {
-    let service_guard = ensure_tor_service().lock().unwrap();
+    let Some(instance) = instance() else {
+        return 2.0;
+    };
+    let service_guard = instance.service.lock().unwrap();
 
     match &*service_guard {
         Some(service) => match service.get_status() {
@@ -297,10 +779,126 @@ pub fn get_service_status() -> f64 {
     }
 }
 
+pub fn control_port() -> Option<String> {
+    let instance = instance()?;
+    let service_guard = instance.service.lock().unwrap();
+    service_guard.as_ref().map(|service| service.control_port.trim().to_string())
+}
+
+/// Current bootstrap phase, or `None` when no service is running.
+///
+/// Reads `status/bootstrap-phase` from the control port, which carries Tor's
+/// own tag and progress; falls back to the SDK's coarser status.
+pub fn bootstrap_phase() -> Option<startup::Phase> {
+    let control_port = control_port()?;
+
+    let line = control::with_controller(&control_port, |c| c.get_info("status/bootstrap-phase"));
+    if let Ok(line) = line {
+        let field = |key: &str| {
+            line.split_whitespace()
+                .find_map(|f| f.strip_prefix(key))
+                .map(|v| v.to_string())
+        };
+        if let Some(tag) = field("TAG=") {
+            return Some(startup::Phase {
+                tag,
+                progress: field("PROGRESS=").and_then(|p| p.parse().ok()).unwrap_or(0),
+                summary: control::quoted_value(&line, "SUMMARY=").unwrap_or_default(),
+            });
+        }
+    }
+
+    let instance = instance()?;
+    let service_guard = instance.service.lock().unwrap();
+    let service = service_guard.as_ref()?;
+    Some(match service.get_status() {
+        Ok(OwnedTorServiceBootstrapPhase::Done) => startup::Phase {
+            tag: "done".to_string(),
+            progress: 100,
+            summary: String::new(),
+        },
+        Ok(phase) => startup::Phase {
+            tag: format!("{:?}", phase).to_ascii_lowercase(),
+            progress: 0,
+            summary: String::new(),
+        },
+        Err(e) => startup::Phase {
+            tag: "error".to_string(),
+            progress: 0,
+            summary: format!("{:?}", e),
+        },
+    })
+}
+
+/// SOCKS proxy address of the service, once it has finished bootstrapping.
+pub fn bootstrapped_socks_proxy() -> Option<String> {
+    let instance = instance()?;
+    let service_guard = instance.service.lock().unwrap();
+
+    match &*service_guard {
+        Some(service) => match service.get_status() {
+            Ok(OwnedTorServiceBootstrapPhase::Done) => Some(socks_proxy(&instance, service)),
+            _ => None,
+        },
+        None => None,
+    }
+}
+
+/// Puts the running service into dormant mode until [`resume_service`] or
+/// the next request.
+pub fn suspend_service() -> bool {
+    let Some(control_port) = control_port() else {
+        return false;
+    };
+
+    match dormant::suspend(&control_port) {
+        Ok(()) => true,
+        Err(e) => {
+            debug!("Rust FFI: Failed to suspend Tor {:?}", e);
+            false
+        }
+    }
+}
+
+pub fn resume_service(timeout_ms: f64) -> ResumeResponse {
+    let result = match control_port() {
+        Some(control_port) => {
+            dormant::resume(&control_port, Duration::from_millis(timeout_ms as u64))
+                .map_err(|e| e.to_string())
+        }
+        None => Err("Tor service not running".to_string()),
+    };
+
+    match result {
+        Ok(elapsed) => ResumeResponse {
+            is_success: true,
+            error: String::new(),
+            resume_ms: elapsed.as_secs_f64() * 1000.0,
+        },
+        Err(error) => {
+            debug!("Rust FFI: Failed to resume Tor {}", error);
+            ResumeResponse {
+                is_success: false,
+                error,
+                resume_ms: 0.0,
+            }
+        }
+    }
+}
+
 pub fn delete_hidden_service(address: String) -> bool {
-    let mut service_guard = ensure_tor_service().lock().unwrap();
+    let Some(instance) = instance() else {
+        return false;
+    };
+    let mut service_guard = instance.service.lock().unwrap();
 
     if let Some(service) = service_guard.as_mut() {
+        let control_port = service.control_port.trim().to_string();
+        publish::forget(&address);
+        if onion::is_owned(&control_port, &address) {
+            inbound::stop_onion(&address);
+            return onion::delete(&control_port, &address).is_ok();
+        }
         service.delete_hidden_service(address).is_ok()
     } else {
         false
@@ -308,124 +906,715 @@ pub fn delete_hidden_service(address: String) -> bool {
 }
 
 pub fn shutdown_service() -> bool {
-    let mut service_guard = ensure_tor_service().lock().unwrap();
+    let Some(instance) = instance() else {
+        return false;
+    };
+    let mut service_guard = instance.service.lock().unwrap();
 
     if let Some(mut service) = service_guard.take() {
-        service.shutdown().is_ok()
+        let control_port = service.control_port.trim().to_string();
+        hsdesc::save(&control_port, &instance.data_dir);
+        control::disconnect();
+        dormant::note_activity();
+        onion::forget_instance(&control_port);
+        metrics::forget(&control_port);
+        publish::forget_instance(&control_port);
+        inbound::stop_all();
+        proxy::stop_all();
+        streams::close_all();
+        websocket::close_all();
+        isolation::reset();
+        *instance.socks.lock().unwrap() = None;
+        let stopped = service.shutdown().is_ok();
+        // Only now may another data directory start.
+        remove_instance();
+        stopped
     } else {
+        remove_instance();
         false
     }
 }
 
+struct FetchedResponse {
+    /// The response, its body moved to `body`.
+    response: http::Response,
+    /// The body as text, decoded once for every caller sharing the response.
+    body: String,
+    decoded_bytes: usize,
+    cache_status: String,
+    /// Whether the response came over a Conflux (multipath) circuit set.
+    conflux: bool,
+}
+
+type FetchResult = Result<Arc<FetchedResponse>, String>;
+
+#[derive(Clone, PartialEq, Eq, Hash)]
+struct FlightKey {
+    url: String,
+    headers: Vec<(String, String)>,
+    accept_encoding: String,
+    socks_auth: Option<socks::Auth>,
+    cached: bool,
+    hedge_percentile: Option<u64>,
+}
+
+fn ensure_get_flights() -> &'static Group<FlightKey, FetchResult> {
+    GET_FLIGHTS.get_or_init(Group::new)
+}
+
+fn sorted_headers(headers: &[(String, String)]) -> Vec<(String, String)> {
+    let mut headers: Vec<(String, String)> = headers
+        .iter()
+        .map(|(key, value)| (key.to_ascii_lowercase(), value.clone()))
+        .collect();
+    headers.sort();
+    headers
+}
+
+fn error_response(error: String) -> HttpResponse {
+    HttpResponse {
+        status_code: 0.0,
+        body: String::new(),
+        error,
+        wire_bytes: 0.0,
+        decoded_bytes: 0.0,
+        cache_status: String::new(),
+        conflux: false,
+    }
+}
+
+/// Per-request options beyond the basic HTTP parameters.
+#[derive(Default)]
+pub struct RequestOptions {
+    pub accept_encoding: String,
+    /// Root of the on-disk cache; `None` bypasses it.
+    pub cache_root: Option<PathBuf>,
+    /// Hedge after this TTFB percentile; `None` disables hedging.
+    pub hedge_percentile: Option<f64>,
+    /// Requests with the same key share circuits, empty uses Tor's default.
+    pub isolation: String,
+    /// Use a circuit no other request shares.
+    pub fresh_circuit: bool,
+}
+
 fn make_tor_http_request(
     url: String,
-    method: HttpMethod,
+    method: Method,
     headers_json: String,
     body: String,
     timeout_ms: u64,
+    options: RequestOptions,
 ) -> HttpResponse {
     if INITIALIZED.get().is_none() {
-        return HttpResponse {
-            status_code: 0.0,
-            body: String::new(),
-            error: "Tor library not initialized".to_string(),
-        };
+        return error_response("Tor library not initialized".to_string());
     }
 
     debug!(
-        "http request params: {:?} {:?} {:?} {}",
-        url, headers_json, body, timeout_ms
+        "http request params: {:?} {:?} {:?} {} isolation={:?} fresh={}",
+        url, headers_json, body, timeout_ms, options.isolation, options.fresh_circuit
     );
 
     // Parse headers JSON if provided
-    let headers: Option<HashMap<String, String>> = if !headers_json.is_empty() {
-        match serde_json::from_str(&headers_json) {
-            Ok(h) => Some(h),
+    let headers: Vec<(String, String)> = if !headers_json.is_empty() {
+        match serde_json::from_str::<HashMap<String, String>>(&headers_json) {
+            Ok(h) => h.into_iter().collect(),
             Err(_) => {
-                return HttpResponse {
-                    status_code: 0.0,
-                    body: String::new(),
-                    error: "Invalid headers JSON".to_string(),
-                };
+                return error_response("Invalid headers JSON".to_string());
             }
         }
     } else {
-        None
+        Vec::new()
     };
 
     // Create request params
-    let params = HttpRequestParams {
+    let request = http::Request {
         url,
         method,
         headers,
-        body: if body.is_empty() { None } else { Some(body) },
-        timeout_ms: Some(timeout_ms),
+        body: if body.is_empty() { None } else { Some(body.into_bytes()) },
+        timeout: Duration::from_millis(timeout_ms),
+        accept_encoding: options.accept_encoding,
+        socks_auth: isolation::socks_auth(&options.isolation, options.fresh_circuit),
     };
 
     // Get socks proxy address from the running Tor service
-    let service_guard = ensure_tor_service().lock().unwrap();
-    let socks_port = match &*service_guard {
-        Some(service) => service.socks_port,
-        None => {
-            return HttpResponse {
-                status_code: 0.0,
-                body: String::new(),
-                error: "Tor service not running".to_string(),
-            };
+    let Some(instance) = instance() else {
+        return error_response("Tor service not running".to_string());
+    };
+    let socks_proxy = {
+        let service_guard = instance.service.lock().unwrap();
+        match &*service_guard {
+            Some(service) => socks_proxy(&instance, service),
+            None => {
+                return error_response("Tor service not running".to_string());
+            }
         }
     };
+    let data_dir = &instance.data_dir;
 
-    debug!("socks port: {}", socks_port);
+    debug!("socks proxy: {}", socks_proxy);
+    // Opening a stream wakes a dormant Tor.
+    dormant::note_activity();
 
     // Make the HTTP request
-    let socks_proxy = format!("127.0.0.1:{}", socks_port);
-    match make_http_request(params, socks_proxy) {
-        Ok(response) => {
-            debug!("http response: {:?}", response);
-            return HttpResponse {
+    let cache_root = options.cache_root;
+    let hedge_percentile = options.hedge_percentile;
+    let perform = || -> FetchResult {
+        let result = match &cache_root {
+            Some(root) => {
+                // Isolation keys are separate identities and get separate caches.
+                let identity = format!("{}\0{}", data_dir, options.isolation);
+                let dir = cache::identity_dir(root, &identity);
+                cache::fetch_cached(&dir, &request, |request| {
+                    hedge::fetch(request, &socks_proxy, hedge_percentile)
+                })
+                .map(|(response, status)| (response, status.as_str().to_string()))
+            }
+            None => hedge::fetch(&request, &socks_proxy, hedge_percentile)
+                .map(|response| (response, String::new())),
+        };
+        let mut conflux = false;
+        if let Ok((_, cache_status)) = &result {
+            let url = url::Url::parse(&request.url).ok();
+            let host = url
+                .as_ref()
+                .and_then(|u| u.host_str().map(str::to_string))
+                .unwrap_or_default();
+            hsdesc::remember(&host);
+
+            // Onion services never use Conflux.
+            if cache_status != cache::CacheStatus::Hit.as_str() && !host.ends_with(".onion") {
+                let port = url.and_then(|u| u.port_or_known_default()).unwrap_or(0);
+                conflux = isolation::used_conflux(
+                    &format!("{}:{}", host, port),
+                    request.socks_auth.as_ref(),
+                );
+            }
+        }
+        result
+            .map(|(mut response, cache_status)| {
+                let body = mem::take(&mut response.body);
+                let decoded_bytes = body.len();
+                let body = String::from_utf8(body)
+                    .unwrap_or_else(|e| String::from_utf8_lossy(e.as_bytes()).into_owned());
+                Arc::new(FetchedResponse {
+                    response,
+                    body,
+                    decoded_bytes,
+                    cache_status,
+                    conflux,
+                })
+            })
+            .map_err(|e| format!("{:?}", e))
+    };
+
+    // Identical GETs issued while one is in flight share its response.
+    let (result, shared) = if method == Method::GET {
+        let key = FlightKey {
+            url: request.url.clone(),
+            headers: sorted_headers(&request.headers),
+            accept_encoding: request.accept_encoding.clone(),
+            socks_auth: request.socks_auth.clone(),
+            cached: cache_root.is_some(),
+            hedge_percentile: hedge_percentile.map(f64::to_bits),
+        };
+        ensure_get_flights().run(key, perform)
+    } else {
+        (perform(), false)
+    };
+
+    match result {
+        Ok(fetched) => {
+            let response = &fetched.response;
+            debug!(
+                "http response: status={} wire_bytes={} decoded_bytes={} content_encoding={:?} cache={:?} shared={} conflux={}",
+                response.status_code,
+                response.wire_bytes,
+                fetched.decoded_bytes,
+                response.header("content-encoding"),
+                fetched.cache_status,
+                shared,
+                fetched.conflux
+            );
+            HttpResponse {
                 status_code: response.status_code as f64,
-                body: response.body,
-                error: match response.error {
-                    Some(err) => err,
-                    None => String::new(),
+                wire_bytes: response.wire_bytes as f64,
+                decoded_bytes: fetched.decoded_bytes as f64,
+                error: String::new(),
+                cache_status: fetched.cache_status.clone(),
+                conflux: fetched.conflux,
+                // Every caller hands JS its own string. The last one holding a
+                // shared response takes the body, the others copy it.
+                body: match Arc::try_unwrap(fetched) {
+                    Ok(fetched) => fetched.body,
+                    Err(fetched) => fetched.body.clone(),
                 },
-            };
+            }
         }
         Err(e) => {
-            debug!("http error: {:?}", e);
-            return HttpResponse {
-                status_code: 0.0,
-                body: String::new(),
-                error: format!("Error making HTTP request: {:?}", e),
-            };
+            debug!("http error: {}", e);
+            error_response(format!("Error making HTTP request: {}", e))
         }
     }
 }
 
-pub fn http_get(url: String, headers_json: String, timeout_ms: f64) -> HttpResponse {
+pub fn http_get(url: String, headers_json: String, timeout_ms: f64, options: RequestOptions) -> HttpResponse {
     make_tor_http_request(
         url,
-        HttpMethod::GET,
+        Method::GET,
         headers_json,
         String::new(), // No body for GET
         timeout_ms as u64,
+        options,
     )
 }
 
-pub fn http_post(url: String, body: String, headers_json: String, timeout_ms: f64) -> HttpResponse {
-    make_tor_http_request(url, HttpMethod::POST, headers_json, body, timeout_ms as u64)
+pub fn http_post(
+    url: String,
+    body: String,
+    headers_json: String,
+    timeout_ms: f64,
+    options: RequestOptions,
+) -> HttpResponse {
+    make_tor_http_request(url, Method::POST, headers_json, body, timeout_ms as u64, options)
 }
 
-pub fn http_put(url: String, body: String, headers_json: String, timeout_ms: f64) -> HttpResponse {
-    make_tor_http_request(url, HttpMethod::PUT, headers_json, body, timeout_ms as u64)
+pub fn http_put(
+    url: String,
+    body: String,
+    headers_json: String,
+    timeout_ms: f64,
+    options: RequestOptions,
+) -> HttpResponse {
+    make_tor_http_request(url, Method::PUT, headers_json, body, timeout_ms as u64, options)
 }
 
-pub fn http_delete(url: String, headers_json: String, timeout_ms: f64) -> HttpResponse {
+pub fn http_delete(url: String, headers_json: String, timeout_ms: f64, options: RequestOptions) -> HttpResponse {
     make_tor_http_request(
         url,
-        HttpMethod::DELETE,
+        Method::DELETE,
         headers_json,
         String::new(), // Usually no body for DELETE
         timeout_ms as u64,
+        options,
     )
 }
+
+fn stream_response(stream_id: f64, result: Result<(), String>) -> StreamResponse {
+    match result {
+        Ok(()) => StreamResponse {
+            is_success: true,
+            error: String::new(),
+            stream_id,
+        },
+        Err(error) => {
+            debug!("Rust FFI: Stream {} failed {}", stream_id, error);
+            StreamResponse {
+                is_success: false,
+                error,
+                stream_id,
+            }
+        }
+    }
+}
+
+/// Opens a raw TCP stream to `host:port` through Tor.
+pub fn open_stream(host: String, port: f64, timeout_ms: f64, isolation: String) -> StreamResponse {
+    let Some(instance) = instance() else {
+        return stream_response(0.0, Err("Tor service not running".to_string()));
+    };
+    let proxy = {
+        let service_guard = instance.service.lock().unwrap();
+        match &*service_guard {
+            Some(service) => socks_proxy(&instance, service),
+            None => {
+                return stream_response(0.0, Err("Tor service not running".to_string()));
+            }
+        }
+    };
+    // Opening a stream wakes a dormant Tor.
+    dormant::note_activity();
+
+    let auth = isolation::socks_auth(&isolation, false);
+    let timeout = Duration::from_millis(timeout_ms as u64);
+    let opened = socks::connect(&proxy, &host, port as u16, timeout, auth.as_ref())
+        .and_then(streams::open);
+
+    match opened {
+        Ok(id) => stream_response(id as f64, Ok(())),
+        Err(e) => stream_response(0.0, Err(e.to_string())),
+    }
+}
+
+pub fn stream_write(stream_id: f64, data_base64: &str) -> StreamResponse {
+    let result = STANDARD
+        .decode(data_base64)
+        .map_err(|e| format!("Invalid base64 data: {}", e))
+        .and_then(|data| streams::write(stream_id as u64, &data).map_err(|e| e.to_string()));
+    stream_response(stream_id, result)
+}
+
+pub fn stream_read(stream_id: f64, max_bytes: f64) -> StreamReadResponse {
+    match streams::read(stream_id as u64, max_bytes as usize) {
+        Ok(chunk) => StreamReadResponse {
+            data_base64: STANDARD.encode(&chunk.data),
+            eof: chunk.eof,
+            error: String::new(),
+        },
+        Err(e) => StreamReadResponse {
+            data_base64: String::new(),
+            eof: true,
+            error: e.to_string(),
+        },
+    }
+}
+
+/// Waits up to `wait_ms` for anything native code has for JS, see
+/// [`events::poll_json`].
+pub fn poll_events(wait_ms: f64) -> String {
+    events::poll_json(Duration::from_millis(wait_ms as u64))
+}
+
+pub fn stream_shutdown_write(stream_id: f64) -> StreamResponse {
+    let result = streams::shutdown_write(stream_id as u64).map_err(|e| e.to_string());
+    stream_response(stream_id, result)
+}
+
+pub fn stream_close(stream_id: f64) -> bool {
+    streams::close(stream_id as u64)
+}
+
+fn websocket_error(error: String) -> WebSocketResponse {
+    debug!("Rust FFI: WebSocket failed {}", error);
+    WebSocketResponse {
+        is_success: false,
+        error,
+        socket_id: 0.0,
+        protocol: String::new(),
+        extensions: String::new(),
+    }
+}
+
+pub fn websocket_connect(
+    url: String,
+    headers_json: String,
+    protocols: String,
+    timeout_ms: f64,
+    ping_interval_ms: f64,
+    deflate: bool,
+    isolation: String,
+) -> WebSocketResponse {
+    let headers: Vec<(String, String)> = if !headers_json.is_empty() {
+        match serde_json::from_str::<HashMap<String, String>>(&headers_json) {
+            Ok(h) => h.into_iter().collect(),
+            Err(_) => return websocket_error("Invalid headers JSON".to_string()),
+        }
+    } else {
+        Vec::new()
+    };
+
+    let Some(instance) = instance() else {
+        return websocket_error("Tor service not running".to_string());
+    };
+    let proxy = {
+        let service_guard = instance.service.lock().unwrap();
+        match &*service_guard {
+            Some(service) => socks_proxy(&instance, service),
+            None => return websocket_error("Tor service not running".to_string()),
+        }
+    };
+    // Opening a stream wakes a dormant Tor.
+    dormant::note_activity();
+
+    let options = websocket::Options {
+        headers,
+        protocols: protocols
+            .split(',')
+            .map(str::trim)
+            .filter(|p| !p.is_empty())
+            .map(str::to_string)
+            .collect(),
+        deflate,
+        ping_interval: Some(Duration::from_millis(ping_interval_ms as u64))
+            .filter(|interval| !interval.is_zero()),
+        timeout: Duration::from_millis(timeout_ms as u64),
+        auth: isolation::socks_auth(&isolation, false),
+    };
+
+    match websocket::connect(&url, &proxy, options) {
+        Ok(handshake) => WebSocketResponse {
+            is_success: true,
+            error: String::new(),
+            socket_id: handshake.socket_id as f64,
+            protocol: handshake.protocol,
+            extensions: handshake.extensions,
+        },
+        Err(e) => websocket_error(e.to_string()),
+    }
+}
+
+pub fn websocket_send(socket_id: f64, data: &str, binary: bool) -> bool {
+    let result = if binary {
+        STANDARD
+            .decode(data)
+            .map_err(|e| format!("Invalid base64 data: {}", e))
+            .and_then(|data| {
+                websocket::send(socket_id as u64, &data, true).map_err(|e| e.to_string())
+            })
+    } else {
+        websocket::send(socket_id as u64, data.as_bytes(), false).map_err(|e| e.to_string())
+    };
+
+    match result {
+        Ok(()) => true,
+        Err(e) => {
+            debug!("Rust FFI: WebSocket {} send failed {}", socket_id, e);
+            false
+        }
+    }
+}
+
+pub fn websocket_attach(socket_id: f64) -> bool {
+    websocket::attach(socket_id as u64);
+    true
+}
+
+pub fn websocket_close(socket_id: f64, code: f64, reason: &str) -> bool {
+    match websocket::close(socket_id as u64, code as u16, reason) {
+        Ok(()) => true,
+        Err(e) => {
+            debug!("Rust FFI: WebSocket {} close failed {:?}", socket_id, e);
+            false
+        }
+    }
+}
+
+pub fn start_proxy(listen: String, isolation: String) -> ProxyResponse {
+    let result = match instance() {
+        Some(_) => proxy::start(&listen, &isolation).map_err(|e| e.to_string()),
+        None => Err("Tor service not running".to_string()),
+    };
+
+    match result {
+        Ok((address, credentials)) => ProxyResponse {
+            is_success: true,
+            error: String::new(),
+            address,
+            credentials,
+        },
+        Err(error) => {
+            debug!("Rust FFI: Failed to start proxy {}", error);
+            ProxyResponse {
+                is_success: false,
+                error,
+                address: String::new(),
+                credentials: String::new(),
+            }
+        }
+    }
+}
+
+pub fn stop_proxy(address: &str) -> bool {
+    proxy::stop(address)
+}
+
+pub fn start_http_server(
+    listen: String,
+    data_path: &Path,
+    static_dir: String,
+    routes_json: String,
+    dispatch: bool,
+    handler_timeout_ms: u64,
+) -> HttpServerResponse {
+    // Directories are relative to the app's data directory unless absolute.
+    let mut routes = Vec::new();
+    if !static_dir.is_empty() {
+        routes.push(files::Route::new("/", data_path.join(&static_dir)));
+    }
+    if !routes_json.is_empty() {
+        match serde_json::from_str::<HashMap<String, String>>(&routes_json) {
+            Ok(table) => {
+                for (prefix, dir) in table {
+                    routes.push(files::Route::new(&prefix, data_path.join(dir)));
+                }
+            }
+            Err(e) => {
+                return HttpServerResponse {
+                    is_success: false,
+                    error: format!("Invalid routes JSON: {}", e),
+                    server_id: 0.0,
+                    address: String::new(),
+                };
+            }
+        }
+    }
+
+    let options = server::Options {
+        routes,
+        dispatch,
+        handler_timeout: Duration::from_millis(handler_timeout_ms),
+    };
+
+    match server::start(&listen, options) {
+        Ok((server_id, address)) => HttpServerResponse {
+            is_success: true,
+            error: String::new(),
+            server_id: server_id as f64,
+            address,
+        },
+        Err(e) => {
+            debug!("Rust FFI: Failed to start HTTP server {:?}", e);
+            HttpServerResponse {
+                is_success: false,
+                error: e.to_string(),
+                server_id: 0.0,
+                address: String::new(),
+            }
+        }
+    }
+}
+
+pub fn get_onion_service_metrics(onion_address: &str) -> String {
+    let Some(control_port) = control_port() else {
+        return "{}".to_string();
+    };
+    metrics::onion_json(&control_port, onion_address).unwrap_or_else(|e| {
+        debug!("Rust FFI: Failed to read onion service metrics {:?}", e);
+        "{}".to_string()
+    })
+}
+
+/// Waits until `min_hsdirs` HSDirs accepted a descriptor of `onion_address`.
+///
+/// `create_hidden_service` returns once Tor took the service, but clients
+/// can only reach it after its descriptor is on the HSDirs they ask.
+pub fn wait_onion_published(
+    onion_address: &str,
+    min_hsdirs: f64,
+    timeout_ms: f64,
+) -> OnionPublishResponse {
+    let Some(control_port) = control_port() else {
+        return OnionPublishResponse {
+            is_success: false,
+            hsdirs: 0.0,
+            error: "Tor service not running".to_string(),
+        };
+    };
+
+    let min_hsdirs = (min_hsdirs as usize).max(1);
+    let timeout = Duration::from_millis(timeout_ms as u64);
+    let hsdirs = publish::wait(&control_port, onion_address, min_hsdirs, timeout);
+    let error = if hsdirs >= min_hsdirs {
+        String::new()
+    } else {
+        format!(
+            "Timed out with {} of {} HSDirs accepting the descriptor",
+            hsdirs, min_hsdirs
+        )
+    };
+    OnionPublishResponse {
+        is_success: error.is_empty(),
+        hsdirs: hsdirs as f64,
+        error,
+    }
+}
+
+pub fn attach_http_server(server_id: f64) -> bool {
+    server::attach(server_id as u64)
+}
+
+pub fn stop_http_server(server_id: f64) -> bool {
+    server::stop(server_id as u64)
+}
+
+pub fn respond_http_requests(replies_json: &str) -> bool {
+    match server::respond_json(replies_json) {
+        Ok(_) => true,
+        Err(e) => {
+            debug!("Rust FFI: Invalid HTTP replies {:?}", e);
+            false
+        }
+    }
+}
+
+pub fn clear_http_cache(cache_root: PathBuf) -> bool {
+    match cache::clear(&cache_root) {
+        Ok(()) => true,
+        Err(e) => {
+            debug!("Rust FFI: Error clearing HTTP cache {:?}", e);
+            false
+        }
+    }
+}
+
+pub fn get_circuit_stats() -> String {
+    isolation::stats_json()
+}
+
+pub fn prewarm(targets_json: String, keepalive_ms: f64, isolation: String) -> bool {
+    let targets = match serde_json::from_str::<Vec<String>>(&targets_json) {
+        Ok(targets) => targets,
+        Err(e) => {
+            debug!("Rust FFI: Failed to parse prewarm targets {:?}", e);
+            return false;
+        }
+    };
+
+    let keepalive = if keepalive_ms > 0.0 {
+        Duration::from_millis(keepalive_ms as u64)
+    } else {
+        prewarm::DEFAULT_KEEPALIVE
+    };
+
+    match prewarm::start(targets, keepalive, isolation) {
+        Ok(()) => true,
+        Err(e) => {
+            debug!("Rust FFI: {}", e);
+            false
+        }
+    }
+}
+
+pub fn get_prewarm_status() -> String {
+    prewarm::status_json()
+}
+
+pub fn seed_directory_snapshot(snapshot_dir: String, data_dir: String) -> DirectorySnapshotResponse {
+    match snapshot::seed(Path::new(&snapshot_dir), Path::new(&data_dir)) {
+        Ok(valid_until) => {
+            startup::note_seeded(&data_dir);
+            DirectorySnapshotResponse {
+                is_success: true,
+                error: String::new(),
+                valid_until: valid_until as f64,
+            }
+        }
+        Err(e) => {
+            debug!("Rust FFI: Not seeding directory snapshot {:?}", e);
+            DirectorySnapshotResponse {
+                is_success: false,
+                error: e.to_string(),
+                valid_until: 0.0,
+            }
+        }
+    }
+}
+
+pub fn export_directory_snapshot(data_dir: String, snapshot_dir: String) -> DirectorySnapshotResponse {
+    match snapshot::export(Path::new(&data_dir), Path::new(&snapshot_dir)) {
+        Ok(valid_until) => DirectorySnapshotResponse {
+            is_success: true,
+            error: String::new(),
+            valid_until: valid_until as f64,
+        },
+        Err(e) => DirectorySnapshotResponse {
+            is_success: false,
+            error: e.to_string(),
+            valid_until: 0.0,
+        },
+    }
+}
+
+pub fn get_startup_report() -> String {
+    startup::report_json()
+}
@@ -0,0 +1,1094 @@
+use std::{
+    collections::{HashMap, HashSet},
+    io::{self, Read, Write},
+    mem,
+    net::Shutdown,
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        Arc, Condvar, Mutex,
+    },
+    thread,
+    time::Duration,
+};
+
+use base64::{engine::general_purpose::STANDARD, Engine};
+use flate2::{Compress, Compression, Decompress, FlushCompress, FlushDecompress};
+use logger::log::debug;
+use once_cell::sync::OnceCell;
+use ring::{
+    digest,
+    rand::{SecureRandom, SystemRandom},
+};
+use rustls::ClientConnection;
+use serde::Serialize;
+use url::{Host, Url};
+
+use crate::{events, http, socks};
+
+const ACCEPT_GUID: &str = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+/// Every sync-flushed deflate block ends with these bytes; RFC 7692 strips
+/// them from compressed messages.
+const DEFLATE_TAIL: [u8; 4] = [0x00, 0x00, 0xff, 0xff];
+const MAX_MESSAGE: usize = 16 * 1024 * 1024;
+/// Received bytes a socket may have waiting for JS before its reader stops
+/// reading, which makes Tor apply flow control on the circuit.
+const MAX_QUEUED: usize = 4 * 1024 * 1024;
+/// Messages shorter than this are sent uncompressed; deflate only adds
+/// overhead to them.
+const MIN_COMPRESS: usize = 64;
+/// How long to wait for the server to answer our close frame.
+const CLOSE_TIMEOUT: Duration = Duration::from_secs(5);
+const READ_CHUNK: usize = 16 * 1024;
+
+const OP_CONTINUATION: u8 = 0x0;
+const OP_TEXT: u8 = 0x1;
+const OP_BINARY: u8 = 0x2;
+const OP_CLOSE: u8 = 0x8;
+const OP_PING: u8 = 0x9;
+const OP_PONG: u8 = 0xA;
+
+const CLOSE_NO_STATUS: u16 = 1005;
+const CLOSE_ABNORMAL: u16 = 1006;
+
+static NEXT_ID: AtomicU64 = AtomicU64::new(1);
+static SOCKETS: OnceCell<Mutex<HashMap<u64, Arc<Entry>>>> = OnceCell::new();
+static EVENTS: OnceCell<Mutex<Vec<Event>>> = OnceCell::new();
+/// Sockets JS has registered, see [`attach`].
+static ATTACHED: OnceCell<Mutex<HashSet<u64>>> = OnceCell::new();
+
+pub struct Options {
+    pub headers: Vec<(String, String)>,
+    pub protocols: Vec<String>,
+    /// Offer permessage-deflate.
+    pub deflate: bool,
+    /// Send a ping after this much silence and fail the connection if the
+    /// next interval passes without any data either. `None` disables pings.
+    pub ping_interval: Option<Duration>,
+    pub timeout: Duration,
+    pub auth: Option<socks::Auth>,
+}
+
+pub struct Handshake {
+    pub socket_id: u64,
+    /// Subprotocol the server selected, empty if none.
+    pub protocol: String,
+    /// Extensions the server accepted, as sent in its response.
+    pub extensions: String,
+}
+
+/// Something that happened on a socket, delivered to JS by [`take`].
+#[derive(Serialize)]
+pub struct Event {
+    socket_id: u64,
+    #[serde(flatten)]
+    kind: EventKind,
+}
+
+#[derive(Serialize)]
+#[serde(tag = "type", rename_all = "lowercase")]
+enum EventKind {
+    Text {
+        data: String,
+    },
+    /// `data` is base64.
+    Binary {
+        data: String,
+    },
+    Error {
+        message: String,
+    },
+    /// Always the last event of a socket.
+    Close {
+        code: u16,
+        reason: String,
+    },
+}
+
+struct Entry {
+    transport: Transport,
+    /// Outgoing compression context, also held while a data frame is written
+    /// so frames leave in the order they were compressed.
+    deflater: Mutex<Option<Deflater>>,
+    state: Mutex<State>,
+    /// Signalled when [`take`] hands this socket's events to JS.
+    drained: Condvar,
+}
+
+#[derive(Default)]
+struct State {
+    close_sent: bool,
+    /// Bytes of this socket's events not yet taken by JS.
+    queued: usize,
+}
+
+fn sockets() -> &'static Mutex<HashMap<u64, Arc<Entry>>> {
+    SOCKETS.get_or_init(|| Mutex::new(HashMap::new()))
+}
+
+fn pending() -> &'static Mutex<Vec<Event>> {
+    EVENTS.get_or_init(|| Mutex::new(Vec::new()))
+}
+
+fn attached() -> &'static Mutex<HashSet<u64>> {
+    ATTACHED.get_or_init(|| Mutex::new(HashSet::new()))
+}
+
+fn entry(id: u64) -> io::Result<Arc<Entry>> {
+    sockets()
+        .lock()
+        .unwrap()
+        .get(&id)
+        .cloned()
+        .ok_or_else(|| io::Error::new(io::ErrorKind::NotConnected, "WebSocket is not open"))
+}
+
+/// Connects to a `ws://` or `wss://` URL through the SOCKS proxy at `proxy`
+/// and starts delivering its messages through [`events`].
+pub fn connect(url: &str, proxy: &str, options: Options) -> io::Result<Handshake> {
+    let url = Url::parse(url).map_err(|e| invalid_input(format!("Invalid URL: {}", e)))?;
+    let secure = match url.scheme() {
+        "ws" => false,
+        "wss" => true,
+        scheme => return Err(invalid_input(format!("Unsupported URL scheme: {}", scheme))),
+    };
+    let host = match url.host() {
+        Some(Host::Domain(domain)) => domain.to_string(),
+        Some(Host::Ipv4(addr)) => addr.to_string(),
+        Some(Host::Ipv6(addr)) => addr.to_string(),
+        None => return Err(invalid_input("URL has no host".to_string())),
+    };
+    let port = url
+        .port_or_known_default()
+        .unwrap_or(if secure { 443 } else { 80 });
+
+    let mut socket = socks::connect(proxy, &host, port, options.timeout, options.auth.as_ref())?;
+    let tls = if secure {
+        let mut tls = http::tls_client(&host)?;
+        while tls.is_handshaking() {
+            tls.complete_io(&mut socket)?;
+        }
+        Some(Mutex::new(tls))
+    } else {
+        None
+    };
+    let transport = Transport {
+        tls,
+        writer: Mutex::new(socket.try_clone()?),
+    };
+
+    let mut key = [0u8; 16];
+    fill_random(&mut key)?;
+    let key = STANDARD.encode(key);
+    transport.write_all(request_head(&url, &key, &options).as_bytes())?;
+
+    let mut buf = vec![0u8; READ_CHUNK];
+    let mut received = Vec::new();
+    let head_end = loop {
+        if let Some(pos) = received.windows(4).position(|w| w == b"\r\n\r\n") {
+            break pos + 4;
+        }
+        if received.len() > http::MAX_HEADER_BYTES {
+            return Err(invalid_data("WebSocket response header too large"));
+        }
+        if transport.read(&mut socket, &mut buf, &mut received)? == 0 {
+            return Err(io::Error::new(
+                io::ErrorKind::UnexpectedEof,
+                "Connection closed during the WebSocket handshake",
+            ));
+        }
+    };
+
+    let (status_code, headers) = http::read_head(&mut &received[..head_end])?;
+    if status_code != 101 {
+        return Err(io::Error::other(format!(
+            "WebSocket upgrade failed with HTTP {}",
+            status_code
+        )));
+    }
+    let header = |name| http::find_header(&headers, name).unwrap_or("");
+    if !header("upgrade").eq_ignore_ascii_case("websocket") {
+        return Err(invalid_data("Server did not upgrade to WebSocket"));
+    }
+    if header("sec-websocket-accept") != accept_key(&key) {
+        return Err(invalid_data("Invalid Sec-WebSocket-Accept"));
+    }
+
+    let extensions = header("sec-websocket-extensions").to_string();
+    let deflate = negotiated_deflate(&extensions, options.deflate)?;
+    let protocol = header("sec-websocket-protocol").to_string();
+    if !protocol.is_empty() && !options.protocols.contains(&protocol) {
+        return Err(invalid_data(
+            "Server selected a subprotocol that was not offered",
+        ));
+    }
+    received.drain(..head_end);
+
+    let socket_id = NEXT_ID.fetch_add(1, Ordering::Relaxed);
+    let entry = Arc::new(Entry {
+        transport,
+        deflater: Mutex::new(deflate.as_ref().map(|params| Deflater {
+            compress: Compress::new(Compression::default(), false),
+            reset: params.client_no_context_takeover,
+        })),
+        state: Mutex::new(State::default()),
+        drained: Condvar::new(),
+    });
+    sockets().lock().unwrap().insert(socket_id, entry.clone());
+
+    let reader = Reader {
+        socket_id,
+        entry,
+        inflater: deflate.map(|params| Inflater {
+            decompress: Decompress::new(false),
+            reset: params.server_no_context_takeover,
+        }),
+        message: None,
+    };
+    let ping_interval = options.ping_interval;
+    thread::spawn(move || reader.run(socket, received, ping_interval));
+
+    debug!("Rust FFI: Opened WebSocket {} to {}", socket_id, host);
+    Ok(Handshake {
+        socket_id,
+        protocol,
+        extensions,
+    })
+}
+
+fn request_head(url: &Url, key: &str, options: &Options) -> String {
+    let mut target = url.path().to_string();
+    if let Some(query) = url.query() {
+        target.push('?');
+        target.push_str(query);
+    }
+
+    let mut head = format!("GET {} HTTP/1.1\r\n", target);
+    let host = url.host_str().unwrap_or_default();
+    match url.port() {
+        Some(port) => head.push_str(&format!("Host: {}:{}\r\n", host, port)),
+        None => head.push_str(&format!("Host: {}\r\n", host)),
+    }
+    head.push_str("Upgrade: websocket\r\nConnection: Upgrade\r\n");
+    head.push_str(&format!(
+        "Sec-WebSocket-Key: {}\r\nSec-WebSocket-Version: 13\r\n",
+        key
+    ));
+    if !options.protocols.is_empty() {
+        head.push_str(&format!(
+            "Sec-WebSocket-Protocol: {}\r\n",
+            options.protocols.join(", ")
+        ));
+    }
+    if options.deflate {
+        // No client_max_window_bits: the compressor always uses a 32 KiB
+        // window, and without the offer the server cannot ask for less.
+        head.push_str("Sec-WebSocket-Extensions: permessage-deflate\r\n");
+    }
+
+    for (key, value) in &options.headers {
+        let managed = ["host", "upgrade", "connection"]
+            .iter()
+            .any(|managed| managed.eq_ignore_ascii_case(key))
+            || key.to_ascii_lowercase().starts_with("sec-websocket-");
+        if !managed {
+            head.push_str(&format!("{}: {}\r\n", key, value));
+        }
+    }
+    head.push_str("\r\n");
+    head
+}
+
+fn accept_key(key: &str) -> String {
+    let hash = digest::digest(
+        &digest::SHA1_FOR_LEGACY_USE_ONLY,
+        format!("{}{}", key, ACCEPT_GUID).as_bytes(),
+    );
+    STANDARD.encode(hash.as_ref())
+}
+
+/// permessage-deflate parameters the server accepted (RFC 7692).
+struct DeflateParams {
+    client_no_context_takeover: bool,
+    server_no_context_takeover: bool,
+}
+
+fn negotiated_deflate(extensions: &str, offered: bool) -> io::Result<Option<DeflateParams>> {
+    let mut negotiated = None;
+
+    for extension in extensions.split(',').filter(|e| !e.trim().is_empty()) {
+        let mut params = extension.split(';').map(str::trim);
+        if params.next() != Some("permessage-deflate") || !offered || negotiated.is_some() {
+            return Err(invalid_data(
+                "Server accepted an extension that was not offered",
+            ));
+        }
+
+        let mut deflate = DeflateParams {
+            client_no_context_takeover: false,
+            server_no_context_takeover: false,
+        };
+        for param in params {
+            match param.split('=').next().unwrap_or_default().trim() {
+                "client_no_context_takeover" => deflate.client_no_context_takeover = true,
+                "server_no_context_takeover" => deflate.server_no_context_takeover = true,
+                // A smaller server window is still readable with ours.
+                "server_max_window_bits" => {}
+                _ => return Err(invalid_data("Unsupported permessage-deflate parameter")),
+            }
+        }
+        negotiated = Some(deflate);
+    }
+
+    Ok(negotiated)
+}
+
+/// Sends a text message, or a binary one when `binary` is set.
+pub fn send(socket_id: u64, data: &[u8], binary: bool) -> io::Result<()> {
+    let entry = entry(socket_id)?;
+    if entry.state.lock().unwrap().close_sent {
+        return Err(io::Error::new(
+            io::ErrorKind::NotConnected,
+            "WebSocket is closing",
+        ));
+    }
+
+    let opcode = if binary { OP_BINARY } else { OP_TEXT };
+    let mut deflater = entry.deflater.lock().unwrap();
+    let frame = match deflater.as_mut() {
+        Some(deflater) if data.len() >= MIN_COMPRESS => {
+            encode_frame(opcode, true, &deflater.compress(data)?)?
+        }
+        _ => encode_frame(opcode, false, data)?,
+    };
+    entry.transport.write_all(&frame)
+}
+
+/// Starts the closing handshake. The socket's close event arrives through
+/// [`events`] once the server answered or [`CLOSE_TIMEOUT`] passed.
+pub fn close(socket_id: u64, code: u16, reason: &str) -> io::Result<()> {
+    let entry = entry(socket_id)?;
+    {
+        let mut state = entry.state.lock().unwrap();
+        if state.close_sent {
+            return Ok(());
+        }
+        state.close_sent = true;
+    }
+
+    entry.send_close(code, reason)?;
+
+    thread::spawn(move || {
+        thread::sleep(CLOSE_TIMEOUT);
+        if sockets().lock().unwrap().contains_key(&socket_id) {
+            debug!("Rust FFI: WebSocket {} did not answer close", socket_id);
+            entry.transport.shutdown();
+        }
+    });
+    Ok(())
+}
+
+/// Drops the connection of every socket, e.g. when the service shuts down;
+/// each still reports its close event.
+pub fn close_all() {
+    for entry in sockets().lock().unwrap().values() {
+        entry.transport.shutdown();
+    }
+}
+
+/// Starts delivering the events of a socket returned by [`connect`].
+///
+/// The reader runs as soon as the handshake completes, but JS only learns the
+/// socket id when `connect` returns, so a poll in between would hand it
+/// messages, or even the close, of a socket it cannot route yet. [`take`]
+/// holds them back until JS has registered the socket and calls this.
+pub fn attach(id: u64) {
+    attached().lock().unwrap().insert(id);
+    events::notify();
+}
+
+/// Takes the events of all attached sockets since the previous call.
+///
+/// Events queue up while JS is busy, so one call delivers every message
+/// received since the previous one, whatever the number of open sockets.
+pub fn take() -> Vec<Event> {
+    let mut attached = attached().lock().unwrap();
+    let mut pending = pending().lock().unwrap();
+    let (taken, held): (Vec<Event>, Vec<Event>) = mem::take(&mut *pending)
+        .into_iter()
+        .partition(|event| attached.contains(&event.socket_id));
+    *pending = held;
+    drop(pending);
+
+    let sockets = sockets().lock().unwrap();
+    for event in &taken {
+        if let EventKind::Close { .. } = event.kind {
+            attached.remove(&event.socket_id);
+        } else if let Some(entry) = sockets.get(&event.socket_id) {
+            entry.state.lock().unwrap().queued = 0;
+            entry.drained.notify_all();
+        }
+    }
+    taken
+}
+
+impl Entry {
+    fn send_control(&self, opcode: u8, payload: &[u8]) -> io::Result<()> {
+        self.transport
+            .write_all(&encode_frame(opcode, false, payload)?)
+    }
+
+    fn send_close(&self, code: u16, reason: &str) -> io::Result<()> {
+        // Control frame payloads are limited to 125 bytes, 2 of them the code.
+        let mut end = reason.len().min(123);
+        while !reason.is_char_boundary(end) {
+            end -= 1;
+        }
+        let mut payload = code.to_be_bytes().to_vec();
+        payload.extend_from_slice(reason[..end].as_bytes());
+        self.send_control(OP_CLOSE, &payload)
+    }
+}
+
+/// Owns the read side of a socket: parses frames, answers pings and close
+/// frames, and queues messages for JS.
+struct Reader {
+    socket_id: u64,
+    entry: Arc<Entry>,
+    inflater: Option<Inflater>,
+    /// Opcode, compression flag and payload of a fragmented message.
+    message: Option<(u8, bool, Vec<u8>)>,
+}
+
+impl Reader {
+    fn run(mut self, mut socket: socks::Stream, pending: Vec<u8>, ping: Option<Duration>) {
+        let (code, reason) = match self.read_frames(&mut socket, pending, ping) {
+            Ok(Some(close)) => close,
+            Ok(None) => (CLOSE_ABNORMAL, String::new()),
+            Err(e) => {
+                debug!("Rust FFI: WebSocket {} failed {:?}", self.socket_id, e);
+                self.push(
+                    EventKind::Error {
+                        message: e.to_string(),
+                    },
+                    0,
+                );
+                (CLOSE_ABNORMAL, String::new())
+            }
+        };
+
+        self.entry.transport.shutdown();
+        sockets().lock().unwrap().remove(&self.socket_id);
+        self.push(EventKind::Close { code, reason }, 0);
+        debug!("Rust FFI: Closed WebSocket {} ({})", self.socket_id, code);
+    }
+
+    /// Returns the server's close code and reason, or `None` when the
+    /// connection ended without a close frame.
+    fn read_frames(
+        &mut self,
+        socket: &mut socks::Stream,
+        mut pending: Vec<u8>,
+        ping: Option<Duration>,
+    ) -> io::Result<Option<(u16, String)>> {
+        socket.set_read_timeout(ping)?;
+        let mut buf = vec![0u8; READ_CHUNK];
+        let mut awaiting_pong = false;
+
+        loop {
+            let mut used = 0;
+            while let Some((frame, len)) = decode_frame(&pending[used..])? {
+                used += len;
+                if let Some(close) = self.on_frame(frame)? {
+                    return Ok(Some(close));
+                }
+            }
+            pending.drain(..used);
+
+            {
+                let mut state = self.entry.state.lock().unwrap();
+                while state.queued >= MAX_QUEUED {
+                    state = self.entry.drained.wait(state).unwrap();
+                }
+            }
+
+            match self.entry.transport.read(socket, &mut buf, &mut pending) {
+                Ok(0) => return Ok(None),
+                Ok(_) => awaiting_pong = false,
+                Err(e)
+                    if matches!(
+                        e.kind(),
+                        io::ErrorKind::WouldBlock | io::ErrorKind::TimedOut
+                    ) =>
+                {
+                    if awaiting_pong {
+                        return Err(io::Error::new(
+                            io::ErrorKind::TimedOut,
+                            "WebSocket ping timed out",
+                        ));
+                    }
+                    self.entry.send_control(OP_PING, &[])?;
+                    awaiting_pong = true;
+                }
+                Err(e) if e.kind() == io::ErrorKind::Interrupted => {}
+                Err(e) => return Err(e),
+            }
+        }
+    }
+
+    fn on_frame(&mut self, frame: Frame) -> io::Result<Option<(u16, String)>> {
+        if frame.opcode >= OP_CLOSE && (!frame.fin || frame.payload.len() > 125) {
+            return Err(invalid_data("Invalid WebSocket control frame"));
+        }
+
+        let (opcode, compressed, mut payload) = match frame.opcode {
+            OP_PING => {
+                self.entry.send_control(OP_PONG, &frame.payload)?;
+                return Ok(None);
+            }
+            OP_PONG => return Ok(None),
+            OP_CLOSE => {
+                let close = match frame.payload.len() {
+                    0 => (CLOSE_NO_STATUS, String::new()),
+                    1 => return Err(invalid_data("Invalid WebSocket close frame")),
+                    _ => (
+                        u16::from_be_bytes([frame.payload[0], frame.payload[1]]),
+                        String::from_utf8_lossy(&frame.payload[2..]).into_owned(),
+                    ),
+                };
+                // Answer the server's close unless we started the handshake.
+                let echo = !mem::replace(&mut self.entry.state.lock().unwrap().close_sent, true);
+                if echo {
+                    let _ = self
+                        .entry
+                        .send_control(OP_CLOSE, &frame.payload[..frame.payload.len().min(2)]);
+                }
+                return Ok(Some(close));
+            }
+            OP_TEXT | OP_BINARY if self.message.is_none() => {
+                if frame.rsv1 && self.inflater.is_none() {
+                    return Err(invalid_data("Compressed frame without permessage-deflate"));
+                }
+                (frame.opcode, frame.rsv1, frame.payload)
+            }
+            OP_CONTINUATION if frame.rsv1 => {
+                return Err(invalid_data("Compression flag on a continuation frame"));
+            }
+            OP_CONTINUATION => match self.message.take() {
+                Some((opcode, compressed, mut payload)) => {
+                    payload.extend_from_slice(&frame.payload);
+                    (opcode, compressed, payload)
+                }
+                None => return Err(invalid_data("Unexpected continuation frame")),
+            },
+            OP_TEXT | OP_BINARY => return Err(invalid_data("Expected a continuation frame")),
+            _ => return Err(invalid_data("Unknown WebSocket opcode")),
+        };
+
+        if payload.len() > MAX_MESSAGE {
+            return Err(invalid_data("WebSocket message too large"));
+        }
+        if !frame.fin {
+            self.message = Some((opcode, compressed, payload));
+            return Ok(None);
+        }
+
+        if compressed {
+            if let Some(inflater) = self.inflater.as_mut() {
+                payload = inflater.decompress(&payload)?;
+            }
+        }
+
+        let size = payload.len();
+        let kind = if opcode == OP_TEXT {
+            EventKind::Text {
+                data: String::from_utf8(payload)
+                    .map_err(|_| invalid_data("WebSocket text message is not UTF-8"))?,
+            }
+        } else {
+            EventKind::Binary {
+                data: STANDARD.encode(&payload),
+            }
+        };
+        self.push(kind, size);
+        Ok(None)
+    }
+
+    fn push(&self, kind: EventKind, size: usize) {
+        self.entry.state.lock().unwrap().queued += size;
+
+        pending().lock().unwrap().push(Event {
+            socket_id: self.socket_id,
+            kind,
+        });
+        events::notify();
+    }
+}
+
+struct Frame {
+    fin: bool,
+    rsv1: bool,
+    opcode: u8,
+    payload: Vec<u8>,
+}
+
+/// Parses the frame at the start of `buf`, returning it with its length, or
+/// `None` if it has not been fully received yet.
+fn decode_frame(buf: &[u8]) -> io::Result<Option<(Frame, usize)>> {
+    if buf.len() < 2 {
+        return Ok(None);
+    }
+    if buf[0] & 0x30 != 0 {
+        return Err(invalid_data("Reserved WebSocket frame bits set"));
+    }
+
+    let (len, mut offset) = match buf[1] & 0x7f {
+        126 if buf.len() >= 4 => (u16::from_be_bytes([buf[2], buf[3]]) as u64, 4),
+        127 if buf.len() >= 10 => (u64::from_be_bytes(buf[2..10].try_into().unwrap()), 10),
+        126 | 127 => return Ok(None),
+        len => (len as u64, 2),
+    };
+    if len > MAX_MESSAGE as u64 {
+        return Err(invalid_data("WebSocket message too large"));
+    }
+    let len = len as usize;
+
+    // Servers must not mask, but unmasking costs nothing.
+    let mask = if buf[1] & 0x80 != 0 {
+        let Some(mask) = buf.get(offset..offset + 4) else {
+            return Ok(None);
+        };
+        offset += 4;
+        Some([mask[0], mask[1], mask[2], mask[3]])
+    } else {
+        None
+    };
+
+    let Some(payload) = buf.get(offset..offset + len) else {
+        return Ok(None);
+    };
+    let mut payload = payload.to_vec();
+    if let Some(mask) = mask {
+        apply_mask(&mut payload, mask);
+    }
+
+    Ok(Some((
+        Frame {
+            fin: buf[0] & 0x80 != 0,
+            rsv1: buf[0] & 0x40 != 0,
+            opcode: buf[0] & 0x0f,
+            payload,
+        },
+        offset + len,
+    )))
+}
+
+/// A single-frame client message; clients must mask every frame.
+fn encode_frame(opcode: u8, compressed: bool, payload: &[u8]) -> io::Result<Vec<u8>> {
+    let mut frame = Vec::with_capacity(payload.len() + 14);
+    frame.push(0x80 | if compressed { 0x40 } else { 0 } | opcode);
+    match payload.len() {
+        len if len < 126 => frame.push(0x80 | len as u8),
+        len if len <= 0xffff => {
+            frame.push(0x80 | 126);
+            frame.extend_from_slice(&(len as u16).to_be_bytes());
+        }
+        len => {
+            frame.push(0x80 | 127);
+            frame.extend_from_slice(&(len as u64).to_be_bytes());
+        }
+    }
+
+    let mut mask = [0u8; 4];
+    fill_random(&mut mask)?;
+    frame.extend_from_slice(&mask);
+    let start = frame.len();
+    frame.extend_from_slice(payload);
+    apply_mask(&mut frame[start..], mask);
+    Ok(frame)
+}
+
+fn apply_mask(data: &mut [u8], mask: [u8; 4]) {
+    for (i, byte) in data.iter_mut().enumerate() {
+        *byte ^= mask[i % 4];
+    }
+}
+
+struct Deflater {
+    compress: Compress,
+    /// client_no_context_takeover: start every message with an empty window.
+    reset: bool,
+}
+
+impl Deflater {
+    fn compress(&mut self, data: &[u8]) -> io::Result<Vec<u8>> {
+        let start = self.compress.total_in();
+        let mut out = Vec::with_capacity(data.len() / 2 + 64);
+        loop {
+            let consumed = (self.compress.total_in() - start) as usize;
+            self.compress
+                .compress_vec(&data[consumed..], &mut out, FlushCompress::Sync)
+                .map_err(io::Error::other)?;
+            let consumed = (self.compress.total_in() - start) as usize;
+            // The sync flush is complete once all input is in and the output
+            // did not fill up.
+            if consumed == data.len() && out.len() < out.capacity() {
+                break;
+            }
+            out.reserve(out.capacity());
+        }
+
+        if out.ends_with(&DEFLATE_TAIL) {
+            out.truncate(out.len() - DEFLATE_TAIL.len());
+        }
+        if self.reset {
+            self.compress.reset();
+        }
+        Ok(out)
+    }
+}
+
+struct Inflater {
+    decompress: Decompress,
+    /// server_no_context_takeover: the server starts every message with an
+    /// empty window.
+    reset: bool,
+}
+
+impl Inflater {
+    fn decompress(&mut self, data: &[u8]) -> io::Result<Vec<u8>> {
+        let mut input = Vec::with_capacity(data.len() + DEFLATE_TAIL.len());
+        input.extend_from_slice(data);
+        input.extend_from_slice(&DEFLATE_TAIL);
+
+        let start = self.decompress.total_in();
+        let mut out = Vec::with_capacity(data.len() * 3 + 64);
+        loop {
+            let consumed = (self.decompress.total_in() - start) as usize;
+            self.decompress
+                .decompress_vec(&input[consumed..], &mut out, FlushDecompress::Sync)
+                .map_err(|e| invalid_data(&format!("Invalid compressed message: {}", e)))?;
+            let consumed = (self.decompress.total_in() - start) as usize;
+            if consumed == input.len() && out.len() < out.capacity() {
+                break;
+            }
+            if out.len() > MAX_MESSAGE {
+                return Err(invalid_data("WebSocket message too large"));
+            }
+            out.reserve(out.capacity());
+        }
+
+        if self.reset {
+            self.decompress.reset(false);
+        }
+        Ok(out)
+    }
+}
+
+/// The socket split in two: a reader thread and any number of senders.
+///
+/// rustls keeps its state in a `ClientConnection` that is not tied to the
+/// socket, so both sides lock it only while moving bytes through it and a
+/// send never waits for the reader to receive something.
+struct Transport {
+    tls: Option<Mutex<ClientConnection>>,
+    writer: Mutex<socks::Stream>,
+}
+
+impl Transport {
+    fn write_all(&self, data: &[u8]) -> io::Result<()> {
+        match &self.tls {
+            Some(tls) => {
+                let mut tls = tls.lock().unwrap();
+                tls.writer().write_all(data)?;
+                self.flush_tls(&mut tls)
+            }
+            None => {
+                let mut writer = self.writer.lock().unwrap();
+                writer.write_all(data)?;
+                writer.flush()
+            }
+        }
+    }
+
+    fn flush_tls(&self, tls: &mut ClientConnection) -> io::Result<()> {
+        let mut writer = self.writer.lock().unwrap();
+        while tls.wants_write() {
+            tls.write_tls(&mut *writer)?;
+        }
+        writer.flush()
+    }
+
+    /// Reads once from `socket` and appends the received plaintext to `out`.
+    ///
+    /// Returns the number of bytes read from the socket, 0 at end of stream.
+    fn read(
+        &self,
+        socket: &mut socks::Stream,
+        buf: &mut [u8],
+        out: &mut Vec<u8>,
+    ) -> io::Result<usize> {
+        let read = socket.read(buf)?;
+        let Some(tls) = &self.tls else {
+            out.extend_from_slice(&buf[..read]);
+            return Ok(read);
+        };
+        if read == 0 {
+            return Ok(0);
+        }
+
+        let mut tls = tls.lock().unwrap();
+        let mut input = &buf[..read];
+        while !input.is_empty() {
+            tls.read_tls(&mut input)?;
+            let state = tls.process_new_packets().map_err(io::Error::other)?;
+            match tls.reader().read_to_end(out) {
+                Ok(_) => {}
+                Err(e) if e.kind() == io::ErrorKind::WouldBlock => {}
+                Err(e) => return Err(e),
+            }
+            if state.peer_has_closed() {
+                break;
+            }
+        }
+        // Alerts and key updates produced while reading.
+        self.flush_tls(&mut tls)?;
+        Ok(read)
+    }
+
+    /// Unblocks the reader; both socket handles refer to the same connection.
+    fn shutdown(&self) {
+        let _ = self.writer.lock().unwrap().shutdown(Shutdown::Both);
+    }
+}
+
+fn fill_random(buf: &mut [u8]) -> io::Result<()> {
+    SystemRandom::new()
+        .fill(buf)
+        .map_err(|_| io::Error::other("No secure random source"))
+}
+
+fn invalid_input(message: String) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidInput, message)
+}
+
+fn invalid_data(message: &str) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, message.to_string())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn deflater(reset: bool) -> Deflater {
+        Deflater {
+            compress: Compress::new(Compression::default(), false),
+            reset,
+        }
+    }
+
+    fn inflater(reset: bool) -> Inflater {
+        Inflater {
+            decompress: Decompress::new(false),
+            reset,
+        }
+    }
+
+    /// A frame as a server sends it: unmasked, with the shortest length.
+    fn server_frame(first: u8, payload: &[u8]) -> Vec<u8> {
+        let mut frame = vec![first];
+        match payload.len() {
+            len if len < 126 => frame.push(len as u8),
+            len if len <= 0xffff => {
+                frame.push(126);
+                frame.extend_from_slice(&(len as u16).to_be_bytes());
+            }
+            len => {
+                frame.push(127);
+                frame.extend_from_slice(&(len as u64).to_be_bytes());
+            }
+        }
+        frame.extend_from_slice(payload);
+        frame
+    }
+
+    #[test]
+    fn frames_round_trip_at_length_boundaries() {
+        for len in [0, 1, 125, 126, 127, 0xffff, 0x10000] {
+            let payload: Vec<u8> = (0..len).map(|i| i as u8).collect();
+            let frame = encode_frame(OP_BINARY, false, &payload).unwrap();
+            let header = match len {
+                0..=125 => 2,
+                126..=0xffff => 4,
+                _ => 10,
+            };
+            assert_eq!(frame.len(), header + 4 + len, "length {}", len);
+
+            let (decoded, used) = decode_frame(&frame).unwrap().unwrap();
+            assert_eq!(used, frame.len());
+            assert!(decoded.fin && !decoded.rsv1);
+            assert_eq!(decoded.opcode, OP_BINARY);
+            assert_eq!(decoded.payload, payload, "length {}", len);
+        }
+    }
+
+    #[test]
+    fn decodes_server_frames_with_extended_lengths() {
+        for len in [126, 0xffff, 0x10000] {
+            let payload = vec![b'x'; len];
+            let frame = server_frame(0x80 | OP_TEXT, &payload);
+            let (decoded, used) = decode_frame(&frame).unwrap().unwrap();
+            assert_eq!((used, decoded.payload.len()), (frame.len(), len));
+        }
+
+        // A 127 length may carry a length that fits in fewer bytes.
+        let mut frame = vec![0x80 | OP_TEXT, 127];
+        frame.extend_from_slice(&3u64.to_be_bytes());
+        frame.extend_from_slice(b"abc");
+        let (decoded, used) = decode_frame(&frame).unwrap().unwrap();
+        assert_eq!((used, decoded.payload.as_slice()), (13, &b"abc"[..]));
+    }
+
+    #[test]
+    fn waits_for_incomplete_frames() {
+        for len in [5, 200, 0x10000] {
+            let frame = server_frame(0x80 | OP_BINARY, &vec![7; len]);
+            for end in 0..frame.len() {
+                assert!(
+                    decode_frame(&frame[..end]).unwrap().is_none(),
+                    "{} of {}",
+                    end,
+                    len
+                );
+            }
+        }
+
+        let masked = encode_frame(OP_TEXT, false, b"hello").unwrap();
+        for end in 0..masked.len() {
+            assert!(decode_frame(&masked[..end]).unwrap().is_none());
+        }
+    }
+
+    #[test]
+    fn leaves_following_frames_in_the_buffer() {
+        let mut buf = server_frame(OP_TEXT, b"one");
+        buf.extend(server_frame(0x80 | OP_CONTINUATION, b"two"));
+
+        let (first, used) = decode_frame(&buf).unwrap().unwrap();
+        assert!(!first.fin);
+        assert_eq!(first.payload, b"one");
+        let (second, rest) = decode_frame(&buf[used..]).unwrap().unwrap();
+        assert!(second.fin);
+        assert_eq!(second.opcode, OP_CONTINUATION);
+        assert_eq!(
+            (second.payload.as_slice(), used + rest),
+            (&b"two"[..], buf.len())
+        );
+    }
+
+    #[test]
+    fn rejects_malformed_frames() {
+        for first in [0x90, 0xa0, 0xb0] {
+            let error = decode_frame(&server_frame(first | OP_TEXT, b"x")).err();
+            assert_eq!(error.map(|e| e.kind()), Some(io::ErrorKind::InvalidData));
+        }
+
+        for len in [MAX_MESSAGE as u64 + 1, u64::MAX] {
+            let mut frame = vec![0x80 | OP_BINARY, 127];
+            frame.extend_from_slice(&len.to_be_bytes());
+            assert!(decode_frame(&frame).is_err(), "length {}", len);
+        }
+
+        let compressed = server_frame(0xc0 | OP_TEXT, b"x");
+        assert!(decode_frame(&compressed).unwrap().unwrap().0.rsv1);
+    }
+
+    #[test]
+    fn inflates_rfc_7692_examples() {
+        // A message and the same message again with the shared window.
+        let mut inflater = inflater(false);
+        let first = inflater
+            .decompress(&[0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00])
+            .unwrap();
+        assert_eq!(first, b"Hello");
+        let second = inflater
+            .decompress(&[0xf2, 0x00, 0x11, 0x00, 0x00])
+            .unwrap();
+        assert_eq!(second, b"Hello");
+    }
+
+    #[test]
+    fn deflate_round_trips_with_and_without_context_takeover() {
+        for reset in [false, true] {
+            let mut deflater = deflater(reset);
+            let mut inflater = inflater(reset);
+            for message in [&b"Hello"[..], b"Hello", b"", &[0u8; 100_000]] {
+                let compressed = deflater.compress(message).unwrap();
+                assert!(!compressed.ends_with(&DEFLATE_TAIL));
+                assert_eq!(inflater.decompress(&compressed).unwrap(), message);
+            }
+        }
+    }
+
+    #[test]
+    fn inflate_rejects_malformed_and_oversized_messages() {
+        let error = inflater(false).decompress(&[0xff, 0xff, 0xff]).err();
+        assert_eq!(error.map(|e| e.kind()), Some(io::ErrorKind::InvalidData));
+
+        let bomb = deflater(false).compress(&vec![0; MAX_MESSAGE * 2]).unwrap();
+        let error = inflater(false).decompress(&bomb).err();
+        assert_eq!(error.map(|e| e.kind()), Some(io::ErrorKind::InvalidData));
+    }
+
+    #[test]
+    fn accept_key_matches_rfc_6455() {
+        assert_eq!(
+            accept_key("dGhlIHNhbXBsZSBub25jZQ=="),
+            "s3pPLMBiTxaQ9kYGzzhZRbK+xOo="
+        );
+    }
+
+    #[test]
+    fn negotiates_only_offered_deflate() {
+        assert!(negotiated_deflate("", true).unwrap().is_none());
+        let params = negotiated_deflate(
+            "permessage-deflate; client_no_context_takeover; server_max_window_bits=10",
+            true,
+        )
+        .unwrap()
+        .unwrap();
+        assert!(params.client_no_context_takeover && !params.server_no_context_takeover);
+
+        assert!(negotiated_deflate("permessage-deflate", false).is_err());
+        assert!(negotiated_deflate("x-webkit-deflate-frame", true).is_err());
+        assert!(negotiated_deflate("permessage-deflate, permessage-deflate", true).is_err());
+        assert!(negotiated_deflate("permessage-deflate; client_max_window_bits=8", true).is_err());
+    }
+
+    #[test]
+    fn holds_events_until_the_socket_is_attached() {
+        let id = NEXT_ID.fetch_add(1, Ordering::Relaxed);
+        let push = |kind| {
+            pending().lock().unwrap().push(Event {
+                socket_id: id,
+                kind,
+            })
+        };
+        push(EventKind::Text {
+            data: "first".to_string(),
+        });
+        push(EventKind::Close {
+            code: 1000,
+            reason: String::new(),
+        });
+
+        assert!(take().iter().all(|event| event.socket_id != id));
+        assert_eq!(pending().lock().unwrap().len(), 2);
+
+        attach(id);
+        let taken: Vec<_> = take().into_iter().filter(|e| e.socket_id == id).collect();
+        assert_eq!(taken.len(), 2);
+        assert!(matches!(&taken[0].kind, EventKind::Text { data } if data == "first"));
+        assert!(matches!(taken[1].kind, EventKind::Close { code: 1000, .. }));
+        assert!(!attached().lock().unwrap().contains(&id));
+    }
+}
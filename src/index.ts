@@ -1,6 +1,6 @@
 import NativeReactNativeNitroTor, {
-	TorConfig,
-	HiddenServiceParams,
+	TorConfig as NativeTorConfig,
+	HiddenServiceParams as NativeHiddenServiceParams,
 	StartTorParams as NativeStartTorParams,
 	StartTorResponse as NativeStartTorResponse,
 	HiddenServiceResponse,
@@ -9,6 +9,14 @@ import NativeReactNativeNitroTor, {
 	HttpPutParams,
 	HttpDeleteParams,
 	HttpResponse,
+	DirectorySnapshotParams,
+	DirectorySnapshotResponse,
+	TorListeners,
+	ResumeResponse,
+	StreamResponse,
+	ProxyResponse,
+	HttpServerResponse,
+	OnionPublishResponse,
 } from "./NativeReactNativeNitroTor";
 
 export type KeySpec = {
@@ -18,7 +26,28 @@ export type KeySpec = {
 	generate?: boolean;
 };
 
-export type StartTorParams = Omit<NativeStartTorParams, "keys_json"> & {
+export type TorProfile = "low-latency" | "bulk" | "battery-saver";
+
+export type TorOptions = {
+	/** Named set of torrc performance settings; omit for Tor's defaults. */
+	profile?: TorProfile;
+	/**
+	 * Split streams over two circuit legs (Tor 0.4.8+). "throughput" and
+	 * "latency" also pick how traffic is scheduled over the legs. Omit to
+	 * follow the profile and the consensus.
+	 */
+	conflux?: boolean | "throughput" | "latency";
+	/** Raw torrc options applied after the profile, e.g. { NumEntryGuards: 2 }. */
+	torrc_overrides?: Record<string, string | number | boolean>;
+};
+
+export type TorConfig = Omit<NativeTorConfig, "profile" | "torrc_overrides_json"> & TorOptions;
+
+export type StartTorParams = Omit<
+	NativeStartTorParams,
+	"keys_json" | "profile" | "torrc_overrides_json"
+> &
+	TorOptions & {
 	/**
 	 * List of key configurations to host the same service.
 	 * generate:false => use provided seed/pub (static bootstrap key)
@@ -27,11 +56,219 @@ export type StartTorParams = Omit<NativeStartTorParams, "keys_json"> & {
 	keys?: KeySpec[];
 };
 
+export type CircuitStats = {
+	/** Circuits Tor built for the isolation key. */
+	built: number;
+	/** Requests that were served by an already built circuit. */
+	reused: number;
+};
+
+export type PrewarmOptions = {
+	/** How long to keep the circuits warm in milliseconds (default 10 minutes). */
+	keepalive_ms?: number;
+	/** Isolation key of the requests that will use the circuits. */
+	isolation?: string;
+};
+
+export type PrewarmStatus = {
+	target: string;
+	state: "waiting" | "warming" | "hot" | "failed" | "expired";
+	/** Milliseconds from the prewarm call until the circuit was usable. */
+	ready_ms: number;
+	error: string;
+};
+
+export type BootstrapPhaseMark = {
+	/** Tor's bootstrap tag, e.g. "conn_dir", "handshake", "loading_descriptors" or "done". */
+	phase: string;
+	progress: number;
+	summary: string;
+	/** Milliseconds since the service started. */
+	at_ms: number;
+};
+
+export type StartupReport = {
+	/** Cost of `initializeTorLibrary`, measured once per process. */
+	library: { logger_ms: number; runtime_ms: number; total_ms: number };
+	/** "cold", "snapshot" or "warm", depending on the directory cache Tor started with. */
+	start_kind: string;
+	service_init_ms: number;
+	/** 0 while Tor is still bootstrapping. */
+	time_to_done_ms: number;
+	phases: BootstrapPhaseMark[];
+	/** Profile or override options Tor rejected, as "Option: reason". */
+	config_errors: string[];
+	/** Set when the service failed to start. */
+	error: string;
+};
+
+/**
+ * Per-service defenses against introduction floods. Unset fields keep Tor's
+ * defaults. The proof-of-work and intro rate settings need a service
+ * configured in Tor's torrc style, whose keys live under the data directory
+ * until it is deleted or Tor shuts down.
+ */
+export type OnionDefenses = {
+	/** Clients solve a proof of work whose effort rises under load. */
+	pow_enabled?: boolean;
+	/** Introductions handled per second from the PoW queue. */
+	pow_queue_rate?: number;
+	pow_queue_burst?: number;
+	/** Introduction rate limit enforced at the intro points. */
+	intro_rate_per_sec?: number;
+	intro_burst_per_sec?: number;
+	/** Streams allowed per rendezvous circuit. */
+	max_streams?: number;
+	/** Close the whole circuit, not just the stream, past max_streams. */
+	max_streams_close_circuit?: boolean;
+};
+
+/** A further virtual port of an onion service and where it forwards to. */
+export type OnionPort = {
+	port: number;
+	target_port: number;
+};
+
+export type HiddenServiceParams = Omit<NativeHiddenServiceParams, "defenses_json" | "ports_json"> & {
+	defenses?: OnionDefenses;
+	/** Ports served next to port, under the same address and descriptor. */
+	ports?: OnionPort[];
+};
+
 export type StartTorResponse = NativeStartTorResponse & {
 	/** Parsed list of onion addresses, if multiple were created. */
 	onion_addresses?: string[];
 };
 
+export type OpenStreamOptions = {
+	/** Timeout for the SOCKS connect and for each write (default 60 seconds). */
+	timeout_ms?: number;
+	/** Streams with the same isolation key share Tor circuits. */
+	isolation?: string;
+};
+
+/** Raw TCP stream through Tor. */
+export interface TorStream {
+	readonly id: number;
+	write(data: ArrayBuffer | Uint8Array): Promise<void>;
+	/** Next chunk of received bytes, or null once the peer closed its side. */
+	read(maxBytes?: number): Promise<ArrayBuffer | null>;
+	/**
+	 * Calls `listener` for every received chunk until the stream ends, then
+	 * `onEnd` with the error, if any. Returns a function that stops reading.
+	 */
+	onData(listener: (chunk: ArrayBuffer) => void, onEnd?: (error?: Error) => void): () => void;
+	/** Half-close: the peer sees the end of our data, reads keep working. */
+	shutdownWrite(): Promise<void>;
+	close(): Promise<boolean>;
+}
+
+export type WebSocketOptions = {
+	headers?: Record<string, string>;
+	/** Subprotocols to offer; the selected one is in `protocol`. */
+	protocols?: string[];
+	/** Connect and handshake timeout (default 60 seconds). */
+	timeout_ms?: number;
+	/** Ping after this many idle milliseconds (default 30 seconds); 0 disables pings. */
+	ping_interval_ms?: number;
+	/** Offer permessage-deflate compression (default true). */
+	deflate?: boolean;
+	/** Connections with the same isolation key share Tor circuits. */
+	isolation?: string;
+};
+
+/** WebSocket connection through Tor. */
+export interface TorWebSocket {
+	/** Subprotocol selected by the server. */
+	readonly protocol: string;
+	/** Extensions accepted by the server. */
+	readonly extensions: string;
+	onmessage: ((data: string | ArrayBuffer) => void) | null;
+	onerror: ((error: Error) => void) | null;
+	/** Called once, last; 1006 when the connection dropped without a close frame. */
+	onclose: ((code: number, reason: string) => void) | null;
+	/** Sends strings as text messages and bytes as binary messages. */
+	send(data: string | ArrayBuffer | Uint8Array): Promise<void>;
+	close(code?: number, reason?: string): Promise<void>;
+}
+
+export type ProxyOptions = {
+	/**
+	 * Loopback "host:port" (port 0 picks a free one) or "unix:/path".
+	 * Defaults to 127.0.0.1 on a free port.
+	 */
+	listen?: string;
+	/** Connections through the proxy share circuits with requests using this key. */
+	isolation?: string;
+};
+
+/** Request received by a server started with startHttpServer. */
+export type HttpServerRequest = {
+	id: number;
+	server_id: number;
+	method: string;
+	/** Path and query as sent by the client. */
+	target: string;
+	/** Lowercase names; repeated headers are joined with ", ". */
+	headers: Record<string, string>;
+	body: string;
+	/** Set instead of `body` when the body is not valid UTF-8. */
+	body_base64?: string;
+};
+
+export type HttpServerReply = {
+	/** Defaults to 200. */
+	status?: number;
+	headers?: Record<string, string>;
+	body?: string | ArrayBuffer | Uint8Array;
+};
+
+export type HttpHandler = (
+	request: HttpServerRequest,
+) => HttpServerReply | Promise<HttpServerReply>;
+
+export type HttpServerOptions = {
+	/**
+	 * Loopback "host:port", usually the onion service's target port, or
+	 * "unix:/path".
+	 */
+	listen: string;
+	/** Directory served for GET and HEAD, relative to the app's data directory. */
+	static_dir?: string;
+	/**
+	 * URL path prefixes mapped to directories, e.g. { "/media": "media" }.
+	 * The longest matching prefix wins over static_dir.
+	 */
+	routes?: Record<string, string>;
+	/** Answers requests that are not static files; without one they get a 404. */
+	handler?: HttpHandler;
+	/** Time the handler has before the client gets a 504 (default 30 seconds). */
+	handler_timeout_ms?: number;
+};
+
+/** Called with each stream a client opens to a service created with accept_streams. */
+export type OnionStreamListener = (stream: TorStream, onionAddress: string, port: number) => void;
+
+/** A descriptor upload of one of our onion services. */
+export type OnionPublishEvent = {
+	onion_address: string;
+	/** "UPLOAD" when sent, "UPLOADED" when the HSDir accepted it, "FAILED" when not. */
+	action: "UPLOAD" | "UPLOADED" | "FAILED";
+	/** Fingerprint of the HSDir. */
+	hsdir: string;
+	/** Tor's reason for a failure, empty otherwise. */
+	reason: string;
+};
+
+export type OnionPublishListener = (event: OnionPublishEvent) => void;
+
+export type OnionPublishOptions = {
+	/** HSDirs that have to accept a descriptor (default 4). */
+	min_hsdirs?: number;
+	/** Default 120 seconds. */
+	timeout_ms?: number;
+};
+
 interface RnTorSpec {
 	initTorService(config: TorConfig): Promise<boolean>;
 	createHiddenService(
@@ -39,24 +276,532 @@ interface RnTorSpec {
 	): Promise<HiddenServiceResponse>;
 	startTorIfNotRunning(params: StartTorParams): Promise<StartTorResponse>;
 	getServiceStatus(): Promise<number>;
+	getListeners(): Promise<TorListeners>;
 	deleteHiddenService(onionAddress: string): Promise<boolean>;
+	onOnionStream(listener: OnionStreamListener): () => void;
+	onOnionPublish(listener: OnionPublishListener): () => void;
+	waitForOnionPublished(onionAddress: string, options?: OnionPublishOptions): Promise<OnionPublishResponse>;
+	getOnionServiceMetrics(onionAddress: string): Promise<Record<string, number>>;
 	shutdownService(): Promise<boolean>;
+	suspend(): Promise<boolean>;
+	resume(timeoutMs?: number): Promise<ResumeResponse>;
 	httpGet(params: HttpGetParams): Promise<HttpResponse>;
 	httpPost(params: HttpPostParams): Promise<HttpResponse>;
 	httpPut(params: HttpPutParams): Promise<HttpResponse>;
 	httpDelete(params: HttpDeleteParams): Promise<HttpResponse>;
+	openStream(host: string, port: number, options?: OpenStreamOptions): Promise<TorStream>;
+	connectWebSocket(url: string, options?: WebSocketOptions): Promise<TorWebSocket>;
+	startProxy(options?: ProxyOptions): Promise<ProxyResponse>;
+	stopProxy(address: string): Promise<boolean>;
+	startHttpServer(options: HttpServerOptions): Promise<HttpServerResponse>;
+	stopHttpServer(serverId: number): Promise<boolean>;
+	clearHttpCache(): Promise<boolean>;
+	getCircuitStats(): Promise<Record<string, CircuitStats>>;
+	prewarm(hosts: string[], options?: PrewarmOptions): Promise<boolean>;
+	getPrewarmStatus(): Promise<PrewarmStatus[]>;
+	seedDirectorySnapshot(params: DirectorySnapshotParams): Promise<DirectorySnapshotResponse>;
+	exportDirectorySnapshot(params: DirectorySnapshotParams): Promise<DirectorySnapshotResponse>;
+	getStartupReport(): Promise<StartupReport | undefined>;
 }
 
+/** Fills optional HTTP params the native side expects to always be present. */
+const withHttpDefaults = <
+	T extends { accept_encoding?: string; isolation?: string; fresh_circuit?: boolean },
+>(
+	params: T,
+): T => ({
+	...params,
+	// Empty string accepts every supported content coding.
+	accept_encoding: params.accept_encoding ?? "",
+	// Empty string uses Tor's default circuits.
+	isolation: params.isolation ?? "",
+	fresh_circuit: params.fresh_circuit ?? false,
+});
+
+/** Converts TorOptions to the native profile and torrc_overrides_json fields. */
+const toNativeTorOptions = ({ profile, conflux, torrc_overrides }: TorOptions) => {
+	const overrides: Record<string, string | number | boolean> = {};
+	if (conflux !== undefined) {
+		overrides.ConfluxEnabled = conflux === false ? 0 : 1;
+		if (typeof conflux === "string") {
+			overrides.ConfluxClientUX = conflux;
+		}
+	}
+	Object.assign(overrides, torrc_overrides);
+
+	return {
+		profile: profile ?? "",
+		torrc_overrides_json: Object.keys(overrides).length > 0 ? JSON.stringify(overrides) : "",
+	};
+};
+
+const STREAM_READ_BYTES = 64 * 1024;
+
+const toBase64 = (data: ArrayBuffer | Uint8Array): string => {
+	const bytes = data instanceof Uint8Array ? data : new Uint8Array(data);
+	let binary = "";
+	for (let i = 0; i < bytes.length; i += 0x8000) {
+		binary += String.fromCharCode(...bytes.subarray(i, i + 0x8000));
+	}
+	return btoa(binary);
+};
+
+const fromBase64 = (data: string): ArrayBuffer => {
+	const binary = atob(data);
+	const bytes = new Uint8Array(binary.length);
+	for (let i = 0; i < binary.length; i++) {
+		bytes[i] = binary.charCodeAt(i);
+	}
+	return bytes.buffer;
+};
+
+const throwIfFailed = (response: StreamResponse) => {
+	if (!response.is_success) {
+		throw new Error(response.error);
+	}
+};
+
+const createTorStream = (id: number): TorStream => {
+	let ended = false;
+	let closed = false;
+
+	const read = async (maxBytes = STREAM_READ_BYTES): Promise<ArrayBuffer | null> => {
+		while (!ended && !closed) {
+			const chunk = await NativeReactNativeNitroTor.streamRead(id, maxBytes);
+			if (chunk.error) {
+				ended = true;
+				// A read racing close() ends quietly.
+				if (closed) {
+					return null;
+				}
+				throw new Error(chunk.error);
+			}
+			ended = chunk.eof;
+			if (chunk.data_base64) {
+				return fromBase64(chunk.data_base64);
+			}
+			if (!ended) {
+				await streamReadable(id);
+			}
+		}
+		return null;
+	};
+
+	return {
+		id,
+
+		async write(data: ArrayBuffer | Uint8Array): Promise<void> {
+			throwIfFailed(await NativeReactNativeNitroTor.streamWrite(id, toBase64(data)));
+		},
+
+		read,
+
+		onData(listener, onEnd) {
+			let active = true;
+			(async () => {
+				try {
+					for (let chunk = await read(); active && chunk; chunk = await read()) {
+						listener(chunk);
+					}
+					onEnd?.();
+				} catch (e) {
+					onEnd?.(e instanceof Error ? e : new Error(String(e)));
+				}
+			})();
+			return () => {
+				active = false;
+			};
+		},
+
+		async shutdownWrite(): Promise<void> {
+			throwIfFailed(await NativeReactNativeNitroTor.streamShutdownWrite(id));
+		},
+
+		close(): Promise<boolean> {
+			closed = true;
+			readableStreams.delete(id);
+			// Wakes a pending read, which then ends.
+			const waiter = readableWaiters.get(id);
+			readableWaiters.delete(id);
+			waiter?.();
+			return NativeReactNativeNitroTor.streamClose(id);
+		},
+	};
+};
+
+type WebSocketEvent = { socket_id: number } & (
+	| { type: "text" | "binary"; data: string }
+	| { type: "error"; message: string }
+	| { type: "close"; code: number; reason: string }
+);
+
+type NativeEvents = {
+	streams?: number[];
+	web_sockets?: WebSocketEvent[];
+	http_requests?: HttpServerRequest[];
+	onion_streams?: { stream_id: number; onion_address: string; port: number }[];
+	onion_publish?: OnionPublishEvent[];
+};
+
+// How long the native event poll waits before JS polls again.
+const EVENT_POLL_WAIT_MS = 1000;
+/** Readers waiting for a stream to become readable. */
+const readableWaiters = new Map<number, () => void>();
+/** Streams reported readable while no reader was waiting. */
+const readableStreams = new Set<number>();
+const openWebSockets = new Map<number, TorWebSocket>();
+const httpHandlers = new Map<number, HttpHandler>();
+const onionStreamListeners = new Set<OnionStreamListener>();
+const onionPublishListeners = new Set<OnionPublishListener>();
+let eventPumpRunning = false;
+let pendingReplies: object[] = [];
+
+const hasEventConsumers = () =>
+	readableWaiters.size > 0 ||
+	openWebSockets.size > 0 ||
+	httpHandlers.size > 0 ||
+	onionStreamListeners.size > 0 ||
+	onionPublishListeners.size > 0;
+
+/** Sends every reply produced in the same tick with one native call. */
+const queueHttpReply = (reply: object) => {
+	pendingReplies.push(reply);
+	if (pendingReplies.length === 1) {
+		setTimeout(() => {
+			const replies = pendingReplies;
+			pendingReplies = [];
+			NativeReactNativeNitroTor.respondHttpRequests(JSON.stringify(replies));
+		}, 0);
+	}
+};
+
+const runHttpHandler = async (handler: HttpHandler, request: HttpServerRequest) => {
+	let reply: HttpServerReply;
+	try {
+		reply = await handler(request);
+	} catch (e) {
+		console.error(e);
+		reply = { status: 500, body: "Internal Server Error" };
+	}
+
+	const body = reply.body ?? "";
+	const binary = typeof body !== "string";
+	queueHttpReply({
+		id: request.id,
+		status: reply.status ?? 200,
+		headers: reply.headers ?? {},
+		body: binary ? toBase64(body) : body,
+		base64: binary,
+	});
+};
+
+const deliverWebSocketEvent = (event: WebSocketEvent) => {
+	const socket = openWebSockets.get(event.socket_id);
+	if (!socket) {
+		return;
+	}
+	if (event.type === "text") {
+		socket.onmessage?.(event.data);
+	} else if (event.type === "binary") {
+		socket.onmessage?.(fromBase64(event.data));
+	} else if (event.type === "error") {
+		socket.onerror?.(new Error(event.message));
+	} else {
+		openWebSockets.delete(event.socket_id);
+		socket.onclose?.(event.code, event.reason);
+	}
+};
+
+/** Calls each listener, so a throwing one does not stop the others. */
+const notifyEach = <T extends unknown[]>(listeners: Iterable<(...args: T) => void>, ...args: T) => {
+	for (const listener of listeners) {
+		try {
+			listener(...args);
+		} catch (e) {
+			console.error(e);
+		}
+	}
+};
+
+/**
+ * Keeps one native poll pending while anything waits for native events and
+ * hands each event to its consumer. Streams, WebSockets, HTTP servers and
+ * onion services all share this poll; reads and other calls never wait in
+ * native code, so nothing else holds a worker of the module's pool.
+ */
+const pumpEvents = async () => {
+	if (eventPumpRunning) {
+		return;
+	}
+	eventPumpRunning = true;
+	try {
+		while (hasEventConsumers()) {
+			const eventsJson = await NativeReactNativeNitroTor.pollEvents(EVENT_POLL_WAIT_MS);
+			let events: NativeEvents = {};
+			try {
+				events = JSON.parse(eventsJson);
+			} catch {
+				// ignore a malformed batch
+			}
+
+			for (const id of events.streams ?? []) {
+				const waiter = readableWaiters.get(id);
+				if (waiter) {
+					readableWaiters.delete(id);
+					waiter();
+				} else {
+					readableStreams.add(id);
+				}
+			}
+
+			for (const event of events.web_sockets ?? []) {
+				try {
+					deliverWebSocketEvent(event);
+				} catch (e) {
+					// A throwing handler must not stop delivery to other sockets.
+					console.error(e);
+				}
+			}
+
+			// Handlers run concurrently; a slow one does not hold up the ones after it.
+			for (const request of events.http_requests ?? []) {
+				const handler = httpHandlers.get(request.server_id);
+				if (handler) {
+					runHttpHandler(handler, request);
+				}
+			}
+
+			for (const { stream_id, onion_address, port } of events.onion_streams ?? []) {
+				notifyEach(onionStreamListeners, createTorStream(stream_id), onion_address, port);
+			}
+
+			for (const event of events.onion_publish ?? []) {
+				notifyEach(onionPublishListeners, event);
+			}
+		}
+	} finally {
+		eventPumpRunning = false;
+	}
+};
+
+/** Resolves once the stream has data, its end or an error to read. */
+const streamReadable = (id: number) =>
+	new Promise<void>((resolve) => {
+		if (readableStreams.delete(id)) {
+			resolve();
+			return;
+		}
+		readableWaiters.set(id, resolve);
+		pumpEvents();
+	});
+
 const RnTorImpl: RnTorSpec = {
 	...NativeReactNativeNitroTor,
 
+	initTorService(config: TorConfig): Promise<boolean> {
+		const { profile, conflux, torrc_overrides, ...rest } = config;
+		return NativeReactNativeNitroTor.initTorService({
+			...rest,
+			...toNativeTorOptions({ profile, conflux, torrc_overrides }),
+		});
+	},
+
+	createHiddenService(params: HiddenServiceParams): Promise<HiddenServiceResponse> {
+		const { defenses, ports, ...rest } = params;
+		return NativeReactNativeNitroTor.createHiddenService({
+			...rest,
+			ports_json: ports && ports.length > 0 ? JSON.stringify(ports) : "",
+			accept_streams: params.accept_streams ?? false,
+			defenses_json: defenses ? JSON.stringify(defenses) : "",
+		});
+	},
+
+	async getOnionServiceMetrics(onionAddress: string): Promise<Record<string, number>> {
+		const metricsJson = await NativeReactNativeNitroTor.getOnionServiceMetrics(onionAddress);
+		try {
+			return JSON.parse(metricsJson);
+		} catch {
+			return {};
+		}
+	},
+
+	onOnionStream(listener: OnionStreamListener): () => void {
+		onionStreamListeners.add(listener);
+		pumpEvents();
+		return () => {
+			onionStreamListeners.delete(listener);
+		};
+	},
+
+	onOnionPublish(listener: OnionPublishListener): () => void {
+		onionPublishListeners.add(listener);
+		pumpEvents();
+		return () => {
+			onionPublishListeners.delete(listener);
+		};
+	},
+
+	waitForOnionPublished(onionAddress: string, options: OnionPublishOptions = {}): Promise<OnionPublishResponse> {
+		return NativeReactNativeNitroTor.waitOnionPublished({
+			onion_address: onionAddress,
+			min_hsdirs: options.min_hsdirs ?? 4,
+			timeout_ms: options.timeout_ms ?? 120000,
+		});
+	},
+
+	resume(timeoutMs = 30000): Promise<ResumeResponse> {
+		return NativeReactNativeNitroTor.resume(timeoutMs);
+	},
+
+	httpGet(params: HttpGetParams): Promise<HttpResponse> {
+		return NativeReactNativeNitroTor.httpGet({
+			...withHttpDefaults(params),
+			cache: params.cache ?? false,
+			hedge_percentile: params.hedge_percentile ?? 0,
+		});
+	},
+
+	httpPost(params: HttpPostParams): Promise<HttpResponse> {
+		return NativeReactNativeNitroTor.httpPost(withHttpDefaults(params));
+	},
+
+	httpPut(params: HttpPutParams): Promise<HttpResponse> {
+		return NativeReactNativeNitroTor.httpPut(withHttpDefaults(params));
+	},
+
+	httpDelete(params: HttpDeleteParams): Promise<HttpResponse> {
+		return NativeReactNativeNitroTor.httpDelete(withHttpDefaults(params));
+	},
+
+	async openStream(host: string, port: number, options: OpenStreamOptions = {}): Promise<TorStream> {
+		const response = await NativeReactNativeNitroTor.openStream({
+			host,
+			port,
+			timeout_ms: options.timeout_ms ?? 60000,
+			isolation: options.isolation ?? "",
+		});
+		throwIfFailed(response);
+		return createTorStream(response.stream_id);
+	},
+
+	async connectWebSocket(url: string, options: WebSocketOptions = {}): Promise<TorWebSocket> {
+		const response = await NativeReactNativeNitroTor.webSocketConnect({
+			url,
+			headers: options.headers ? JSON.stringify(options.headers) : "",
+			protocols: (options.protocols ?? []).join(","),
+			timeout_ms: options.timeout_ms ?? 60000,
+			ping_interval_ms: options.ping_interval_ms ?? 30000,
+			deflate: options.deflate ?? true,
+			isolation: options.isolation ?? "",
+		});
+		if (!response.is_success) {
+			throw new Error(response.error);
+		}
+
+		const id = response.socket_id;
+		const socket: TorWebSocket = {
+			protocol: response.protocol,
+			extensions: response.extensions,
+			onmessage: null,
+			onerror: null,
+			onclose: null,
+
+			async send(data: string | ArrayBuffer | Uint8Array): Promise<void> {
+				const sent =
+					typeof data === "string"
+						? await NativeReactNativeNitroTor.webSocketSend(id, data, false)
+						: await NativeReactNativeNitroTor.webSocketSend(id, toBase64(data), true);
+				if (!sent) {
+					throw new Error("WebSocket is not open");
+				}
+			},
+
+			async close(code = 1000, reason = ""): Promise<void> {
+				await NativeReactNativeNitroTor.webSocketClose(id, code, reason);
+			},
+		};
+
+		// Native code holds the socket's events until it is registered here.
+		openWebSockets.set(id, socket);
+		NativeReactNativeNitroTor.webSocketAttach(id);
+		pumpEvents();
+		return socket;
+	},
+
+	startProxy(options: ProxyOptions = {}): Promise<ProxyResponse> {
+		return NativeReactNativeNitroTor.startProxy({
+			listen: options.listen ?? "",
+			isolation: options.isolation ?? "",
+		});
+	},
+
+	async startHttpServer(options: HttpServerOptions): Promise<HttpServerResponse> {
+		const { handler } = options;
+		const response = await NativeReactNativeNitroTor.startHttpServer({
+			listen: options.listen,
+			static_dir: options.static_dir ?? "",
+			routes_json: options.routes ? JSON.stringify(options.routes) : "",
+			dispatch: handler !== undefined,
+			handler_timeout_ms: options.handler_timeout_ms ?? 30000,
+		});
+		if (response.is_success && handler) {
+			// Native code holds the server's requests until it is registered here.
+			httpHandlers.set(response.server_id, handler);
+			NativeReactNativeNitroTor.attachHttpServer(response.server_id);
+			pumpEvents();
+		}
+		return response;
+	},
+
+	stopHttpServer(serverId: number): Promise<boolean> {
+		httpHandlers.delete(serverId);
+		return NativeReactNativeNitroTor.stopHttpServer(serverId);
+	},
+
+	async getCircuitStats(): Promise<Record<string, CircuitStats>> {
+		const statsJson = await NativeReactNativeNitroTor.getCircuitStats();
+		try {
+			return JSON.parse(statsJson);
+		} catch {
+			return {};
+		}
+	},
+
+	prewarm(hosts: string[], options: PrewarmOptions = {}): Promise<boolean> {
+		return NativeReactNativeNitroTor.prewarm({
+			targets_json: JSON.stringify(hosts),
+			keepalive_ms: options.keepalive_ms ?? 0,
+			isolation: options.isolation ?? "",
+		});
+	},
+
+	async getPrewarmStatus(): Promise<PrewarmStatus[]> {
+		const statusJson = await NativeReactNativeNitroTor.getPrewarmStatus();
+		try {
+			const parsed = JSON.parse(statusJson);
+			return Array.isArray(parsed) ? parsed : [];
+		} catch {
+			return [];
+		}
+	},
+
+	async getStartupReport(): Promise<StartupReport | undefined> {
+		const reportJson = await NativeReactNativeNitroTor.getStartupReport();
+		try {
+			return JSON.parse(reportJson);
+		} catch {
+			return undefined;
+		}
+	},
+
 	async startTorIfNotRunning(params: StartTorParams): Promise<StartTorResponse> {
-		const { keys, ...rest } = params as any;
+		const { keys, profile, conflux, torrc_overrides, ...rest } = params as any;
 
 		const nativeParams: NativeStartTorParams = {
 			...(rest as NativeStartTorParams),
 			// Pass keys to native side as JSON string; empty string means no keys.
 			keys_json: keys && keys.length > 0 ? JSON.stringify(keys) : "",
+			...toNativeTorOptions({ profile, conflux, torrc_overrides }),
 		};
 
 		const nativeResp: NativeStartTorResponse = await (NativeReactNativeNitroTor as any).startTorIfNotRunning(